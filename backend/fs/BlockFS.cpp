@@ -135,8 +135,10 @@ ndsize_t BlockFS::dataArrayCount() const {
 }
 
 
+// FIXME: the fs backend stores no data, so it ignores the compression
 std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &name, const std::string &type,
-                                                           nix::DataType data_type, const NDSize &shape) {
+                                                           nix::DataType data_type, const NDSize &shape,
+                                                           Compression compression) {
     if (name.empty()) {
         throw EmptyString("Block::createDataArray empty name provided!");
     }
@@ -150,10 +152,40 @@ std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &na
 }
 
 
+std::vector<std::shared_ptr<base::IDataArray>> BlockFS::createDataArrays(const std::vector<DataArraySpec> &specs) {
+    std::vector<std::shared_ptr<base::IDataArray>> arrays;
+    arrays.reserve(specs.size());
+    for (const auto &spec : specs) {
+        if (hasDataArray(spec.name)) {
+            throw DuplicateName("createDataArrays");
+        }
+    }
+
+    for (const auto &spec : specs) {
+        arrays.push_back(createDataArray(spec.name, spec.type, spec.data_type, spec.shape, spec.compression));
+    }
+    return arrays;
+}
+
+
 bool BlockFS::deleteDataArray(const std::string &name_or_id) {
     return data_array_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+
+// FIXME: entities are only copied between files of the hdf5 backend
+std::shared_ptr<base::IDataArray> BlockFS::copyDataArray(const std::shared_ptr<base::IDataArray> &array,
+                                                         const std::string &name, CopyIds ids) {
+    throw std::runtime_error("BlockFS::copyDataArray: not supported by the fs backend");
+}
+
+// FIXME: virtual data sets are a feature of the hdf5 backend
+std::shared_ptr<base::IDataArray> BlockFS::createVirtualDataArray(const std::string &name, const std::string &type,
+                                                                  const std::vector<std::shared_ptr<base::IDataArray>> &parts,
+                                                                  size_t axis) {
+    throw std::runtime_error("BlockFS::createVirtualDataArray: not supported by the fs backend");
+}
+
 //--------------------------------------------------
 // Methods concerning tags
 //--------------------------------------------------
@@ -200,6 +232,22 @@ std::shared_ptr<base::ITag> BlockFS::createTag(const std::string &name, const st
 }
 
 
+std::vector<std::shared_ptr<base::ITag>> BlockFS::createTags(const std::vector<TagSpec> &specs) {
+    std::vector<std::shared_ptr<base::ITag>> tags;
+    tags.reserve(specs.size());
+    for (const auto &spec : specs) {
+        if (hasTag(spec.name)) {
+            throw DuplicateName("createTags");
+        }
+    }
+
+    for (const auto &spec : specs) {
+        tags.push_back(createTag(spec.name, spec.type, spec.position));
+    }
+    return tags;
+}
+
+
 bool BlockFS::deleteTag(const std::string &name_or_id) {
     return tag_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
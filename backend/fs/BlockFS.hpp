@@ -104,11 +104,24 @@ public:
 
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
-                                                      nix::DataType data_type, const NDSize &shape);
+                                                      nix::DataType data_type, const NDSize &shape,
+                                                      Compression compression);
+
+
+    std::vector<std::shared_ptr<base::IDataArray>> createDataArrays(const std::vector<DataArraySpec> &specs);
 
 
     bool deleteDataArray(const std::string &name_or_id);
 
+
+    std::shared_ptr<base::IDataArray> copyDataArray(const std::shared_ptr<base::IDataArray> &array,
+                                                    const std::string &name, CopyIds ids);
+
+
+    std::shared_ptr<base::IDataArray> createVirtualDataArray(const std::string &name, const std::string &type,
+                                                             const std::vector<std::shared_ptr<base::IDataArray>> &parts,
+                                                             size_t axis);
+
     //--------------------------------------------------
     // Methods concerning tags.
     //--------------------------------------------------
@@ -129,6 +142,9 @@ public:
                                           const std::vector<double> &position);
 
 
+    std::vector<std::shared_ptr<base::ITag>> createTags(const std::vector<TagSpec> &specs);
+
+
     bool deleteTag(const std::string &name_or_id);
 
     //--------------------------------------------------
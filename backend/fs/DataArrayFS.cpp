@@ -290,6 +290,11 @@ void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const ND
     */
 }
 
+void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                       const NDSize &buffer_extent, const NDSize &buffer_offset) const {
+    // FIXME: data access is not implemented in the fs backend, see read above
+}
+
 NDSize DataArrayFS::dataExtent(void) const {
     if (!hasAttr("extent")) {
         return NDSize{};
@@ -324,6 +329,115 @@ DataType DataArrayFS::dataType(void) const {
 }
 
 
+NDSize DataArrayFS::dataChunking() const {
+    // the fs backend does not store data in chunks
+    return NDSize{};
+}
+
+//--------------------------------------------------
+// Methods concerning the envelope.
+//--------------------------------------------------
+
+// FIXME: data access is not implemented in the fs backend, so there is no envelope
+ndsize_t DataArrayFS::envelopeFactor() const {
+    return 0;
+}
+
+
+void DataArrayFS::createEnvelope(ndsize_t factor) {
+    throw std::runtime_error("DataArrayFS::createEnvelope: not supported by the fs backend");
+}
+
+
+bool DataArrayFS::deleteEnvelope() {
+    return false;
+}
+
+
+ndsize_t DataArrayFS::envelopeLevelCount() const {
+    return 0;
+}
+
+
+NDSize DataArrayFS::envelopeExtent(ndsize_t level) const {
+    throw OutOfBounds("DataArrayFS::envelopeExtent: no such level", level);
+}
+
+
+void DataArrayFS::readEnvelope(ndsize_t level, double *buffer, const NDSize &count, const NDSize &offset) const {
+    throw ConsistencyError("DataArray has no envelope");
+}
+
+
+void DataArrayFS::writeEnvelope(ndsize_t level, const double *buffer, const NDSize &count, const NDSize &offset) {
+    throw ConsistencyError("DataArray has no envelope");
+}
+
+//--------------------------------------------------
+// Methods concerning referencing entities.
+//--------------------------------------------------
+
+// FIXME: the fs backend has no reference index and scans all entities of the block
+std::vector<std::shared_ptr<base::ITag>> DataArrayFS::referencingTags() const {
+    std::vector<std::shared_ptr<base::ITag>> tags;
+    for (ndsize_t i = 0; i < block()->tagCount(); i++) {
+        std::shared_ptr<base::ITag> tag = block()->getTag(i);
+        if (tag->hasReference(id())) {
+            tags.push_back(tag);
+        }
+    }
+    return tags;
+}
+
+
+std::vector<std::shared_ptr<base::IMultiTag>> DataArrayFS::referencingMultiTags() const {
+    std::vector<std::shared_ptr<base::IMultiTag>> tags;
+    for (ndsize_t i = 0; i < block()->multiTagCount(); i++) {
+        std::shared_ptr<base::IMultiTag> tag = block()->getMultiTag(i);
+        std::shared_ptr<base::IDataArray> positions = tag->hasPositions() ? tag->positions() : nullptr;
+        std::shared_ptr<base::IDataArray> extents = tag->extents();
+        if (tag->hasReference(id()) || (positions && positions->id() == id()) ||
+            (extents && extents->id() == id())) {
+            tags.push_back(tag);
+        }
+    }
+    return tags;
+}
+
+
+std::vector<std::shared_ptr<base::IFeature>> DataArrayFS::referencingFeatures() const {
+    std::vector<std::shared_ptr<base::IFeature>> features;
+    auto collect = [&](const std::shared_ptr<base::IBaseTag> &tag) {
+        for (ndsize_t i = 0; i < tag->featureCount(); i++) {
+            std::shared_ptr<base::IFeature> feature = tag->getFeature(i);
+            std::shared_ptr<base::IDataArray> data = feature->data();
+            if (data && data->id() == id()) {
+                features.push_back(feature);
+            }
+        }
+    };
+    for (ndsize_t i = 0; i < block()->tagCount(); i++) {
+        collect(block()->getTag(i));
+    }
+    for (ndsize_t i = 0; i < block()->multiTagCount(); i++) {
+        collect(block()->getMultiTag(i));
+    }
+    return features;
+}
+
+
+std::vector<std::shared_ptr<base::IGroup>> DataArrayFS::referencingGroups() const {
+    std::vector<std::shared_ptr<base::IGroup>> groups;
+    for (ndsize_t i = 0; i < block()->groupCount(); i++) {
+        std::shared_ptr<base::IGroup> group = block()->getGroup(i);
+        if (group->hasDataArray(id())) {
+            groups.push_back(group);
+        }
+    }
+    return groups;
+}
+
+
 void DataArrayFS::setDtype(nix::DataType dtype) {
     if (hasAttr("dtype")) {
         removeAttr("dtype");
@@ -142,6 +142,10 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+              const NDSize &buffer_extent, const NDSize &buffer_offset) const;
+
+
     NDSize dataExtent(void) const;
 
 
@@ -150,6 +154,50 @@ public:
 
     DataType dataType(void) const;
 
+
+    NDSize dataChunking() const;
+
+    //--------------------------------------------------
+    // Methods concerning referencing entities.
+    //--------------------------------------------------
+
+
+    std::vector<std::shared_ptr<base::ITag>> referencingTags() const;
+
+
+    std::vector<std::shared_ptr<base::IMultiTag>> referencingMultiTags() const;
+
+
+    std::vector<std::shared_ptr<base::IFeature>> referencingFeatures() const;
+
+
+    std::vector<std::shared_ptr<base::IGroup>> referencingGroups() const;
+
+    //--------------------------------------------------
+    // Methods concerning the envelope.
+    //--------------------------------------------------
+
+
+    ndsize_t envelopeFactor() const;
+
+
+    void createEnvelope(ndsize_t factor);
+
+
+    bool deleteEnvelope();
+
+
+    ndsize_t envelopeLevelCount() const;
+
+
+    NDSize envelopeExtent(ndsize_t level) const;
+
+
+    void readEnvelope(ndsize_t level, double *buffer, const NDSize &count, const NDSize &offset) const;
+
+
+    void writeEnvelope(ndsize_t level, const double *buffer, const NDSize &count, const NDSize &offset);
+
 };
 
 
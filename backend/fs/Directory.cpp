@@ -136,7 +136,7 @@ bool Directory::removeObjectByNameOrAttribute(const std::string &attribute, cons
 
 
 void Directory::createDirectoryLink(const std::string &target, const std::string &name) {
-    if (boost::filesystem::exists({target})) {
+    if (boost::filesystem::exists(boost::filesystem::path(target))) {
         boost::filesystem::create_directory_symlink(boost::filesystem::path(target), loc / boost::filesystem::path(name));
     } else {
         throw std::runtime_error("Directory::createLink: target does not exist");
@@ -90,6 +90,13 @@ bool FileFS::deleteBlock(const std::string &name_or_id) {
     return data_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+
+// FIXME: entities are only copied between files of the hdf5 backend
+std::shared_ptr<base::IBlock> FileFS::copyBlock(const std::shared_ptr<base::IBlock> &block, const std::string &name,
+                                                CopyIds ids) {
+    throw std::runtime_error("FileFS::copyBlock: not supported by the fs backend");
+}
+
 //--------------------------------------------------
 // Methods concerning sections
 //--------------------------------------------------
@@ -33,6 +33,30 @@ public:
 
     bool flush() { return true; };
 
+    // time stamps are always written immediately
+    void deferTimestamps(bool defer) {};
+
+    bool deferTimestamps() const { return false; };
+
+    // property values are always stored with all fields
+    void compactProperties(bool compact) {};
+
+    bool compactProperties() const { return false; };
+
+    // storage calls are not instrumented
+    void collectIOStatistics(bool collect) {};
+
+    bool collectIOStatistics() const { return false; };
+
+    IOStatistics ioStatistics() const { return IOStatistics(); };
+
+    void resetIOStatistics() {};
+
+    // data is not compressed
+    void filterThreads(size_t threads) {};
+
+    size_t filterThreads() const { return 1; };
+
 
     ndsize_t blockCount() const;
 
@@ -51,6 +75,10 @@ public:
 
     bool deleteBlock(const std::string &name_or_id);
 
+
+    std::shared_ptr<base::IBlock> copyBlock(const std::shared_ptr<base::IBlock> &block, const std::string &name,
+                                            CopyIds ids);
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -217,6 +217,28 @@ std::vector<Value> PropertyFS::values(void) const {
 }
 
 
+std::vector<Value> PropertyFS::values(ndsize_t offset, ndsize_t count) const {
+    std::vector<Value> values;
+    // FIXME
+    return values;
+}
+
+
+void PropertyFS::readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const {
+    // FIXME
+}
+
+
+void PropertyFS::appendValues(const std::vector<Value> &values) {
+    // FIXME
+}
+
+
+void PropertyFS::appendValues(DataType dtype, const void *data, ndsize_t count) {
+    // FIXME
+}
+
+
 void PropertyFS::values(const nix::none_t t) {
     // TODO: rethink if we want two methods for same thing
     deleteValues();
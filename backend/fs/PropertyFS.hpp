@@ -100,6 +100,18 @@ public:
     std::vector<Value> values(void) const;
 
 
+    std::vector<Value> values(ndsize_t offset, ndsize_t count) const;
+
+
+    void readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const;
+
+
+    void appendValues(const std::vector<Value> &values);
+
+
+    void appendValues(DataType dtype, const void *data, ndsize_t count);
+
+
     void values(const boost::none_t t);
 
 
@@ -123,7 +123,7 @@ void SectionFS::link(const std::string &id) {
 std::shared_ptr<base::ISection> SectionFS::link() const {
     std::shared_ptr<base::ISection> sec;
 
-    if (bfs::exists({location() + "/link"})) {
+    if (bfs::exists(bfs::path(location() + "/link"))) {
         auto sec_tmp = std::make_shared<SectionFS>(file(), location() + "/link");
         // re-get above section "sec_tmp": parent missing, findSections will set it!
         auto found = File(file()).findSections(util::IdFilter<Section>(sec_tmp->id()));
@@ -136,7 +136,7 @@ std::shared_ptr<base::ISection> SectionFS::link() const {
 
 
 void SectionFS::link(const none_t t) {
-    if (bfs::exists({location() + "/link"})) {
+    if (bfs::exists(bfs::path(location() + "/link"))) {
         bfs::remove_all({location() + "/link"});
     }
     forceUpdatedAt();
@@ -307,6 +307,22 @@ std::shared_ptr<base::IProperty> SectionFS::createProperty(const std::string &na
 }
 
 
+std::vector<std::shared_ptr<base::IProperty>> SectionFS::createProperties(const std::vector<PropertySpec> &specs) {
+    std::vector<std::shared_ptr<base::IProperty>> props;
+    props.reserve(specs.size());
+    for (const auto &spec : specs) {
+        if (hasProperty(spec.name)) {
+            throw DuplicateName("createProperties");
+        }
+    }
+
+    for (const auto &spec : specs) {
+        props.push_back(createProperty(spec.name, spec.values));
+    }
+    return props;
+}
+
+
 bool SectionFS::deleteProperty(const std::string &name_or_id) {
     return property_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
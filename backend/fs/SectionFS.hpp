@@ -154,6 +154,9 @@ public:
     std::shared_ptr<base::IProperty> createProperty(const std::string &name, const std::vector<Value> &values);
 
 
+    std::vector<std::shared_ptr<base::IProperty>> createProperties(const std::vector<PropertySpec> &specs);
+
+
     bool deleteProperty(const std::string &name_or_id);
 
     //--------------------------------------------------
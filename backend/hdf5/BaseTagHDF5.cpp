@@ -96,6 +96,11 @@ void BaseTagHDF5::addReference(const std::string &name_or_id) {
     auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
 
     g->createLink(target->group(), target->id());
+
+    std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+    if (index) {
+        index->add(target->id(), indexReferrer());
+    }
 }
 
 
@@ -108,6 +113,11 @@ bool BaseTagHDF5::removeReference(const std::string &name_or_id) {
 
         g->removeGroup(reference->id());
         removed = true;
+
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        if (index) {
+            index->remove(reference->id(), indexReferrer());
+        }
     }
 
     return removed;
@@ -197,7 +207,13 @@ std::shared_ptr<IFeature>  BaseTagHDF5::createFeature(const std::string &name_or
 
     H5Group group = g->openGroup(rep_id, true);
     DataArray data = block()->getDataArray(name_or_id);
-    return std::make_shared<FeatureHDF5>(file(), block(), group, rep_id, data, link_type);
+    auto feature = std::make_shared<FeatureHDF5>(file(), block(), group, rep_id, data, link_type);
+
+    std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+    if (index) {
+        index->add(data.id(), ReferenceIndex::feature(indexReferrer().owner, name(), rep_id));
+    }
+    return feature;
 }
 
 
@@ -208,8 +224,14 @@ bool BaseTagHDF5::deleteFeature(const std::string &name_or_id) {
     if (g && hasFeature(name_or_id)) {
         std::shared_ptr<IFeature> feature = getFeature(name_or_id);
 
+        dropPendingUpdates(g->openGroup(feature->id(), false), false);
         g->removeGroup(feature->id());
         deleted = true;
+
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        if (index) {
+            index->removeFeature(feature->id());
+        }
     }
 
     return deleted;
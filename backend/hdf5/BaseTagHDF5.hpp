@@ -11,6 +11,7 @@
 #define NIX_BASETAG_HDF5_H
 
 #include "EntityWithSourcesHDF5.hpp"
+#include "ReferenceIndex.hpp"
 #include <nix/base/IBaseTag.hpp>
 
 namespace nix {
@@ -27,6 +28,13 @@ private:
     optGroup feature_group;
     optGroup refs_group;
 
+protected:
+
+    /**
+     * @brief This tag as an entry of the reference index.
+     */
+    virtual ReferenceIndex::Referrer indexReferrer() const = 0;
+
 public:
 
     /**
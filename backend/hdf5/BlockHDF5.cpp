@@ -15,6 +15,8 @@
 #include "TagHDF5.hpp"
 #include "MultiTagHDF5.hpp"
 #include "GroupHDF5.hpp"
+#include "ReferenceIndex.hpp"
+#include "EntityCopy.hpp"
 
 #include <boost/range/irange.hpp>
 
@@ -108,6 +110,7 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
             for (auto &child : source.sources()) {
                 source.deleteSource(child.id());
             }
+            dropPendingUpdates(g->openGroup(source.name(), false));
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
         }
@@ -132,6 +135,33 @@ shared_ptr<ITag> BlockHDF5::createTag(const std::string &name, const std::string
 }
 
 
+vector<shared_ptr<ITag>> BlockHDF5::createTags(const vector<TagSpec> &specs) {
+    vector<shared_ptr<ITag>> tags;
+    if (specs.empty()) {
+        return tags;
+    }
+
+    boost::optional<H5Group> g = tag_group(true);
+    for (const auto &spec : specs) {
+        if (g->hasObject(spec.name)) {
+            throw DuplicateName("createTags");
+        }
+    }
+
+    H5Object gcpl = H5Group::groupCreationPList();
+    time_t now = util::getTime();
+
+    tags.reserve(specs.size());
+    for (const auto &spec : specs) {
+        H5Group group = g->createGroup(spec.name, gcpl);
+        tags.push_back(make_shared<TagHDF5>(file(), block(), group, util::createId(),
+                                            spec.type, spec.name, spec.position, now));
+    }
+
+    return tags;
+}
+
+
 bool BlockHDF5::hasTag(const string &name_or_id) const {
     return getTag(name_or_id) != nullptr;
 }
@@ -169,8 +199,15 @@ bool BlockHDF5::deleteTag(const std::string &name_or_id) {
     bool deleted = false;
 
     if (hasTag(name_or_id) && g) {
+        std::string name = getTag(name_or_id)->name();
+        dropPendingUpdates(g->openGroup(name, false));
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getTag(name_or_id)->name());
+        deleted = g->removeAllLinks(name);
+
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        if (index) {
+            index->removeReferrer(ReferenceIndex::Kind::Tag, name);
+        }
     }
 
     return deleted;
@@ -217,7 +254,8 @@ ndsize_t BlockHDF5::dataArrayCount() const {
 shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
                                                   const std::string &type,
                                                   nix::DataType data_type,
-                                                  const NDSize &shape) {
+                                                  const NDSize &shape,
+                                                  Compression compression) {
     string id = util::createId();
     boost::optional<H5Group> g = data_array_group(true);
 
@@ -225,18 +263,96 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
 
     // now create the actual H5::DataSet
-    da->createData(data_type, shape);
+    da->createData(data_type, shape, compression);
+    return da;
+}
+
+
+shared_ptr<IDataArray> BlockHDF5::copyDataArray(const shared_ptr<IDataArray> &array, const string &name,
+                                                CopyIds ids) {
+    boost::optional<H5Group> g = data_array_group(true);
+    H5Group group = copyDataArrayGroup(array, block(), *g, name, ids);
+    return make_shared<DataArrayHDF5>(file(), block(), group);
+}
+
+
+shared_ptr<IDataArray> BlockHDF5::createVirtualDataArray(const string &name, const string &type,
+                                                         const vector<shared_ptr<IDataArray>> &parts, size_t axis) {
+    string id = util::createId();
+    boost::optional<H5Group> g = data_array_group(true);
+
+    H5Group group = g->openGroup(name, true);
+    auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
+
+    try {
+        da->createVirtualData(parts, axis);
+    } catch (...) {
+        dropPendingUpdates(group, false);
+        g->removeGroup(name);
+        throw;
+    }
     return da;
 }
 
 
+vector<shared_ptr<IDataArray>> BlockHDF5::createDataArrays(const vector<DataArraySpec> &specs) {
+    vector<shared_ptr<IDataArray>> arrays;
+    if (specs.empty()) {
+        return arrays;
+    }
+
+    boost::optional<H5Group> g = data_array_group(true);
+    for (const auto &spec : specs) {
+        if (g->hasObject(spec.name)) {
+            throw DuplicateName("createDataArrays");
+        }
+    }
+
+    // the property lists are the same for all arrays, only the
+    // chunk size has to be adjusted to each individual shape
+    H5Lock lock;
+    H5Object gcpl = H5Group::groupCreationPList();
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("Could not create data creation plist");
+    time_t now = util::getTime();
+
+    arrays.reserve(specs.size());
+    for (const auto &spec : specs) {
+        H5Group group = g->createGroup(spec.name, gcpl);
+        auto da = make_shared<DataArrayHDF5>(file(), block(), group, util::createId(), spec.type, spec.name, now);
+
+        if (spec.shape && spec.compression == Compression::None) {
+            h5x::DataType fileType = data_type_to_h5_filetype(spec.data_type);
+            NDSize chunks = DataSet::guessChunking(spec.shape, fileType.size());
+            HErr res = H5Pset_chunk(dcpl.h5id(), static_cast<int>(chunks.size()), chunks.data());
+            res.check("Could not set chunk size on data set creation plist");
+
+            group.createData("data", fileType, DataSpace::create(spec.shape, true), dcpl);
+        } else {
+            da->createData(spec.data_type, spec.shape, spec.compression);
+        }
+
+        arrays.push_back(da);
+    }
+
+    return arrays;
+}
+
+
 bool BlockHDF5::deleteDataArray(const string &name_or_id) {
     bool deleted = false;
     boost::optional<H5Group> g = data_array_group();
 
     if (hasDataArray(name_or_id) && g) {
+        shared_ptr<IDataArray> data_array = getDataArray(name_or_id);
+        dropPendingUpdates(g->openGroup(data_array->name(), false));
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getDataArray(name_or_id)->name());
+        deleted = g->removeAllLinks(data_array->name());
+
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        if (index) {
+            index->removeDataArray(data_array->id());
+        }
     }
 
     return deleted;
@@ -295,8 +411,15 @@ bool BlockHDF5::deleteMultiTag(const std::string &name_or_id) {
     bool deleted = false;
 
     if (hasMultiTag(name_or_id) && g) {
+        std::string name = getMultiTag(name_or_id)->name();
+        dropPendingUpdates(g->openGroup(name, false));
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getMultiTag(name_or_id)->name());
+        deleted = g->removeAllLinks(name);
+
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        if (index) {
+            index->removeReferrer(ReferenceIndex::Kind::MultiTag, name);
+        }
     }
 
     return deleted;
@@ -351,7 +474,14 @@ bool BlockHDF5::deleteGroup(const std::string &name_or_id) {
     bool deleted = false;
 
     if (hasGroup(name_or_id) && g) {
-        deleted = g->removeAllLinks(getGroup(name_or_id)->name());
+        std::string name = getGroup(name_or_id)->name();
+        dropPendingUpdates(g->openGroup(name, false));
+        deleted = g->removeAllLinks(name);
+
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        if (index) {
+            index->removeReferrer(ReferenceIndex::Kind::Group, name);
+        }
     }
     return deleted;
 }
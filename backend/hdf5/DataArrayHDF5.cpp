@@ -10,7 +10,12 @@
 
 #include "DataArrayHDF5.hpp"
 #include "h5x/H5DataSet.hpp"
+#include "h5x/ChunkPipeline.hpp"
 #include "DimensionHDF5.hpp"
+#include "ReferenceIndex.hpp"
+
+#include <boost/filesystem.hpp>
+#include <limits>
 
 using namespace std;
 using namespace nix::base;
@@ -18,9 +23,34 @@ using namespace nix::base;
 namespace nix {
 namespace hdf5 {
 
+namespace {
+
+// the level of Compression::DeflateNormal, the default level of zlib
+const unsigned deflate_level = 6;
+
+
+/*
+ * The name of the file of a part as seen from the file of a virtual data
+ * set: "." for the same file, the bare file name in the same directory,
+ * where hdf5 looks for it next to the virtual data set, else the full path.
+ */
+string sourceFileName(const string &virtual_file, const string &source_file) {
+    namespace bfs = boost::filesystem;
+    const bfs::path virtual_path = bfs::absolute(virtual_file);
+    const bfs::path source_path = bfs::absolute(source_file);
+    if (source_path == virtual_path) {
+        return ".";
+    }
+    if (source_path.parent_path() == virtual_path.parent_path()) {
+        return source_path.filename().string();
+    }
+    return source_path.string();
+}
+
+} // anonymous namespace
 
 DataArrayHDF5::DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group)
-        : EntityWithSourcesHDF5(file, block, group) {
+        : EntityWithSourcesHDF5(file, block, group), envelope_factor(0), envelope_generation(numeric_limits<uint64_t>::max()) {
     dimension_group = this->group().openOptGroup("dimensions");
 }
 
@@ -33,7 +63,8 @@ DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBl
 
 DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBlock> &block, const H5Group &group,
                              const string &id, const string &type, const string &name, time_t time)
-        : EntityWithSourcesHDF5(file, block, group, id, type, name, time) {
+        : EntityWithSourcesHDF5(file, block, group, id, type, name, time),
+          envelope_factor(0), envelope_generation(numeric_limits<uint64_t>::max()) {
     dimension_group = this->group().openOptGroup("dimensions");
 }
 
@@ -132,13 +163,7 @@ vector<double> DataArrayHDF5::polynomCoefficients() const {
 
 
 void DataArrayHDF5::polynomCoefficients(const vector<double> &coefficients) {
-    DataSet ds;
-    if (group().hasData("polynom_coefficients")) {
-        ds = group().openData("polynom_coefficients");
-        ds.setExtent({coefficients.size()});
-    } else {
-        ds = group().createData("polynom_coefficients", H5T_NATIVE_DOUBLE, {coefficients.size()});
-    }
+    DataSet ds = group().prepareData("polynom_coefficients", H5T_NATIVE_DOUBLE, {coefficients.size()});
     ds.write(coefficients);
     forceUpdatedAt();
 }
@@ -245,12 +270,82 @@ DataArrayHDF5::~DataArrayHDF5() {
 
 
 void DataArrayHDF5::createData(DataType dtype, const NDSize &size) {
+    createData(dtype, size, Compression::None);
+}
+
+
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, Compression compression) {
     if (group().hasData("data")) {
         throw ConsistencyError("DataArray's hdf5 data group already exists!");
     }
 
     h5x::DataType fileType = data_type_to_h5_filetype(dtype);
-    group().createData("data", fileType, size);
+    if (compression == Compression::None || !size) {
+        group().createData("data", fileType, size);
+        return;
+    }
+
+    // deflate needs chunks, which are chosen like those of uncompressed data
+    H5Lock lock;
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("Could not create data creation plist");
+    NDSize chunks = DataSet::guessChunking(size, fileType.size());
+    HErr res = H5Pset_chunk(dcpl.h5id(), static_cast<int>(chunks.size()), chunks.data());
+    res.check("Could not set chunk size on data set creation plist");
+    res = H5Pset_deflate(dcpl.h5id(), deflate_level);
+    res.check("Could not set deflate filter on data set creation plist");
+
+    group().createData("data", fileType, DataSpace::create(size, true), dcpl);
+}
+
+
+void DataArrayHDF5::createVirtualData(const std::vector<std::shared_ptr<base::IDataArray>> &parts, size_t axis) {
+    if (group().hasData("data")) {
+        throw ConsistencyError("DataArray's hdf5 data group already exists!");
+    }
+
+    std::vector<shared_ptr<DataArrayHDF5>> sources;
+    std::vector<DataSet> datasets;
+    for (const auto &part : parts) {
+        auto source = dynamic_pointer_cast<DataArrayHDF5>(part);
+        if (!source) {
+            throw std::runtime_error("createVirtualDataArray: only data arrays of hdf5 files can be parts");
+        }
+        if (!source->hasData()) {
+            throw ConsistencyError("DataArray with missing h5df DataSet");
+        }
+        sources.push_back(source);
+        datasets.push_back(source->group().openData("data"));
+    }
+
+    NDSize extent = datasets[0].size();
+    extent[axis] = 0;
+    for (const DataSet &ds : datasets) {
+        extent[axis] += ds.size()[axis];
+    }
+
+    const string location = file()->location();
+    H5Lock lock;
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("Could not create data creation plist");
+
+    // each part fills the slab of the virtual data set behind the previous one
+    NDSize offset(extent.size(), 0);
+    for (size_t i = 0; i < datasets.size(); i++) {
+        const NDSize count = datasets[i].size();
+        DataSpace mapped = DataSpace::create(extent, false);
+        mapped.hyperslab(count, offset);
+        DataSpace source = datasets[i].getSpace();
+
+        const string file_name = sourceFileName(location, sources[i]->file()->location());
+        const string data_name = datasets[i].name();
+        HErr res = H5Pset_virtual(dcpl.h5id(), mapped.h5id(), file_name.c_str(), data_name.c_str(), source.h5id());
+        res.check("Could not map part " + data_name + " of " + file_name + " into the virtual data set");
+        offset[axis] += count[axis];
+    }
+
+    h5x::DataType fileType = datasets[0].dataType();
+    group().createData("data", fileType, DataSpace::create(extent, false), dcpl);
 }
 
 bool DataArrayHDF5::hasData() const {
@@ -265,6 +360,10 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
 
     DataSet ds = group().openData("data");
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    size_t threads = file()->filterThreads();
+    if (threads > 1 && writeChunksParallel(ds, data, memType, count, offset, threads)) {
+        return;
+    }
     ds.write(data, memType, count, offset);
 }
 
@@ -275,9 +374,34 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
 
     DataSet ds = group().openData("data");
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    size_t threads = file()->filterThreads();
+    if (threads > 1 && readChunksParallel(ds, data, memType, count, offset, threads)) {
+        return;
+    }
     ds.read(data, memType, count, offset);
 }
 
+
+void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                         const NDSize &buffer_extent, const NDSize &buffer_offset) const {
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    if (memType.isVariableString()) {
+        throw runtime_error("DataArrayHDF5::read: strings cannot be read into a region of a buffer");
+    }
+
+    // both selections are hyperslabs, so the data is placed by a single read
+    DataSpace fileSpace = ds.getSpace();
+    fileSpace.hyperslab(count, offset);
+    DataSpace memSpace = DataSpace::create(buffer_extent, false);
+    memSpace.hyperslab(count, buffer_offset);
+    ds.read(data, memType, memSpace, fileSpace);
+}
+
 NDSize DataArrayHDF5::dataExtent(void) const {
     if (!group().hasData("data")) {
         return NDSize{};
@@ -306,5 +430,175 @@ DataType DataArrayHDF5::dataType(void) const {
     return data_type_from_h5(dtype);
 }
 
+
+NDSize DataArrayHDF5::dataChunking() const {
+    if (!group().hasData("data")) {
+        return NDSize{};
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.chunking();
+}
+
+//--------------------------------------------------
+// Methods concerning the envelope.
+//--------------------------------------------------
+
+namespace {
+
+string envelopeLevelName(ndsize_t level) {
+    return "level_" + to_string(level);
+}
+
+} // anonymous namespace
+
+
+ndsize_t DataArrayHDF5::envelopeFactor() const {
+    // asked for by every write to the data: the envelope group is only
+    // looked up again after an envelope was created or deleted
+    H5Lock lock;
+    uint64_t generation = attributeGeneration();
+    if (envelope_generation != generation) {
+        ndsize_t factor = 0;
+        if (group().hasGroup("envelope")) {
+            group().openGroup("envelope", false).getAttr("factor", factor);
+        }
+        envelope_factor = factor;
+        envelope_generation = generation;
+    }
+    return envelope_factor;
+}
+
+
+void DataArrayHDF5::createEnvelope(ndsize_t factor) {
+    if (factor < 2) {
+        throw invalid_argument("DataArrayHDF5::createEnvelope: factor must be at least 2");
+    }
+    deleteEnvelope();
+    H5Group envelope = group().openGroup("envelope", true);
+    envelope.setAttr("factor", factor);
+    invalidateAttributes();
+}
+
+
+bool DataArrayHDF5::deleteEnvelope() {
+    if (!group().hasGroup("envelope")) {
+        return false;
+    }
+    group().removeGroup("envelope");
+    invalidateAttributes();
+    return true;
+}
+
+
+ndsize_t DataArrayHDF5::envelopeLevelCount() const {
+    if (!group().hasGroup("envelope")) {
+        return 0;
+    }
+    H5Group envelope = group().openGroup("envelope", false);
+    ndsize_t count = 0;
+    while (envelope.hasData(envelopeLevelName(count + 1))) {
+        count++;
+    }
+    return count;
+}
+
+
+NDSize DataArrayHDF5::envelopeExtent(ndsize_t level) const {
+    if (level < 1 || level > envelopeLevelCount()) {
+        throw OutOfBounds("DataArrayHDF5::envelopeExtent: no such level", level);
+    }
+    return group().openGroup("envelope", false).openData(envelopeLevelName(level)).size();
+}
+
+
+void DataArrayHDF5::readEnvelope(ndsize_t level, double *buffer, const NDSize &count, const NDSize &offset) const {
+    if (!group().hasGroup("envelope")) {
+        throw ConsistencyError("DataArray has no envelope");
+    }
+    DataSet ds = group().openGroup("envelope", false).openData(envelopeLevelName(level));
+    ds.read(buffer, data_type_to_h5_memtype(DataType::Double), count, offset);
+}
+
+
+void DataArrayHDF5::writeEnvelope(ndsize_t level, const double *buffer, const NDSize &count, const NDSize &offset) {
+    if (!group().hasGroup("envelope")) {
+        throw ConsistencyError("DataArray has no envelope");
+    }
+    H5Group envelope = group().openGroup("envelope", false);
+    const string name = envelopeLevelName(level);
+
+    DataSet ds;
+    NDSize required = offset + count;
+    if (envelope.hasData(name)) {
+        ds = envelope.openData(name);
+        NDSize extent = ds.size();
+        if (required[0] > extent[0]) {
+            extent[0] = required[0];
+            ds.setExtent(extent);
+        }
+    } else {
+        ds = envelope.createData(name, data_type_to_h5_filetype(DataType::Double), required);
+    }
+    ds.write(buffer, data_type_to_h5_memtype(DataType::Double), count, offset);
+}
+
+//--------------------------------------------------
+// Methods concerning referencing entities.
+//--------------------------------------------------
+
+vector<shared_ptr<ITag>> DataArrayHDF5::referencingTags() const {
+    vector<shared_ptr<ITag>> tags;
+    for (const auto &referrer : referenceIndex(file(), block())->referrers(id(), ReferenceIndex::Kind::Tag)) {
+        shared_ptr<ITag> tag = block()->getTag(referrer.name);
+        if (tag) {
+            tags.push_back(tag);
+        }
+    }
+    return tags;
+}
+
+
+vector<shared_ptr<IMultiTag>> DataArrayHDF5::referencingMultiTags() const {
+    vector<shared_ptr<IMultiTag>> tags;
+    for (const auto &referrer : referenceIndex(file(), block())->referrers(id(), ReferenceIndex::Kind::MultiTag)) {
+        shared_ptr<IMultiTag> tag = block()->getMultiTag(referrer.name);
+        if (tag) {
+            tags.push_back(tag);
+        }
+    }
+    return tags;
+}
+
+
+vector<shared_ptr<IFeature>> DataArrayHDF5::referencingFeatures() const {
+    vector<shared_ptr<IFeature>> features;
+    for (const auto &referrer : referenceIndex(file(), block())->referrers(id(), ReferenceIndex::Kind::Feature)) {
+        shared_ptr<IBaseTag> owner;
+        if (referrer.owner == ReferenceIndex::Kind::Tag) {
+            owner = block()->getTag(referrer.name);
+        } else {
+            owner = block()->getMultiTag(referrer.name);
+        }
+        shared_ptr<IFeature> feature = owner ? owner->getFeature(referrer.feature) : nullptr;
+        if (feature) {
+            features.push_back(feature);
+        }
+    }
+    return features;
+}
+
+
+vector<shared_ptr<IGroup>> DataArrayHDF5::referencingGroups() const {
+    vector<shared_ptr<IGroup>> groups;
+    for (const auto &referrer : referenceIndex(file(), block())->referrers(id(), ReferenceIndex::Kind::Group)) {
+        shared_ptr<IGroup> group = block()->getGroup(referrer.name);
+        if (group) {
+            groups.push_back(group);
+        }
+    }
+    return groups;
+}
+
 } // ns nix::hdf5
 } // ns nix
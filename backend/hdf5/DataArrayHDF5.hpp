@@ -32,6 +32,10 @@ private:
 
     optGroup dimension_group;
 
+    // the envelope factor, valid while the attribute generation is unchanged
+    mutable ndsize_t envelope_factor;
+    mutable uint64_t envelope_generation;
+
 public:
 
     /**
@@ -131,6 +135,21 @@ public:
     virtual void createData(DataType dtype, const NDSize &size);
 
 
+    void createData(DataType dtype, const NDSize &size, Compression compression);
+
+
+    /**
+     * @brief Create the data as a virtual data set that concatenates the
+     *        data of other data arrays along an axis.
+     *
+     * The parts are mapped into the virtual data set with their extents
+     * at the time of the call. Parts in other files are referred to by
+     * their file name relative to this file, if they share its directory,
+     * and by their absolute path otherwise.
+     */
+    void createVirtualData(const std::vector<std::shared_ptr<base::IDataArray>> &parts, size_t axis);
+
+
     bool hasData() const;
 
 
@@ -140,6 +159,10 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+              const NDSize &buffer_extent, const NDSize &buffer_offset) const;
+
+
     NDSize dataExtent(void) const;
 
 
@@ -148,6 +171,50 @@ public:
 
     DataType dataType(void) const;
 
+
+    NDSize dataChunking() const;
+
+    //--------------------------------------------------
+    // Methods concerning referencing entities.
+    //--------------------------------------------------
+
+
+    std::vector<std::shared_ptr<base::ITag>> referencingTags() const;
+
+
+    std::vector<std::shared_ptr<base::IMultiTag>> referencingMultiTags() const;
+
+
+    std::vector<std::shared_ptr<base::IFeature>> referencingFeatures() const;
+
+
+    std::vector<std::shared_ptr<base::IGroup>> referencingGroups() const;
+
+    //--------------------------------------------------
+    // Methods concerning the envelope.
+    //--------------------------------------------------
+
+
+    ndsize_t envelopeFactor() const;
+
+
+    void createEnvelope(ndsize_t factor);
+
+
+    bool deleteEnvelope();
+
+
+    ndsize_t envelopeLevelCount() const;
+
+
+    NDSize envelopeExtent(ndsize_t level) const;
+
+
+    void readEnvelope(ndsize_t level, double *buffer, const NDSize &count, const NDSize &offset) const;
+
+
+    void writeEnvelope(ndsize_t level, const double *buffer, const NDSize &count, const NDSize &offset);
+
 private:
 
     // small helper for handling dimension groups
@@ -0,0 +1,422 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityCopy.hpp"
+#include "BlockHDF5.hpp"
+#include "DataArrayHDF5.hpp"
+
+#include <nix/Exception.hpp>
+#include <nix/util/util.hpp>
+
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// a link of a copied entity to an entity that may lie outside of the copy
+struct OutLink {
+    H5Group parent;
+    std::string name;
+    std::string id;
+};
+
+
+// the links created by a copy, removed again if the copy fails
+typedef std::vector<std::pair<H5Group, std::string>> CreatedLinks;
+
+
+void copyAttributes(const LocID &source, const LocID &target) {
+    H5Lock lock;
+    H5O_info_t info;
+#if H5_VERSION_GE(1, 10, 3)
+    HErr res = H5Oget_info2(source.h5id(), &info, H5O_INFO_NUM_ATTRS);
+#else
+    HErr res = H5Oget_info(source.h5id(), &info);
+#endif
+    res.check("copy: Could not get object info");
+
+    for (hsize_t i = 0; i < info.num_attrs; i++) {
+        H5Object attr = H5Aopen_by_idx(source.h5id(), ".", H5_INDEX_NAME, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT);
+        attr.check("copy: Could not open attribute");
+        std::vector<char> name(H5Aget_name(attr.h5id(), 0, nullptr) + 1);
+        H5Aget_name(attr.h5id(), name.size(), name.data());
+
+        H5Object type = H5Aget_type(attr.h5id());
+        type.check("copy: Could not get the type of attribute " + std::string(name.data()));
+        H5Object memory = H5Tget_native_type(type.h5id(), H5T_DIR_DEFAULT);
+        memory.check("copy: Could not get the memory type of attribute " + std::string(name.data()));
+        H5Object space = H5Aget_space(attr.h5id());
+        space.check("copy: Could not get the space of attribute " + std::string(name.data()));
+
+        std::vector<char> buffer(H5Tget_size(memory.h5id()) * H5Sget_simple_extent_npoints(space.h5id()));
+        res = H5Aread(attr.h5id(), memory.h5id(), buffer.data());
+        res.check("copy: Could not read attribute " + std::string(name.data()));
+        H5Object copy = H5Acreate2(target.h5id(), name.data(), type.h5id(), space.h5id(), H5P_DEFAULT, H5P_DEFAULT);
+        HErr written = copy.isValid() ? H5Awrite(copy.h5id(), memory.h5id(), buffer.data()) : -1;
+        // variable length strings and sequences were allocated by H5Aread
+        res = H5Dvlen_reclaim(memory.h5id(), space.h5id(), H5P_DEFAULT, buffer.data());
+        written.check("copy: Could not write attribute " + std::string(name.data()));
+        res.check("copy: Could not reclaim attribute " + std::string(name.data()));
+    }
+}
+
+
+/**
+ * @brief Copies entity groups member by member.
+ *
+ * The links of the copied entities to metadata, to linked sections and,
+ * for a data array, to its sources are recorded instead of followed, so
+ * that the trees they point into are not copied along: they are linked
+ * to the right entities of the target file afterwards. Objects reached
+ * by several links are copied once and linked again. Data sets are
+ * copied with H5Ocopy, which keeps their layout and copies their chunks
+ * without decoding them.
+ */
+class EntityCopier {
+public:
+
+    explicit EntityCopier(CreatedLinks &created)
+        : created(created), gcpl(H5Group::groupCreationPList()) {}
+
+    H5Group copy(const H5Group &source, const H5Group &parent, const std::string &name, bool sources) {
+        H5Group group = createGroup(source, parent, name);
+        created.emplace_back(parent, name);
+        copyMembers(source, group, sources);
+        return group;
+    }
+
+    std::vector<LocID> objects;
+    std::vector<H5Group> groups;
+    std::vector<OutLink> metadata;
+    std::vector<OutLink> section_links;
+    std::vector<OutLink> sources;
+
+private:
+
+    void copyMembers(const H5Group &source, const H5Group &copy, bool sources) {
+        const bool entity = source.hasAttr("entity_id");
+        for (ndsize_t i = 0; i < source.objectCount(); i++) {
+            std::string name = source.objectName(i);
+            if (source.hasGroup(name)) {
+                H5Group child = source.openGroup(name, false);
+                if (entity && name == "metadata") {
+                    record(metadata, copy, name, child);
+                } else if (entity && name == "link") {
+                    record(section_links, copy, name, child);
+                } else if (sources && name == "sources") {
+                    H5Group members = createGroup(child, copy, name);
+                    for (ndsize_t j = 0; j < child.objectCount(); j++) {
+                        std::string member = child.objectName(j);
+                        record(this->sources, members, member, child.openGroup(member, false));
+                    }
+                } else if (!linked(child, copy, name)) {
+                    copyMembers(child, createGroup(child, copy, name), false);
+                }
+            } else if (source.hasData(name) && !linked(source.openData(name), copy, name)) {
+                {
+                    H5Lock lock;
+                    HErr res = H5Ocopy(source.h5id(), name.c_str(), copy.h5id(), name.c_str(),
+                                       H5P_DEFAULT, H5P_DEFAULT);
+                    res.check("Could not copy data " + name);
+                }
+                DataSet data = copy.openData(name);
+                copies.emplace(source.openData(name).address(), data);
+                objects.push_back(data);
+            }
+        }
+    }
+
+    H5Group createGroup(const H5Group &source, const H5Group &parent, const std::string &name) {
+        H5Group group = parent.createGroup(name, gcpl);
+        copyAttributes(source, group);
+        copies.emplace(source.address(), group);
+        objects.push_back(group);
+        groups.push_back(group);
+        return group;
+    }
+
+    // link to the copy of an object reached before
+    bool linked(const LocID &object, const H5Group &parent, const std::string &name) {
+        auto it = copies.find(object.address());
+        if (it == copies.end()) {
+            return false;
+        }
+        H5Lock lock;
+        HErr res = H5Lcreate_hard(it->second.h5id(), ".", parent.h5id(), name.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+        res.check("Could not link " + name);
+        return true;
+    }
+
+    static void record(std::vector<OutLink> &links, const H5Group &parent, const std::string &name,
+                       const H5Group &target) {
+        std::string id;
+        if (target.getAttr("entity_id", id)) {
+            links.push_back(OutLink{parent, name, id});
+        }
+    }
+
+    CreatedLinks &created;
+    H5Object gcpl;
+    // the copies by the address of their originals
+    std::unordered_map<haddr_t, LocID> copies;
+};
+
+
+bool sameFile(const H5Group &a, const H5Group &b) {
+    H5Lock lock;
+    H5O_info_t info_a, info_b;
+#if H5_VERSION_GE(1, 10, 3)
+    HErr res = H5Oget_info2(a.h5id(), &info_a, H5O_INFO_BASIC);
+    res.check("copy: Could not get object info");
+    res = H5Oget_info2(b.h5id(), &info_b, H5O_INFO_BASIC);
+#else
+    HErr res = H5Oget_info(a.h5id(), &info_a);
+    res.check("copy: Could not get object info");
+    res = H5Oget_info(b.h5id(), &info_b);
+#endif
+    res.check("copy: Could not get object info");
+    return info_a.fileno == info_b.fileno;
+}
+
+
+H5Group metadataGroup(const H5Group &location) {
+    H5Lock lock;
+    H5Group group(H5Gopen2(location.h5id(), "/metadata", H5P_DEFAULT));
+    group.check("Could not open the metadata of the target file");
+    return group;
+}
+
+
+/**
+ * @brief The sections of a file or the sources of a block, found by
+ *        walking their groups.
+ */
+class EntityTree {
+public:
+
+    struct Node {
+        std::string id;
+        std::string name;
+        H5Group group;
+        // the index of the containing entity, none at the top
+        size_t parent;
+    };
+
+    static const size_t none = static_cast<size_t>(-1);
+
+    EntityTree() {}
+
+    // the entities in container and, recursively, in their children groups
+    EntityTree(const H5Group &container, const std::string &children) {
+        add(container, children, none);
+    }
+
+    const Node *find(const std::string &id) const {
+        auto it = index.find(id);
+        return it == index.end() ? nullptr : &nodes[it->second];
+    }
+
+    const Node &parent(const Node &node) const {
+        return nodes[node.parent];
+    }
+
+private:
+
+    void add(const H5Group &container, const std::string &children, size_t parent) {
+        for (ndsize_t i = 0; i < container.objectCount(); i++) {
+            std::string name = container.objectName(i);
+            if (!container.hasGroup(name)) {
+                continue;
+            }
+            H5Group group = container.openGroup(name, false);
+            std::string id;
+            if (!group.getAttr("entity_id", id)) {
+                continue;
+            }
+            nodes.push_back(Node{id, name, group, parent});
+            index.emplace(id, nodes.size() - 1);
+            if (group.hasGroup(children)) {
+                add(group.openGroup(children, false), children, nodes.size() - 1);
+            }
+        }
+    }
+
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, size_t> index;
+};
+
+
+/**
+ * @brief Copy the entities that links point to and that the target lacks
+ *        from the source.
+ *
+ * A missing entity is copied along with the outermost of its containing
+ * entities that the target lacks, into the entity of the target that
+ * corresponds to the next one out, or into the top of the target. So the
+ * copies keep their place in the tree.
+ */
+void adopt(const std::vector<OutLink> &links, const EntityTree &source, const H5Group &target,
+           const std::string &children, EntityCopier &copier) {
+    const EntityTree existing(target, children);
+
+    std::vector<std::pair<H5Group, const EntityTree::Node *>> roots;
+    std::set<std::string> root_ids;
+    std::set<std::pair<haddr_t, std::string>> names;
+    for (const OutLink &link : links) {
+        const EntityTree::Node *outer = source.find(link.id);
+        if (!outer || existing.find(link.id)) {
+            continue;
+        }
+        while (outer->parent != EntityTree::none && !existing.find(source.parent(*outer).id)) {
+            outer = &source.parent(*outer);
+        }
+        if (!root_ids.insert(outer->id).second) {
+            continue;
+        }
+
+        H5Group container = target;
+        if (outer->parent != EntityTree::none) {
+            container = existing.find(source.parent(*outer).id)->group.openGroup(children, true);
+        }
+        if (container.hasObject(outer->name) || !names.emplace(container.address(), outer->name).second) {
+            throw DuplicateName("copy: an entity named " + outer->name + " already exists");
+        }
+        roots.emplace_back(container, outer);
+    }
+
+    for (const auto &root : roots) {
+        copier.copy(root.second->group, root.first, root.second->name, false);
+    }
+}
+
+
+// link the recorded links to the entities of the target with the same id, leave out those without
+void relink(std::vector<OutLink> &links, const EntityTree &target) {
+    for (OutLink &link : links) {
+        const EntityTree::Node *node = target.find(link.id);
+        if (node) {
+            link.parent.createLink(node->group, link.name);
+        }
+    }
+}
+
+
+// new ids for the first count copied objects
+void regenerateIds(const EntityCopier &copier, size_t count) {
+    std::unordered_map<std::string, std::string> ids;
+    for (size_t i = 0; i < count; i++) {
+        const LocID &object = copier.objects[i];
+        std::string id;
+        if (object.getAttr("entity_id", id)) {
+            std::string fresh = util::createId();
+            object.setAttr("entity_id", fresh);
+            ids[id] = fresh;
+        }
+    }
+
+    // links in reference, source and feature groups are named by the id of their target
+    for (const H5Group &group : copier.groups) {
+        std::vector<std::string> names;
+        for (ndsize_t i = 0; i < group.objectCount(); i++) {
+            names.push_back(group.objectName(i));
+        }
+        for (const std::string &name : names) {
+            auto it = ids.find(name);
+            if (it != ids.end()) {
+                H5Lock lock;
+                HErr res = H5Lmove(group.h5id(), name.c_str(), group.h5id(), it->second.c_str(),
+                                   H5P_DEFAULT, H5P_DEFAULT);
+                res.check("Could not rename link " + name);
+            }
+        }
+    }
+}
+
+
+H5Group copyEntity(const H5Group &entity, const H5Group &parent, const std::string &name,
+                   const H5Group *source_block, const H5Group *target_block, CopyIds ids) {
+    // ids are unique within a file
+    const bool same_file = sameFile(entity, parent);
+    if (same_file) {
+        ids = CopyIds::Regenerate;
+    }
+
+    CreatedLinks created;
+    try {
+        EntityCopier copier(created);
+        H5Group copy = copier.copy(entity, parent, name, target_block != nullptr);
+        copy.setAttr("name", name);
+        // sources and sections copied along into another file keep their ids, so later copies link to them
+        const size_t own_objects = copier.objects.size();
+
+        if (target_block) {
+            EntityTree source;
+            if (source_block->hasGroup("sources")) {
+                source = EntityTree(source_block->openGroup("sources", false), "sources");
+            }
+            H5Group sources = target_block->openGroup("sources", true);
+            adopt(copier.sources, source, sources, "sources", copier);
+            relink(copier.sources, EntityTree(sources, "sources"));
+        }
+
+        const EntityTree source(metadataGroup(entity), "sections");
+        H5Group metadata = metadataGroup(copy);
+        adopt(copier.metadata, source, metadata, "sections", copier);
+        const EntityTree target(metadata, "sections");
+        relink(copier.metadata, target);
+        // linked sections are not copied: links to sections the target lacks are dropped
+        relink(copier.section_links, target);
+
+        if (ids == CopyIds::Regenerate) {
+            regenerateIds(copier, same_file ? copier.objects.size() : own_objects);
+        }
+        return copy;
+    } catch (...) {
+        for (auto it = created.rbegin(); it != created.rend(); ++it) {
+            try {
+                it->first.deleteLink(it->second);
+            } catch (...) {
+                // keep the original error
+            }
+        }
+        throw;
+    }
+}
+
+} // anonymous namespace
+
+
+H5Group copyBlockGroup(const std::shared_ptr<base::IBlock> &block, const H5Group &data, const std::string &name,
+                       CopyIds ids) {
+    auto source = std::dynamic_pointer_cast<BlockHDF5>(block);
+    if (!source) {
+        throw std::runtime_error("copyBlock: only blocks of hdf5 files can be copied");
+    }
+    return copyEntity(source->group(), data, name, nullptr, nullptr, ids);
+}
+
+
+H5Group copyDataArrayGroup(const std::shared_ptr<base::IDataArray> &array, const std::shared_ptr<base::IBlock> &target,
+                           const H5Group &data_arrays, const std::string &name, CopyIds ids) {
+    auto source = std::dynamic_pointer_cast<DataArrayHDF5>(array);
+    if (!source) {
+        throw std::runtime_error("copyDataArray: only data arrays of hdf5 files can be copied");
+    }
+    H5Group source_block = std::dynamic_pointer_cast<BlockHDF5>(source->block())->group();
+    H5Group target_block = std::dynamic_pointer_cast<BlockHDF5>(target)->group();
+    return copyEntity(source->group(), data_arrays, name, &source_block, &target_block, ids);
+}
+
+} // namespace hdf5
+} // namespace nix
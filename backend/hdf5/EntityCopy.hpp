@@ -0,0 +1,66 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_COPY_HDF5_H
+#define NIX_ENTITY_COPY_HDF5_H
+
+#include <nix/base/IBlock.hpp>
+#include <nix/CopyIds.hpp>
+
+#include "h5x/H5Group.hpp"
+
+#include <memory>
+#include <string>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Copy the group of a block into the data group of a file.
+ *
+ * The groups are copied member by member and the data sets with H5Ocopy,
+ * so data sets keep their layout and their chunks are copied without
+ * being decoded. The sections the entities of the block link to as
+ * metadata are not copied along: those links point at the section of
+ * the target file with the same id, and missing sections are copied
+ * into the metadata of the target file together with those of their
+ * parents it lacks.
+ *
+ * @param block     The block to copy, of a file of the hdf5 backend.
+ * @param data      The group of the blocks of the target file.
+ * @param name      The name of the copy.
+ * @param ids       Whether the copied entities keep their ids.
+ *
+ * @return The group of the copy.
+ */
+H5Group copyBlockGroup(const std::shared_ptr<base::IBlock> &block, const H5Group &data, const std::string &name,
+                       CopyIds ids);
+
+/**
+ * @brief Copy the group of a data array into a block.
+ *
+ * Like {@link copyBlockGroup}, but the sources of the data array are
+ * also pointed at the sources of the target block with the same id, and
+ * missing sources are copied into the block together with those of
+ * their parents it lacks.
+ *
+ * @param array         The data array to copy, of a file of the hdf5 backend.
+ * @param target        The block to copy into.
+ * @param data_arrays   The group of the data arrays of the block.
+ * @param name          The name of the copy.
+ * @param ids           Whether the copied entities keep their ids.
+ *
+ * @return The group of the copy.
+ */
+H5Group copyDataArrayGroup(const std::shared_ptr<base::IDataArray> &array, const std::shared_ptr<base::IBlock> &target,
+                           const H5Group &data_arrays, const std::string &name, CopyIds ids);
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_ENTITY_COPY_HDF5_H
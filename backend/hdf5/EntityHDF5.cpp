@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "EntityHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include <nix/util/util.hpp>
 
@@ -18,9 +19,12 @@ using namespace nix::base;
 namespace nix {
 namespace hdf5 {
 
+static const std::vector<std::string> attr_names = {"entity_id", "name", "type", "definition",
+                                                    "created_at", "updated_at"};
+
 
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const H5Group &group)
-    : entity_file(file), entity_group(group)
+    : entity_file(file), entity_group(group), attr_cache_generation(0), attr_address(HADDR_UNDEF)
 {
     setUpdatedAt();
     setCreatedAt();
@@ -28,66 +32,150 @@ EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const H5Group &group)
 
 
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id, time_t time)
-    : entity_file(file), entity_group(group)
+    : entity_file(file), entity_group(group), attr_cache_generation(0), attr_address(HADDR_UNDEF)
 {
     group.setAttr("entity_id", id);
+    invalidateAttributes();
     setUpdatedAt();
     forceCreatedAt(time);
 }
 
 
-string EntityHDF5::id() const {
-    string t;
-    
-    if (group().hasAttr("entity_id")) {
-        group().getAttr("entity_id", t);
+std::shared_ptr<const EntityAttributes> EntityHDF5::attributes() const {
+    // the cache is shared by all front-end copies of this entity, which
+    // may be used from several threads; readers keep their own reference
+    H5Lock lock;
+    uint64_t generation = attributeGeneration();
+
+    if (attr_cache && attr_cache_generation == generation) {
+        return attr_cache;
+    }
+
+    vector<boost::optional<string>> values;
+    entity_group.getStringAttrs(attr_names, values);
+
+    auto attrs = make_shared<EntityAttributes>();
+    attrs->id = values[0];
+    attrs->name = values[1];
+    attrs->type = values[2];
+    attrs->definition = values[3];
+    if (values[4]) {
+        attrs->created_at = util::strToTime(*values[4]);
+    }
+    if (values[5]) {
+        attrs->updated_at = util::strToTime(*values[5]);
+    }
+
+    attr_cache = attrs;
+    attr_cache_generation = generation;
+    return attr_cache;
+}
+
+
+// Different entity objects may share the same group, so a write through
+// one must invalidate the cache of all the others: the file counts the
+// writes of the standard attributes per group.
+FileHDF5 *EntityHDF5::attributeFile() const {
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(entity_file.get());
+    if (h5file && attr_address == HADDR_UNDEF) {
+        attr_address = entity_group.address();
+    }
+    return h5file;
+}
+
+
+uint64_t EntityHDF5::attributeGeneration() const {
+    H5Lock lock;
+    FileHDF5 *h5file = attributeFile();
+    return h5file ? h5file->attributeGeneration(attr_address) : 0;
+}
+
+
+void EntityHDF5::dropPendingUpdates(const LocID &obj, bool all_links) const {
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(entity_file.get());
+    if (h5file) {
+        h5file->dropPendingUpdates(obj, all_links);
     }
-    else {
+}
+
+
+void EntityHDF5::invalidateAttributes() const {
+    H5Lock lock;
+    FileHDF5 *h5file = attributeFile();
+    if (h5file) {
+        h5file->bumpAttributeGeneration(attr_address);
+    }
+    attr_cache.reset();
+}
+
+
+string EntityHDF5::id() const {
+    std::shared_ptr<const EntityAttributes> attrs = attributes();
+
+    if (!attrs->id) {
         throw runtime_error("Entity has no id!");
     }
-    
-    return t;
+
+    return *attrs->id;
 }
 
 
 time_t EntityHDF5::updatedAt() const {
-    string t;
-    group().getAttr("updated_at", t);
-    return util::strToTime(t);
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(entity_file.get());
+    boost::optional<time_t> pending = h5file ? h5file->pendingUpdatedAt(entity_group) : boost::none;
+    if (pending) {
+        return *pending;
+    }
+
+    std::shared_ptr<const EntityAttributes> attrs = attributes();
+    return attrs->updated_at ? *attrs->updated_at : util::strToTime("");
 }
 
 
 void EntityHDF5::setUpdatedAt() {
-    if (!group().hasAttr("updated_at")) {
-        time_t t = util::getTime();
-        group().setAttr("updated_at", util::timeToStr(t));
+    if (!attributes()->updated_at) {
+        writeUpdatedAt(false);
     }
 }
 
 
 void EntityHDF5::forceUpdatedAt() {
+    writeUpdatedAt(true);
+}
+
+
+void EntityHDF5::writeUpdatedAt(bool force) {
     time_t t = util::getTime();
+
+    // in deferred mode the file writes the time stamp on flush or close
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(entity_file.get());
+    if (h5file && h5file->deferUpdatedAt(entity_group, t, force)) {
+        return;
+    }
+
     group().setAttr("updated_at", util::timeToStr(t));
+    invalidateAttributes();
 }
 
 
 time_t EntityHDF5::createdAt() const {
-    string t;
-    group().getAttr("created_at", t);
-    return util::strToTime(t);
+    std::shared_ptr<const EntityAttributes> attrs = attributes();
+    return attrs->created_at ? *attrs->created_at : util::strToTime("");
 }
 
 
 void EntityHDF5::setCreatedAt() {
-    if (!group().hasAttr("created_at")) {
+    if (!attributes()->created_at) {
         time_t t = util::getTime();
         group().setAttr("created_at", util::timeToStr(t));
+        invalidateAttributes();
     }
 }
 
 
 void EntityHDF5::forceCreatedAt(time_t t) {
     group().setAttr("created_at", util::timeToStr(t));
+    invalidateAttributes();
 }
 
 
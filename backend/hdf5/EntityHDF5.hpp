@@ -14,12 +14,32 @@
 #include <nix/base/IEntity.hpp>
 #include "h5x/H5Group.hpp"
 
+#include <boost/optional.hpp>
+
 #include <string>
 #include <memory>
+#include <cstdint>
 
 namespace nix {
 namespace hdf5 {
 
+class FileHDF5;
+
+
+/**
+ * The standard attributes every entity carries, read from the file in a
+ * single pass (see {@link EntityHDF5::attributes}). Attributes that are
+ * not present in the file are left unset.
+ */
+struct EntityAttributes {
+    boost::optional<std::string> id;
+    boost::optional<std::string> name;
+    boost::optional<std::string> type;
+    boost::optional<std::string> definition;
+    boost::optional<time_t>      created_at;
+    boost::optional<time_t>      updated_at;
+};
+
 
 /**
  * HDF5 implementation of IEntity
@@ -31,6 +51,11 @@ private:
     std::shared_ptr<base::IFile>  entity_file;
     H5Group entity_group;
 
+    mutable std::shared_ptr<const EntityAttributes> attr_cache;
+    mutable uint64_t attr_cache_generation;
+    // the address of the group, looked up once for the attribute generation
+    mutable haddr_t attr_address;
+
 public:
 
     EntityHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group);
@@ -71,6 +96,21 @@ public:
 
     H5Group group() const;
 
+    /**
+     * @brief Get the standard attributes (id, name, type, definition and
+     * the time stamps) of the entity.
+     *
+     * The attributes are fetched with one iteration over the attribute
+     * table of the group and cached; the cache is dropped as soon as any
+     * of these attributes is written through an entity object of the
+     * same group. Writes to other entities leave it alone.
+     * The returned snapshot stays valid even if the cache is refreshed
+     * by another thread.
+     *
+     * @return The attributes of the entity.
+     */
+    std::shared_ptr<const EntityAttributes> attributes() const;
+
 
     virtual ~EntityHDF5();
 
@@ -78,6 +118,31 @@ protected:
 
     std::shared_ptr<base::IFile> file() const;
 
+    /**
+     * @brief Must be called after writing one of the attributes held
+     * by {@link EntityAttributes}.
+     */
+    void invalidateAttributes() const;
+
+    /**
+     * @brief The number of invalidations of the attributes of the group,
+     * for caching other values read from the group.
+     */
+    uint64_t attributeGeneration() const;
+
+    /**
+     * @brief Must be called before unlinking an entity, see
+     * {@link FileHDF5::dropPendingUpdates}.
+     */
+    void dropPendingUpdates(const LocID &obj, bool all_links = true) const;
+
+private:
+
+    void writeUpdatedAt(bool force);
+
+    // the file of the entity if it counts attribute writes per group, with the group address
+    FileHDF5 *attributeFile() const;
+
 };
 
 
@@ -11,6 +11,7 @@
 #include <nix/util/util.hpp>
 #include <nix/DataArray.hpp>
 #include "DataArrayHDF5.hpp"
+#include "ReferenceIndex.hpp"
 
 
 using namespace std;
@@ -80,6 +81,12 @@ void FeatureHDF5::data(const std::string &name_or_id) {
 
     group().createLink(target->group(), "data");
     forceUpdatedAt();
+
+    // a new feature is indexed by its tag once it is complete
+    std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block);
+    if (index) {
+        index->retargetFeature(id(), target->id());
+    }
 }
 
 
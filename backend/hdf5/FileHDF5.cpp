@@ -11,10 +11,15 @@
 #include <nix/util/util.hpp>
 #include "BlockHDF5.hpp"
 #include "SectionHDF5.hpp"
+#include "EntityCopy.hpp"
 #include "h5x/H5Exception.hpp"
 
 
+#include <algorithm>
 #include <fstream>
+#include <thread>
+#include <sstream>
+#include <unordered_set>
 #include <vector>
 #include <ctime>
 
@@ -24,6 +29,50 @@ namespace nix {
 namespace hdf5 {
 
 static FormatVersion my_version = HDF5_FF_VERSION;
+static FormatVersion my_compact_version = HDF5_FF_COMPACT_VERSION;
+
+
+namespace {
+
+herr_t objectInfo(hid_t loc, const char *name, H5O_info_t *info) {
+#if H5_VERSION_GE(1, 10, 3)
+    return H5Oget_info_by_name2(loc, name, info, H5O_INFO_BASIC, H5P_DEFAULT);
+#else
+    return H5Oget_info_by_name(loc, name, info, H5P_DEFAULT);
+#endif
+}
+
+
+// the objects freed along with an unlinked one, found by counting their links from freed groups
+struct FreedObjects {
+    std::unordered_map<haddr_t, unsigned> links;
+    std::unordered_set<haddr_t> freed;
+    std::vector<haddr_t> groups;
+
+    void free(const H5O_info_t &info) {
+        if (freed.insert(info.addr).second && info.type == H5O_TYPE_GROUP) {
+            groups.push_back(info.addr);
+        }
+    }
+};
+
+
+herr_t countLink(hid_t group, const char *name, const H5L_info_t *link, void *data) {
+    if (link->type != H5L_TYPE_HARD) {
+        return 0;
+    }
+    FreedObjects *objects = static_cast<FreedObjects *>(data);
+    H5O_info_t info;
+    if (objectInfo(group, name, &info) < 0) {
+        return -1;
+    }
+    if (++objects->links[info.addr] == info.rc) {
+        objects->free(info);
+    }
+    return 0;
+}
+
+} // anonymous namespace
 
 static unsigned int map_file_mode(FileMode mode) {
     switch (mode) {
@@ -43,7 +92,10 @@ static unsigned int map_file_mode(FileMode mode) {
 
 
 FileHDF5::FileHDF5(const string &name, FileMode mode)
+    : defer_timestamps(false), compact_properties(false), compact_version(false), collect_io(false),
+      filter_threads(1)
 {
+    H5Lock lock;
     if (!fileExists(name)) {
         mode = FileMode::Overwrite;
     }
@@ -72,8 +124,8 @@ FileHDF5::FileHDF5(const string &name, FileMode mode)
 
     if (is_create) {
         createHeader();
-    } else if (!checkHeader(mode)) {
-        throw nix::InvalidFile("FileHDF5::open_existing!");
+    } else {
+        checkHeader(mode);
     }
 
     metadata = root.openGroup("metadata");
@@ -85,6 +137,8 @@ FileHDF5::FileHDF5(const string &name, FileMode mode)
 
 
 bool FileHDF5::flush() {
+    H5Lock lock;
+    writePendingUpdates();
     HErr err = H5Fflush(hid, H5F_SCOPE_GLOBAL);
     return !err.isError();
 }        
@@ -127,14 +181,26 @@ bool FileHDF5::deleteBlock(const std::string &name_or_id) {
     bool deleted = false;
 
     if (hasBlock(name_or_id)) {
+        std::shared_ptr<base::IBlock> block = getBlock(name_or_id);
+        {
+            std::lock_guard<std::mutex> lock(index_mutex);
+            reference_indexes.erase(std::dynamic_pointer_cast<BlockHDF5>(block)->group().address());
+        }
+        dropPendingUpdates(data.openGroup(block->name(), false), true);
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = data.removeAllLinks(getBlock(name_or_id)->name());
+        deleted = data.removeAllLinks(block->name());
     }
 
     return deleted;
 }
 
 
+shared_ptr<base::IBlock> FileHDF5::copyBlock(const shared_ptr<base::IBlock> &block, const string &name, CopyIds ids) {
+    H5Group group = copyBlockGroup(block, data, name, ids);
+    return make_shared<BlockHDF5>(file(), group);
+}
+
+
 ndsize_t FileHDF5::blockCount() const {
     return data.objectCount();
 }
@@ -186,6 +252,7 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
         for(auto &child : section.sections()) {
             section.deleteSection(child.id());
         }
+        dropPendingUpdates(metadata.openGroup(section.name(), false), true);
         // if hasSection is true then section_group always exists
         deleted = metadata.removeAllLinks(section.name());
     }
@@ -260,6 +327,7 @@ string FileHDF5::format() const {
 
 
 string FileHDF5::location() const {
+    H5Lock lock;
     ssize_t size = H5Fget_name(hid, nullptr, 0);
 
     if (size < 0) {
@@ -277,10 +345,25 @@ string FileHDF5::location() const {
 
 
 void FileHDF5::close() {
+    H5Lock lock;
 
     if (!isOpen())
         return;
 
+    if (mode != FileMode::ReadOnly) {
+        writePendingUpdates();
+    }
+
+    if (collect_io) {
+        IOCounters::detach(hid);
+        collect_io = false;
+    }
+
+    {
+        std::lock_guard<std::mutex> index_lock(index_mutex);
+        reference_indexes.clear();
+    }
+
     data.close();
     metadata.close();
     root.close();
@@ -325,38 +408,257 @@ FileMode FileHDF5::fileMode() const {
 }
 
 
+void FileHDF5::deferTimestamps(bool defer) {
+    if (!defer) {
+        writePendingUpdates();
+    }
+    defer_timestamps = defer;
+}
+
+
+bool FileHDF5::deferTimestamps() const {
+    return defer_timestamps;
+}
+
+
+void FileHDF5::compactProperties(bool compact) {
+    compact_properties = compact;
+}
+
+
+bool FileHDF5::compactProperties() const {
+    return compact_properties;
+}
+
+
+void FileHDF5::requireCompactVersion() {
+    H5Lock lock;
+    if (!compact_version) {
+        root.setAttr("version", std::vector<int>{my_compact_version.x(), my_compact_version.y(),
+                                                 my_compact_version.z()});
+        compact_version = true;
+    }
+}
+
+
+void FileHDF5::collectIOStatistics(bool collect) {
+    if (collect == collect_io || !isOpen()) {
+        return;
+    }
+    if (collect) {
+        if (!io_counters) {
+            io_counters = std::make_shared<IOCounters>();
+        }
+        IOCounters::attach(hid, io_counters);
+    } else {
+        IOCounters::detach(hid);
+    }
+    collect_io = collect;
+}
+
+
+bool FileHDF5::collectIOStatistics() const {
+    return collect_io;
+}
+
+
+IOStatistics FileHDF5::ioStatistics() const {
+    return io_counters ? io_counters->statistics() : IOStatistics();
+}
+
+
+void FileHDF5::resetIOStatistics() {
+    if (io_counters) {
+        io_counters->reset();
+    }
+}
+
+
+void FileHDF5::filterThreads(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    filter_threads = threads;
+}
+
+
+size_t FileHDF5::filterThreads() const {
+    return filter_threads;
+}
+
+
+bool FileHDF5::deferUpdatedAt(const LocID &obj, time_t t, bool force) {
+    if (!defer_timestamps) {
+        return false;
+    }
+
+    haddr_t addr = obj.address();
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    if (force) {
+        pending_updates[addr] = t;
+    } else {
+        pending_updates.emplace(addr, t);
+    }
+    return true;
+}
+
+
+boost::optional<time_t> FileHDF5::pendingUpdatedAt(const LocID &obj) const {
+    boost::optional<time_t> t;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        if (pending_updates.empty()) {
+            return t;
+        }
+    }
+
+    haddr_t addr = obj.address();
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    auto it = pending_updates.find(addr);
+    if (it != pending_updates.end()) {
+        t = it->second;
+    }
+    return t;
+}
+
+
+uint64_t FileHDF5::attributeGeneration(haddr_t addr) const {
+    std::lock_guard<std::mutex> lock(attr_mutex);
+    auto it = attr_generations.find(addr);
+    return it != attr_generations.end() ? it->second : 0;
+}
+
+
+void FileHDF5::bumpAttributeGeneration(haddr_t addr) {
+    std::lock_guard<std::mutex> lock(attr_mutex);
+    attr_generations[addr]++;
+}
+
+
+void FileHDF5::dropPendingUpdates(const LocID &obj, bool all_links) {
+    bool pending;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        pending = !pending_updates.empty();
+    }
+    {
+        std::lock_guard<std::mutex> lock(attr_mutex);
+        if (!pending && attr_generations.empty()) {
+            return;
+        }
+    }
+
+    H5Lock lock;
+    FreedObjects objects;
+    H5O_info_t info;
+    HErr res = objectInfo(obj.h5id(), ".", &info);
+    res.check("FileHDF5::dropPendingUpdates(): Could not get object info");
+    if (!all_links && info.rc > 1) {
+        return;
+    }
+    objects.free(info);
+
+    while (!objects.groups.empty()) {
+        H5Group group = H5Oopen_by_addr(hid, objects.groups.back());
+        group.check("FileHDF5::dropPendingUpdates(): Could not open group");
+        objects.groups.pop_back();
+        res = H5Literate(group.h5id(), H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, countLink, &objects);
+        res.check("FileHDF5::dropPendingUpdates(): Could not iterate over links");
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(pending_mutex);
+        for (haddr_t addr : objects.freed) {
+            pending_updates.erase(addr);
+        }
+    }
+
+    // a new object at a reused address starts at generation 0
+    std::lock_guard<std::mutex> guard(attr_mutex);
+    for (haddr_t addr : objects.freed) {
+        attr_generations.erase(addr);
+    }
+}
+
+
+std::shared_ptr<ReferenceIndex> FileHDF5::referenceIndex(const H5Group &block) {
+    haddr_t addr = block.address();
+    {
+        std::lock_guard<std::mutex> lock(index_mutex);
+        auto it = reference_indexes.find(addr);
+        if (it != reference_indexes.end()) {
+            return it->second;
+        }
+    }
+
+    // built without holding the mutex, which entities take while holding the H5Lock
+    auto index = std::make_shared<ReferenceIndex>(block);
+    std::lock_guard<std::mutex> lock(index_mutex);
+    return reference_indexes.emplace(addr, index).first->second;
+}
+
+
+std::shared_ptr<ReferenceIndex> FileHDF5::existingReferenceIndex(const H5Group &block) const {
+    {
+        std::lock_guard<std::mutex> lock(index_mutex);
+        if (reference_indexes.empty()) {
+            return nullptr;
+        }
+    }
+
+    haddr_t addr = block.address();
+    std::lock_guard<std::mutex> lock(index_mutex);
+    auto it = reference_indexes.find(addr);
+    return it != reference_indexes.end() ? it->second : nullptr;
+}
+
+
+void FileHDF5::writePendingUpdates() {
+    std::unordered_map<haddr_t, time_t> pending;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        pending.swap(pending_updates);
+    }
+
+    H5Lock lock;
+    for (const auto &update : pending) {
+        LocID obj = H5Oopen_by_addr(hid, update.first);
+        obj.check("FileHDF5::writePendingUpdates(): Could not open object");
+        obj.setAttr("updated_at", util::timeToStr(update.second));
+        bumpAttributeGeneration(update.first);
+    }
+}
+
+
 shared_ptr<base::IFile> FileHDF5::file() const {
     return  const_pointer_cast<FileHDF5>(shared_from_this());
 }
 
 
-bool FileHDF5::checkHeader(FileMode mode) const {
-    bool check = true;
+void FileHDF5::checkHeader(FileMode mode) {
     vector<int> vv;
     string str;
-    if (root.hasAttr("format")) {
-        if (!root.getAttr("format", str) || str != FILE_FORMAT) {
-            check = false;
-        }
-    } else {
-        check = false;
-    }
-    if (root.hasAttr("version")) {
-        if (!root.getAttr("version", vv)) {
-            check = false;
-        } else {
-            FormatVersion ver = FormatVersion(vv);
-
-            if (mode == FileMode::ReadWrite) {
-                check = my_version.canWrite(ver);
-            } else {
-                check = my_version.canRead(ver);
-            }
-        }
+    if (!root.hasAttr("format") || !root.getAttr("format", str) || str != FILE_FORMAT ||
+        !root.hasAttr("version") || !root.getAttr("version", vv) || vv.size() != 3) {
+        throw nix::InvalidFile("FileHDF5::open_existing!");
+    }
+
+    // files without compact properties keep the older version, which both can write
+    FormatVersion ver = FormatVersion(vv);
+    bool check;
+    if (mode == FileMode::ReadWrite) {
+        check = my_version.canWrite(ver) || my_compact_version.canWrite(ver);
     } else {
-        check = false;
+        check = my_compact_version.canRead(ver);
+    }
+
+    if (!check) {
+        std::stringstream msg;
+        msg << "format version " << ver << " can not be " << (mode == FileMode::ReadWrite ? "written" : "read")
+            << " by this library, which writes " << my_version << " and " << my_compact_version;
+        throw nix::InvalidFile(msg.str(), "FileHDF5::open_existing!");
     }
-    return check;
+    compact_version = ver >= my_compact_version;
 }
 
 
@@ -370,6 +672,7 @@ void FileHDF5::createHeader() const {
 }
     
 void FileHDF5::openRoot() {
+    H5Lock lock;
     root = H5Group(H5Gopen2(hid, "/", H5P_DEFAULT));
     root.check("Could not open root group");
 }
@@ -13,11 +13,20 @@
 #include <nix/Version.hpp>
 
 #include "h5x/H5Group.hpp"
+#include "h5x/IOCounters.hpp"
+#include "ReferenceIndex.hpp"
+
+#include <boost/optional.hpp>
 
 #include <string>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #define HDF5_FF_VERSION nix::FormatVersion({1, 1, 0})
+// the version of files with properties in compact layouts, which older libraries can not read
+#define HDF5_FF_COMPACT_VERSION nix::FormatVersion({1, 2, 0})
 
 namespace nix {
 namespace hdf5 {
@@ -33,6 +42,31 @@ private:
     H5Group root, metadata, data;
     FileMode mode;
 
+    /* updated_at time stamps not yet written, by object address */
+    bool defer_timestamps;
+    std::unordered_map<haddr_t, time_t> pending_updates;
+    mutable std::mutex pending_mutex;
+
+    /* store the values of new properties in the compact layouts */
+    bool compact_properties;
+    /* whether the format version of the file allows compact layouts */
+    bool compact_version;
+
+    /* storage call counters, attached to the file while collecting */
+    std::shared_ptr<IOCounters> io_counters;
+    bool collect_io;
+
+    /* threads that decompress chunks of data arrays */
+    std::atomic<size_t> filter_threads;
+
+    /* generations of the standard attributes of entities, by object address */
+    std::unordered_map<haddr_t, uint64_t> attr_generations;
+    mutable std::mutex attr_mutex;
+
+    /* reference indexes built so far, by block address */
+    std::unordered_map<haddr_t, std::shared_ptr<ReferenceIndex>> reference_indexes;
+    mutable std::mutex index_mutex;
+
 public:
 
     /**
@@ -68,6 +102,10 @@ public:
 
     bool deleteBlock(const std::string &name_or_id);
 
+
+    std::shared_ptr<base::IBlock> copyBlock(const std::shared_ptr<base::IBlock> &block, const std::string &name,
+                                            CopyIds ids);
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -130,6 +168,104 @@ public:
     FileMode fileMode() const;
 
 
+    void deferTimestamps(bool defer);
+
+
+    bool deferTimestamps() const;
+
+
+    void compactProperties(bool compact);
+
+
+    bool compactProperties() const;
+
+    /**
+     * @brief Raise the format version of the file to HDF5_FF_COMPACT_VERSION
+     * unless it is there already. Must be called before a property is
+     * stored in a compact layout.
+     */
+    void requireCompactVersion();
+
+
+    void collectIOStatistics(bool collect);
+
+
+    bool collectIOStatistics() const;
+
+
+    IOStatistics ioStatistics() const;
+
+
+    void resetIOStatistics();
+
+
+    void filterThreads(size_t threads);
+
+
+    size_t filterThreads() const;
+
+    /**
+     * @brief Record the updated_at time stamp of an entity, if time stamps
+     * are deferred. For use by the entity implementations.
+     *
+     * @param obj     The group or data set of the entity.
+     * @param t       The time of the update.
+     * @param force   Whether to replace an already pending time stamp.
+     *
+     * @return False if time stamps are not deferred and the caller must
+     *         write the attribute itself.
+     */
+    bool deferUpdatedAt(const LocID &obj, time_t t, bool force = true);
+
+    /**
+     * @brief Get the pending (not yet written) updated_at time stamp of
+     * an entity, if any.
+     */
+    boost::optional<time_t> pendingUpdatedAt(const LocID &obj) const;
+
+    /**
+     * @brief Forget the pending time stamps and the attribute generations
+     * of the entities that are freed when an object is unlinked. Must be
+     * called before the unlinking.
+     *
+     * Besides the object itself these are the objects below it that are
+     * linked only from objects that are freed as well; sections linked
+     * as metadata, for example, stay. Their addresses may be reused by
+     * new objects, so their time stamps must not be written on flush and
+     * their generations must not carry over.
+     *
+     * @param obj         The group or data set to be unlinked.
+     * @param all_links   Whether all links to the object are removed, or
+     *                    only one.
+     */
+    void dropPendingUpdates(const LocID &obj, bool all_links);
+
+    /**
+     * @brief Get the generation of the standard attributes of an entity,
+     * which is bumped with {@link bumpAttributeGeneration} whenever one
+     * of them is written. 0 if none was written since the file was opened.
+     *
+     * @param addr    The address of the group or data set of the entity.
+     */
+    uint64_t attributeGeneration(haddr_t addr) const;
+
+    /**
+     * @brief Invalidate the cached standard attributes of all entity
+     * objects of the group or data set at an address.
+     */
+    void bumpAttributeGeneration(haddr_t addr);
+
+    /**
+     * @brief Get the reference index of a block, building it on first use.
+     */
+    std::shared_ptr<ReferenceIndex> referenceIndex(const H5Group &block);
+
+    /**
+     * @brief Get the reference index of a block if it was built.
+     */
+    std::shared_ptr<ReferenceIndex> existingReferenceIndex(const H5Group &block) const;
+
+
     bool operator==(const FileHDF5 &other) const;
 
 
@@ -149,10 +285,13 @@ private:
     void openRoot();
 
 
-    bool checkHeader(FileMode mode) const;
+    void checkHeader(FileMode mode);
 
 
     void createHeader() const;
+
+
+    void writePendingUpdates();
 };
 
 
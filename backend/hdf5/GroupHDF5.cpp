@@ -11,6 +11,7 @@
 #include "TagHDF5.hpp"
 #include "MultiTagHDF5.hpp"
 #include "BlockHDF5.hpp"
+#include "ReferenceIndex.hpp"
 #include <boost/range/irange.hpp>
 
 using namespace nix::base;
@@ -65,6 +66,11 @@ void GroupHDF5::addDataArray(const std::string &name_or_id) {
 
     auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
     g->createLink(target->group(), target->id());
+
+    std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+    if (index) {
+        index->add(target->id(), ReferenceIndex::group(name()));
+    }
 }
 
 
@@ -100,6 +106,11 @@ bool GroupHDF5::removeDataArray(const std::string &name_or_id) {
 
         g->removeGroup(data_array->id());
         removed = true;
+
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        if (index) {
+            index->remove(data_array->id(), ReferenceIndex::group(name()));
+        }
     }
     return removed;
 }
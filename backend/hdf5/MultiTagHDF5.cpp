@@ -68,12 +68,15 @@ std::shared_ptr<IDataArray> MultiTagHDF5::positions() const {
 void MultiTagHDF5::positions(const std::string &name_or_id) {
     if (!block()->hasDataArray(name_or_id))
         throw std::runtime_error("MultiTagHDF5::positions: DataArray not found in block!");
+    std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+    std::string old_id = index ? linkedId("positions") : "";
     if (group().hasGroup("positions"))
         group().removeGroup("positions");
     
     auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
 
     group().createLink(target->group(), "positions");
+    relink(index, old_id, target->id());
     forceUpdatedAt();
 }
 
@@ -107,8 +110,11 @@ std::shared_ptr<IDataArray>  MultiTagHDF5::extents() const {
 void MultiTagHDF5::extents(const std::string &name_or_id) {
     if (!block()->hasDataArray(name_or_id))
         throw std::runtime_error("MultiTagHDF5::extents: DataArray not found in block!");
-    if (group().hasGroup("extents"))
+    std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+    if (group().hasGroup("extents")) {
+        relink(index, index ? linkedId("extents") : "", "");
         group().removeGroup("extents");
+    }
 
     auto da = block()->getDataArray(name_or_id);
     if (!checkDimensions(da, positions()))
@@ -116,11 +122,14 @@ void MultiTagHDF5::extents(const std::string &name_or_id) {
     auto target = std::dynamic_pointer_cast<DataArrayHDF5>(da);
 
     group().createLink(target->group(), "extents");
+    relink(index, "", target->id());
     forceUpdatedAt();
 }
 
 void MultiTagHDF5::extents(const none_t t) {
     if (group().hasGroup("extents")) {
+        std::shared_ptr<ReferenceIndex> index = existingReferenceIndex(file(), block());
+        relink(index, index ? linkedId("extents") : "", "");
         group().removeGroup("extents");
     }
     forceUpdatedAt();
@@ -153,6 +162,34 @@ bool MultiTagHDF5::checkDimensions(const DataArray &a, const DataArray &b)const
 }
 
 
+ReferenceIndex::Referrer MultiTagHDF5::indexReferrer() const {
+    return ReferenceIndex::multiTag(name());
+}
+
+
+std::string MultiTagHDF5::linkedId(const std::string &link) const {
+    std::string id;
+    if (group().hasGroup(link)) {
+        group().openGroup(link, false).getAttr("entity_id", id);
+    }
+    return id;
+}
+
+
+void MultiTagHDF5::relink(const std::shared_ptr<ReferenceIndex> &index, const std::string &old_id,
+                          const std::string &new_id) {
+    if (!index) {
+        return;
+    }
+    if (!old_id.empty()) {
+        index->remove(old_id, indexReferrer());
+    }
+    if (!new_id.empty()) {
+        index->add(new_id, indexReferrer());
+    }
+}
+
+
 MultiTagHDF5::~MultiTagHDF5() {}
 
 } // ns nix::hdf5
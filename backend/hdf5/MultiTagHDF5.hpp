@@ -75,10 +75,20 @@ public:
 
     virtual ~MultiTagHDF5();
 
+protected:
+
+    ReferenceIndex::Referrer indexReferrer() const;
+
 private:
 
     bool checkDimensions(const DataArray &a, const DataArray &b) const;
 
+    // the id of the data array behind the positions or extents link, if any
+    std::string linkedId(const std::string &link) const;
+
+    // keep the reference index in sync when a positions or extents link changes
+    void relink(const std::shared_ptr<ReferenceIndex> &index, const std::string &old_id, const std::string &new_id);
+
 };
 
 
@@ -43,6 +43,7 @@ NamedEntityHDF5::NamedEntityHDF5(const std::shared_ptr<IFile> &file, const H5Gro
         throw EmptyString("name");
     } else {
         group.setAttr("name", name);
+        invalidateAttributes();
         forceUpdatedAt();
     }
 
@@ -54,16 +55,16 @@ void NamedEntityHDF5::type(const string &type) {
         throw EmptyString("type");
     } else {
         group().setAttr("type", type);
+        invalidateAttributes();
         forceUpdatedAt();
     }
 }
 
 
 string NamedEntityHDF5::type() const {
-    string type;
-    if (group().hasAttr("type")) {
-        group().getAttr("type", type);
-        return type;
+    std::shared_ptr<const EntityAttributes> attrs = attributes();
+    if (attrs->type) {
+        return *attrs->type;
     } else {
         throw MissingAttr("type");
     }
@@ -71,10 +72,9 @@ string NamedEntityHDF5::type() const {
 
 
 string NamedEntityHDF5::name() const {
-    string name;
-    if (group().hasAttr("name")) {
-        group().getAttr("name", name);
-        return name;
+    std::shared_ptr<const EntityAttributes> attrs = attributes();
+    if (attrs->name) {
+        return *attrs->name;
     } else {
         throw MissingAttr("name");
     }
@@ -86,25 +86,21 @@ void NamedEntityHDF5::definition(const string &definition) {
         throw EmptyString("definition");
     } else {
         group().setAttr("definition", definition);
+        invalidateAttributes();
         forceUpdatedAt();
     }
 }
 
 
 boost::optional<string> NamedEntityHDF5::definition() const {
-    boost::optional<string> ret;
-    string definition;
-    bool have_attr = group().getAttr("definition", definition);
-    if (have_attr) {
-        ret = definition;
-    }
-    return ret;
+    return attributes()->definition;
 }
 
 
 void NamedEntityHDF5::definition(const nix::none_t t) {
     if (group().hasAttr("definition")) {
         group().removeAttr("definition");
+        invalidateAttributes();
     }
     forceUpdatedAt();
 }
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "PropertyHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include <nix/util/util.hpp>
 
@@ -84,6 +85,12 @@ string PropertyHDF5::id() const {
 
 
 time_t PropertyHDF5::updatedAt() const {
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(entity_file.get());
+    boost::optional<time_t> pending = h5file ? h5file->pendingUpdatedAt(entity_dataset) : boost::none;
+    if (pending) {
+        return *pending;
+    }
+
     string t;
     dataset().getAttr("updated_at", t);
     return util::strToTime(t);
@@ -92,14 +99,25 @@ time_t PropertyHDF5::updatedAt() const {
 
 void PropertyHDF5::setUpdatedAt() {
     if (!dataset().hasAttr("updated_at")) {
-        time_t t = util::getTime();
-        dataset().setAttr("updated_at", util::timeToStr(t));
+        writeUpdatedAt(false);
     }
 }
 
 
 void PropertyHDF5::forceUpdatedAt() {
+    writeUpdatedAt(true);
+}
+
+
+void PropertyHDF5::writeUpdatedAt(bool force) {
     time_t t = util::getTime();
+
+    // in deferred mode the file writes the time stamp on flush or close
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(entity_file.get());
+    if (h5file && h5file->deferUpdatedAt(entity_dataset, t, force)) {
+        return;
+    }
+
     dataset().setAttr("updated_at", util::timeToStr(t));
 }
 
@@ -243,10 +261,36 @@ struct PACKED FileValue  {
 
     inline T val() const { return value; }
 };
+
+template<typename T>
+struct PACKED CompactValue {
+
+    T       value;
+
+    double  uncertainty;
+
+    //ctors
+    CompactValue() {}
+    explicit CompactValue(const T &vref) : value(vref) { }
+
+    inline T val() const { return value; }
+};
 #ifdef _MSC_VER
 #pragma pack(pop)
 #endif
 
+template<typename T>
+struct PlainValue {
+
+    T       value;
+
+    //ctors
+    PlainValue() {}
+    explicit PlainValue(const T &vref) : value(vref) { }
+
+    inline T val() const { return value; }
+};
+
 //
 
 template<typename T>
@@ -270,23 +314,47 @@ h5x::DataType h5_type_for_value(bool for_memory)
     return ct;
 }
 
+
+template<typename T>
+h5x::DataType h5_type_for_value(ValueLayout layout, bool for_memory)
+{
+    typedef CompactValue<T> compact_value_t;
+
+    if (layout == ValueLayout::Full) {
+        return h5_type_for_value<T>(for_memory);
+    }
+
+    h5x::DataType value_type = data_type_to_h5(to_data_type<T>::value, for_memory);
+    if (layout == ValueLayout::Plain) {
+        return value_type;
+    }
+
+    h5x::DataType ct = h5x::DataType::makeCompound(sizeof(compact_value_t));
+    h5x::DataType double_type = data_type_to_h5(DataType::Double, for_memory);
+
+    ct.insert("value", HOFFSET(compact_value_t, value), value_type);
+    ct.insert("uncertainty", HOFFSET(compact_value_t, uncertainty), double_type);
+
+    return ct;
+}
+
 #if 0 //set to one to check that all supported DataTypes are handled
 #define CHECK_SUPOORTED_VALUES
 #endif
 #define DATATYPE_SUPPORT_NOT_IMPLEMENTED false
 
-h5x::DataType PropertyHDF5::fileTypeForValue(DataType dtype)
+h5x::DataType PropertyHDF5::fileTypeForValue(DataType dtype, ValueLayout layout)
 {
     const bool for_memory = false;
 
     switch(dtype) {
-        case DataType::Bool:   return h5_type_for_value<bool>(for_memory);
-        case DataType::Int32:  return h5_type_for_value<int32_t>(for_memory);
-        case DataType::UInt32: return h5_type_for_value<uint32_t>(for_memory);
-        case DataType::Int64:  return h5_type_for_value<int64_t>(for_memory);
-        case DataType::UInt64: return h5_type_for_value<uint64_t>(for_memory);
-        case DataType::Double: return h5_type_for_value<double>(for_memory);
-        case DataType::String: return h5_type_for_value<char *>(for_memory);
+        case DataType::Bool:   return h5_type_for_value<bool>(layout, for_memory);
+        case DataType::Int32:  return h5_type_for_value<int32_t>(layout, for_memory);
+        case DataType::UInt32: return h5_type_for_value<uint32_t>(layout, for_memory);
+        case DataType::Int64:  return h5_type_for_value<int64_t>(layout, for_memory);
+        case DataType::UInt64: return h5_type_for_value<uint64_t>(layout, for_memory);
+        case DataType::Double: return h5_type_for_value<double>(layout, for_memory);
+        case DataType::String: return h5_type_for_value<char *>(layout, for_memory);
 #ifndef CHECK_SUPOORTED_VALUES
         default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED); break;
 #endif
@@ -296,56 +364,193 @@ h5x::DataType PropertyHDF5::fileTypeForValue(DataType dtype)
 }
 
 
+ValueLayout PropertyHDF5::valueLayout(const std::vector<Value> &values) {
+    ValueLayout layout = ValueLayout::Plain;
+    for (const auto &val : values) {
+        if (!val.reference.empty() || !val.filename.empty() ||
+            !val.encoder.empty() || !val.checksum.empty()) {
+            return ValueLayout::Full;
+        }
+        if (val.uncertainty != 0.0) {
+            layout = ValueLayout::Uncertainty;
+        }
+    }
+    return layout;
+}
+
+
+ValueLayout PropertyHDF5::valueLayout() const {
+    h5x::DataType dtype = dataset().dataType();
+    if (!dtype.isCompound()) {
+        return ValueLayout::Plain;
+    }
+    return dtype.member_count() == 2 ? ValueLayout::Uncertainty : ValueLayout::Full;
+}
+
+
+// file values of the compact layouts have no strings to copy
 template<typename T>
-void do_read_value(const DataSet &h5ds, size_t size, std::vector<Value> &values)
-{
-    h5x::DataType memType = h5_type_for_value<T>(true);
+void set_value_fields(Value &value, const PlainValue<T> &fileVal) { }
 
-    typedef FileValue<T> file_value_t;
+template<typename T>
+void set_value_fields(Value &value, const CompactValue<T> &fileVal) {
+    value.uncertainty = fileVal.uncertainty;
+}
+
+template<typename T>
+void set_value_fields(Value &value, const FileValue<T> &fileVal) {
+    value.uncertainty = fileVal.uncertainty;
+    value.reference = fileVal.reference;
+    value.filename = fileVal.filename;
+    value.encoder = fileVal.encoder;
+    value.checksum = fileVal.checksum;
+}
+
+
+template<typename T>
+void set_file_fields(PlainValue<T> &fileVal, const Value &value) { }
+
+template<typename T>
+void set_file_fields(CompactValue<T> &fileVal, const Value &value) {
+    fileVal.uncertainty = value.uncertainty;
+}
+
+template<typename T>
+void set_file_fields(FileValue<T> &fileVal, const Value &value) {
+    fileVal.uncertainty = value.uncertainty;
+    fileVal.reference = const_cast<char *>(value.reference.c_str());
+    fileVal.filename = const_cast<char *>(value.filename.c_str());
+    fileVal.encoder = const_cast<char *>(value.encoder.c_str());
+    fileVal.checksum = const_cast<char *>(value.checksum.c_str());
+}
+
+
+template<typename T, template<typename> class FV>
+void do_read_value(const DataSet &h5ds, const h5x::DataType &memType, size_t size, size_t offset,
+                   std::vector<Value> &values)
+{
+    typedef FV<T> file_value_t;
     std::vector<file_value_t> fileValues;
 
     fileValues.resize(size);
     values.resize(size);
 
-    h5ds.read(fileValues.data(), memType, H5S_ALL, H5S_ALL);
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = h5ds.offsetCount2DataSpaces(NDSize{size}, NDSize{offset});
+    h5ds.read(fileValues.data(), memType, memSpace, fileSpace);
 
     std::transform(fileValues.begin(), fileValues.end(), values.begin(), [](const file_value_t &val) {
         Value temp(val.val());
-        temp.uncertainty = val.uncertainty;
-        temp.reference = val.reference;
-        temp.filename = val.filename;
-        temp.encoder = val.encoder;
-        temp.checksum = val.checksum;
+        set_value_fields(temp, val);
         return temp;
     });
 
-    h5ds.vlenReclaim(memType, fileValues.data());
+    // only strings allocate memory while reading
+    if (std::is_same<file_value_t, FileValue<T>>::value || to_data_type<T>::value == DataType::String) {
+        h5ds.vlenReclaim(memType, fileValues.data(), &memSpace);
+    }
+}
+
+
+template<typename T>
+void do_read_value(const DataSet &h5ds, ValueLayout layout, size_t size, size_t offset, std::vector<Value> &values)
+{
+    h5x::DataType memType = h5_type_for_value<T>(layout, true);
+
+    switch (layout) {
+        case ValueLayout::Plain:       do_read_value<T, PlainValue>(h5ds, memType, size, offset, values);   break;
+        case ValueLayout::Uncertainty: do_read_value<T, CompactValue>(h5ds, memType, size, offset, values); break;
+        case ValueLayout::Full:        do_read_value<T, FileValue>(h5ds, memType, size, offset, values);    break;
+    }
 }
 
 
 #define NOT_IMPLEMENTED 1
 
-template<typename T>
-void do_write_value(DataSet &h5ds, const std::vector<Value> &values)
+template<typename T, template<typename> class FV>
+void do_write_value(DataSet &h5ds, const h5x::DataType &memType, const std::vector<Value> &values, size_t offset)
 {
-    typedef FileValue<T> file_value_t;
+    typedef FV<T> file_value_t;
     std::vector<file_value_t> fileValues;
 
     fileValues.resize(values.size());
 
     std::transform(values.begin(), values.end(), fileValues.begin(), [](const Value &val) {
         file_value_t fileVal(val.get<T>());
-        fileVal.uncertainty = val.uncertainty;
-        fileVal.reference = const_cast<char *>(val.reference.c_str());
-        fileVal.filename = const_cast<char *>(val.filename.c_str());
-        fileVal.encoder = const_cast<char *>(val.encoder.c_str());
-        fileVal.checksum = const_cast<char *>(val.checksum.c_str());
-
+        set_file_fields(fileVal, val);
         return fileVal;
     });
 
-    h5x::DataType memType = h5_type_for_value<T>(true);
-    h5ds.write(fileValues.data(), memType, H5S_ALL, H5S_ALL);
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = h5ds.offsetCount2DataSpaces(NDSize{values.size()}, NDSize{offset});
+    h5ds.write(fileValues.data(), memType, memSpace, fileSpace);
+}
+
+
+template<typename T>
+void do_write_value(DataSet &h5ds, ValueLayout layout, const std::vector<Value> &values, size_t offset)
+{
+    h5x::DataType memType = h5_type_for_value<T>(layout, true);
+
+    switch (layout) {
+        case ValueLayout::Plain:       do_write_value<T, PlainValue>(h5ds, memType, values, offset);   break;
+        case ValueLayout::Uncertainty: do_write_value<T, CompactValue>(h5ds, memType, values, offset); break;
+        case ValueLayout::Full:        do_write_value<T, FileValue>(h5ds, memType, values, offset);    break;
+    }
+}
+
+
+void write_values(DataSet &dset, ValueLayout layout, const std::vector<Value> &values, size_t offset)
+{
+    switch(values[0].type()) {
+
+        case DataType::Bool:   do_write_value<bool>(dset, layout, values, offset); break;
+        case DataType::Int32:  do_write_value<int32_t>(dset, layout, values, offset); break;
+        case DataType::UInt32: do_write_value<uint32_t>(dset, layout, values, offset); break;
+        case DataType::Int64:  do_write_value<int64_t>(dset, layout, values, offset); break;
+        case DataType::UInt64: do_write_value<uint64_t>(dset, layout, values, offset); break;
+        case DataType::String: do_write_value<const char *>(dset, layout, values, offset); break;
+        case DataType::Double: do_write_value<double>(dset, layout, values, offset); break;
+#ifndef CHECK_SUPOORTED_VALUES
+        default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED);
+#endif
+    }
+}
+
+
+template<typename T>
+void append_typed(std::vector<Value> &values, const void *data, size_t count)
+{
+    const T *typed = static_cast<const T *>(data);
+    values.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        values.emplace_back(typed[i]);
+    }
+}
+
+
+std::vector<Value> make_values(DataType dtype, const void *data, size_t count)
+{
+    std::vector<Value> values;
+    switch (dtype) {
+        case DataType::Bool:   append_typed<bool>(values, data, count);        break;
+        case DataType::Int32:  append_typed<int32_t>(values, data, count);     break;
+        case DataType::UInt32: append_typed<uint32_t>(values, data, count);    break;
+        case DataType::Int64:  append_typed<int64_t>(values, data, count);     break;
+        case DataType::UInt64: append_typed<uint64_t>(values, data, count);    break;
+        case DataType::String: append_typed<std::string>(values, data, count); break;
+        case DataType::Double: append_typed<double>(values, data, count);      break;
+        default: throw std::invalid_argument("Unsupported data type for property values");
+    }
+    return values;
+}
+
+
+void PropertyHDF5::checkLayout(const std::vector<Value> &values) const {
+    // the type of a data set cannot be changed after its creation
+    if (valueLayout(values) > valueLayout()) {
+        throw std::invalid_argument("Property::values(): the values use fields that the compact property does not store");
+    }
 }
 
 // value public API
@@ -368,30 +573,21 @@ void PropertyHDF5::values(const std::vector<Value> &values)
         return;
     }
 
+    checkLayout(values);
+
     DataSet dset = dataset();
     dset.setExtent(NDSize{values.size()});
+    write_values(dset, valueLayout(), values, 0);
+}
 
-    if (values.size() < 1) {
-        return; //nothing to do
-    }
-
-    switch(values[0].type()) {
 
-        case DataType::Bool:   do_write_value<bool>(dset, values); break;
-        case DataType::Int32:  do_write_value<int32_t>(dset, values); break;
-        case DataType::UInt32: do_write_value<uint32_t>(dset, values); break;
-        case DataType::Int64:  do_write_value<int64_t>(dset, values); break;
-        case DataType::UInt64: do_write_value<uint64_t>(dset, values); break;
-        case DataType::String: do_write_value<const char *>(dset, values); break;
-        case DataType::Double: do_write_value<double>(dset, values); break;
-#ifndef CHECK_SUPOORTED_VALUES
-        default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED);
-#endif
-    }
+std::vector<Value> PropertyHDF5::values(void) const
+{
+    return values(0, valueCount());
 }
 
 
-std::vector<Value> PropertyHDF5::values(void) const
+std::vector<Value> PropertyHDF5::values(ndsize_t offset, ndsize_t count) const
 {
     std::vector<Value> values;
 
@@ -399,21 +595,26 @@ std::vector<Value> PropertyHDF5::values(void) const
     DataType dtype = data_type_from_h5(dset.dataType());
     NDSize shape = dset.size();
 
-    if (shape.size() < 1 || shape[0] < 1) {
+    if (count < 1) {
         return values;
     }
 
     assert(shape.size() == 1);
-    size_t nvalues = nix::check::fits_in_size_t(shape[0], "Can't resize: data to big for memory");
+    if (offset + count > shape[0]) {
+        throw OutOfBounds("Property::values(): range exceeds the values of the property", offset + count);
+    }
+    size_t nvalues = nix::check::fits_in_size_t(count, "Can't resize: data to big for memory");
+    size_t first = nix::check::fits_in_size_t(offset, "Offset exceeds the addressable range");
+    ValueLayout layout = valueLayout();
 
     switch (dtype) {
-        case DataType::Bool:   do_read_value<bool>(dset, nvalues, values);     break;
-        case DataType::Int32:  do_read_value<int32_t>(dset, nvalues, values);  break;
-        case DataType::UInt32: do_read_value<uint32_t>(dset, nvalues, values); break;
-        case DataType::Int64:  do_read_value<int64_t>(dset, nvalues, values);  break;
-        case DataType::UInt64: do_read_value<uint64_t>(dset, nvalues, values); break;
-        case DataType::String: do_read_value<char *>(dset, nvalues, values);   break;
-        case DataType::Double: do_read_value<double>(dset, nvalues, values);   break;
+        case DataType::Bool:   do_read_value<bool>(dset, layout, nvalues, first, values);     break;
+        case DataType::Int32:  do_read_value<int32_t>(dset, layout, nvalues, first, values);  break;
+        case DataType::UInt32: do_read_value<uint32_t>(dset, layout, nvalues, first, values); break;
+        case DataType::Int64:  do_read_value<int64_t>(dset, layout, nvalues, first, values);  break;
+        case DataType::UInt64: do_read_value<uint64_t>(dset, layout, nvalues, first, values); break;
+        case DataType::String: do_read_value<char *>(dset, layout, nvalues, first, values);   break;
+        case DataType::Double: do_read_value<double>(dset, layout, nvalues, first, values);   break;
 #ifndef CHECK_SUPOORTED_VALUES
         default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED);
 #endif
@@ -424,6 +625,79 @@ std::vector<Value> PropertyHDF5::values(void) const
 }
 
 
+void PropertyHDF5::readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const
+{
+    DataSet dset = dataset();
+    if (offset + count > valueCount()) {
+        throw OutOfBounds("Property::values(): range exceeds the values of the property", offset + count);
+    }
+    if (count < 1) {
+        return;
+    }
+
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    if (valueLayout() == ValueLayout::Plain) {
+        dset.read(data, memType, NDSize{count}, NDSize{offset});
+        return;
+    }
+
+    // read only the value member of the compound
+    const size_t nvalues = nix::check::fits_in_size_t(count, "Can't resize: data to big for memory");
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = dset.offsetCount2DataSpaces(NDSize{count}, NDSize{offset});
+
+    h5x::DataType valueType = h5x::DataType::makeCompound(memType.size());
+    valueType.insert("value", 0, memType);
+
+    if (dtype == DataType::String) {
+        std::vector<char *> strings(nvalues);
+        dset.read(strings.data(), valueType, memSpace, fileSpace);
+        std::string *out = static_cast<std::string *>(data);
+        for (size_t i = 0; i < nvalues; i++) {
+            out[i] = strings[i];
+        }
+        dset.vlenReclaim(valueType, strings.data(), &memSpace);
+    } else {
+        dset.read(data, valueType, memSpace, fileSpace);
+    }
+}
+
+
+void PropertyHDF5::appendValues(const std::vector<Value> &values)
+{
+    if (values.size() < 1) {
+        return;
+    }
+
+    checkLayout(values);
+
+    DataSet dset = dataset();
+    ndsize_t offset = valueCount();
+    dset.setExtent(NDSize{offset + values.size()});
+    write_values(dset, valueLayout(), values, nix::check::fits_in_size_t(offset, "Offset exceeds the addressable range"));
+}
+
+
+void PropertyHDF5::appendValues(DataType dtype, const void *data, ndsize_t count)
+{
+    if (count < 1) {
+        return;
+    }
+
+    size_t nvalues = nix::check::fits_in_size_t(count, "Can't resize: data to big for memory");
+    if (valueLayout() != ValueLayout::Plain) {
+        // the other fields of compound values must not be left unset
+        appendValues(make_values(dtype, data, nvalues));
+        return;
+    }
+
+    DataSet dset = dataset();
+    ndsize_t offset = valueCount();
+    dset.setExtent(NDSize{offset + count});
+    dset.write(data, data_type_to_h5_memtype(dtype), NDSize{count}, NDSize{offset});
+}
+
+
 void PropertyHDF5::values(const nix::none_t t) {
     // TODO: rethink if we want two methods for same thing
     deleteValues();
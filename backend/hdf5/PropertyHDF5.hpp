@@ -21,6 +21,21 @@
 namespace nix {
 namespace hdf5 {
 
+/**
+ * @brief How the values of a property are stored.
+ *
+ * Plain stores only the values, Uncertainty the values and their
+ * uncertainties, Full all fields of a Value including the variable
+ * length reference, filename, encoder and checksum strings. The layouts
+ * are ordered by the fields they store. The layout of a property is fixed
+ * when it is created; Plain and Uncertainty are only used for properties
+ * created from values while compact properties are enabled on the file.
+ */
+enum class ValueLayout : int {
+    Plain = 0,
+    Uncertainty,
+    Full
+};
 
 class PropertyHDF5 : virtual public base::IProperty {
     
@@ -114,6 +129,18 @@ public:
     std::vector<Value> values(void) const;
 
 
+    std::vector<Value> values(ndsize_t offset, ndsize_t count) const;
+
+
+    void readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const;
+
+
+    void appendValues(const std::vector<Value> &values);
+
+
+    void appendValues(DataType dtype, const void *data, ndsize_t count);
+
+
     void values(const boost::none_t t);
 
 
@@ -125,7 +152,14 @@ public:
 
     bool operator!=(const PropertyHDF5 &other) const; //FIXME: not implemented
 
-    static h5x::DataType fileTypeForValue(DataType dtype);
+    static h5x::DataType fileTypeForValue(DataType dtype, ValueLayout layout = ValueLayout::Full);
+
+    /**
+     * @brief The most compact layout that can store all fields of the values.
+     */
+    static ValueLayout valueLayout(const std::vector<Value> &values);
+
+    ValueLayout valueLayout() const;
 
     virtual ~PropertyHDF5();
 
@@ -135,6 +169,12 @@ private:
         return entity_dataset;
     }
 
+
+    void writeUpdatedAt(bool force);
+
+
+    void checkLayout(const std::vector<Value> &values) const;
+
 };
 
 
@@ -0,0 +1,261 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "ReferenceIndex.hpp"
+#include "FileHDF5.hpp"
+#include "BlockHDF5.hpp"
+
+#include <algorithm>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// the id of the data array behind a link of an entity group, if any
+bool linkedId(const H5Group &entity, const std::string &link, std::string &id) {
+    if (!entity.hasGroup(link)) {
+        return false;
+    }
+    return entity.openGroup(link, false).getAttr("entity_id", id);
+}
+
+} // anonymous namespace
+
+
+ReferenceIndex::Referrer ReferenceIndex::tag(const std::string &name) {
+    return Referrer{Kind::Tag, name, "", Kind::Tag};
+}
+
+
+ReferenceIndex::Referrer ReferenceIndex::multiTag(const std::string &name) {
+    return Referrer{Kind::MultiTag, name, "", Kind::MultiTag};
+}
+
+
+ReferenceIndex::Referrer ReferenceIndex::group(const std::string &name) {
+    return Referrer{Kind::Group, name, "", Kind::Group};
+}
+
+
+ReferenceIndex::Referrer ReferenceIndex::feature(Kind owner, const std::string &owner_name, const std::string &id) {
+    return Referrer{Kind::Feature, owner_name, id, owner};
+}
+
+
+ReferenceIndex::ReferenceIndex(const H5Group &block) {
+    if (block.hasGroup("tags")) {
+        addTags(block.openGroup("tags", false), Kind::Tag);
+    }
+    if (block.hasGroup("multi_tags")) {
+        addTags(block.openGroup("multi_tags", false), Kind::MultiTag);
+    }
+    if (block.hasGroup("groups")) {
+        H5Group groups = block.openGroup("groups", false);
+        for (ndsize_t i = 0; i < groups.objectCount(); i++) {
+            std::string name = groups.objectName(i);
+            H5Group group = groups.openGroup(name, false);
+            if (!group.hasGroup("data_arrays")) {
+                continue;
+            }
+            // links in the data_arrays group are named by the id of their target
+            H5Group data_arrays = group.openGroup("data_arrays", false);
+            for (ndsize_t j = 0; j < data_arrays.objectCount(); j++) {
+                addUnlocked(data_arrays.objectName(j), ReferenceIndex::group(name));
+            }
+        }
+    }
+}
+
+
+void ReferenceIndex::addTags(const H5Group &tags, Kind kind) {
+    for (ndsize_t i = 0; i < tags.objectCount(); i++) {
+        std::string name = tags.objectName(i);
+        H5Group tag = tags.openGroup(name, false);
+        Referrer referrer = kind == Kind::Tag ? ReferenceIndex::tag(name) : multiTag(name);
+
+        if (tag.hasGroup("references")) {
+            H5Group refs = tag.openGroup("references", false);
+            for (ndsize_t j = 0; j < refs.objectCount(); j++) {
+                addUnlocked(refs.objectName(j), referrer);
+            }
+        }
+
+        std::string id;
+        if (kind == Kind::MultiTag) {
+            if (linkedId(tag, "positions", id)) {
+                addUnlocked(id, referrer);
+            }
+            if (linkedId(tag, "extents", id)) {
+                addUnlocked(id, referrer);
+            }
+        }
+
+        if (tag.hasGroup("features")) {
+            H5Group features = tag.openGroup("features", false);
+            for (ndsize_t j = 0; j < features.objectCount(); j++) {
+                std::string feature_id = features.objectName(j);
+                if (linkedId(features.openGroup(feature_id, false), "data", id)) {
+                    addUnlocked(id, feature(kind, name, feature_id));
+                }
+            }
+        }
+    }
+}
+
+
+std::vector<ReferenceIndex::Referrer> ReferenceIndex::referrers(const std::string &data_array_id, Kind kind) const {
+    std::vector<Referrer> result;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = links.find(data_array_id);
+    if (it == links.end()) {
+        return result;
+    }
+    for (const auto &referrer : it->second) {
+        if (referrer.kind == kind &&
+            std::find(result.begin(), result.end(), referrer) == result.end()) {
+            result.push_back(referrer);
+        }
+    }
+    return result;
+}
+
+
+void ReferenceIndex::add(const std::string &data_array_id, const Referrer &referrer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    addUnlocked(data_array_id, referrer);
+}
+
+
+void ReferenceIndex::addUnlocked(const std::string &data_array_id, const Referrer &referrer) {
+    links[data_array_id].push_back(referrer);
+    if (referrer.kind == Kind::Feature) {
+        feature_targets[referrer.feature] = data_array_id;
+    }
+}
+
+
+void ReferenceIndex::remove(const std::string &data_array_id, const Referrer &referrer) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = links.find(data_array_id);
+    if (it == links.end()) {
+        return;
+    }
+    auto pos = std::find(it->second.begin(), it->second.end(), referrer);
+    if (pos != it->second.end()) {
+        it->second.erase(pos);
+    }
+    if (it->second.empty()) {
+        links.erase(it);
+    }
+}
+
+
+void ReferenceIndex::retargetFeature(const std::string &feature_id, const std::string &data_array_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto target = feature_targets.find(feature_id);
+    if (target == feature_targets.end()) {
+        return;
+    }
+    std::vector<Referrer> &old_links = links[target->second];
+    for (auto it = old_links.begin(); it != old_links.end(); ++it) {
+        if (it->kind == Kind::Feature && it->feature == feature_id) {
+            Referrer referrer = *it;
+            old_links.erase(it);
+            if (old_links.empty()) {
+                links.erase(target->second);
+            }
+            addUnlocked(data_array_id, referrer);
+            break;
+        }
+    }
+}
+
+
+void ReferenceIndex::removeFeature(const std::string &feature_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto target = feature_targets.find(feature_id);
+    if (target == feature_targets.end()) {
+        return;
+    }
+    auto it = links.find(target->second);
+    if (it != links.end()) {
+        auto &refs = it->second;
+        refs.erase(std::remove_if(refs.begin(), refs.end(), [&](const Referrer &r) {
+            return r.kind == Kind::Feature && r.feature == feature_id;
+        }), refs.end());
+        if (refs.empty()) {
+            links.erase(it);
+        }
+    }
+    feature_targets.erase(target);
+}
+
+
+void ReferenceIndex::removeReferrer(Kind kind, const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = links.begin(); it != links.end();) {
+        auto &refs = it->second;
+        refs.erase(std::remove_if(refs.begin(), refs.end(), [&](const Referrer &r) {
+            if (r.owner != kind || r.name != name) {
+                return false;
+            }
+            if (r.kind == Kind::Feature) {
+                feature_targets.erase(r.feature);
+            }
+            return true;
+        }), refs.end());
+        it = refs.empty() ? links.erase(it) : std::next(it);
+    }
+}
+
+
+void ReferenceIndex::removeDataArray(const std::string &data_array_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = links.find(data_array_id);
+    if (it == links.end()) {
+        return;
+    }
+    for (const auto &referrer : it->second) {
+        if (referrer.kind == Kind::Feature) {
+            feature_targets.erase(referrer.feature);
+        }
+    }
+    links.erase(it);
+}
+
+
+std::shared_ptr<ReferenceIndex> existingReferenceIndex(const std::shared_ptr<base::IFile> &file,
+                                                       const std::shared_ptr<base::IBlock> &block) {
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(file.get());
+    BlockHDF5 *h5block = dynamic_cast<BlockHDF5 *>(block.get());
+    if (!h5file || !h5block) {
+        return nullptr;
+    }
+    return h5file->existingReferenceIndex(h5block->group());
+}
+
+
+std::shared_ptr<ReferenceIndex> referenceIndex(const std::shared_ptr<base::IFile> &file,
+                                               const std::shared_ptr<base::IBlock> &block) {
+    FileHDF5 *h5file = dynamic_cast<FileHDF5 *>(file.get());
+    BlockHDF5 *h5block = dynamic_cast<BlockHDF5 *>(block.get());
+    if (!h5file || !h5block) {
+        throw std::runtime_error("referenceIndex: not an entity of a HDF5 file!");
+    }
+    return h5file->referenceIndex(h5block->group());
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,130 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REFERENCE_INDEX_HDF5_H
+#define NIX_REFERENCE_INDEX_HDF5_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/base/IBlock.hpp>
+
+#include "h5x/H5Group.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief The entities of a block that link to each of its data arrays.
+ *
+ * The index is built from the links of a block in a single traversal and
+ * is kept up to date by the entities of the block as they add or remove
+ * links to data arrays. Changes made through another handle of the same
+ * file are not seen by the index.
+ */
+class ReferenceIndex {
+
+public:
+
+    enum class Kind {Tag, MultiTag, Feature, Group};
+
+    /**
+     * @brief An entity that links to a data array.
+     */
+    struct Referrer {
+        Kind kind;
+        /** @brief The name of the entity or, for features, of the owning tag. */
+        std::string name;
+        /** @brief The id of the feature, empty for other kinds. */
+        std::string feature;
+        /** @brief The kind of the owning tag of a feature, else equal to kind. */
+        Kind owner;
+
+        bool operator==(const Referrer &other) const {
+            return kind == other.kind && owner == other.owner &&
+                   name == other.name && feature == other.feature;
+        }
+    };
+
+    static Referrer tag(const std::string &name);
+
+    static Referrer multiTag(const std::string &name);
+
+    static Referrer group(const std::string &name);
+
+    static Referrer feature(Kind owner, const std::string &owner_name, const std::string &id);
+
+    /**
+     * @brief Build the index of a block.
+     */
+    explicit ReferenceIndex(const H5Group &block);
+
+    /**
+     * @brief The entities of the given kind that link to a data array,
+     *        each entity once.
+     */
+    std::vector<Referrer> referrers(const std::string &data_array_id, Kind kind) const;
+
+    void add(const std::string &data_array_id, const Referrer &referrer);
+
+    /**
+     * @brief Remove one link from a referrer to a data array.
+     */
+    void remove(const std::string &data_array_id, const Referrer &referrer);
+
+    /**
+     * @brief Point an indexed feature at another data array.
+     */
+    void retargetFeature(const std::string &feature_id, const std::string &data_array_id);
+
+    void removeFeature(const std::string &feature_id);
+
+    /**
+     * @brief Remove all links of a deleted tag, multi tag or group,
+     *        including those of the features of a tag.
+     */
+    void removeReferrer(Kind kind, const std::string &name);
+
+    void removeDataArray(const std::string &data_array_id);
+
+private:
+
+    void addTags(const H5Group &tags, Kind kind);
+
+    void addUnlocked(const std::string &data_array_id, const Referrer &referrer);
+
+    mutable std::mutex mutex;
+    // data array id -> links to it, one entry per link
+    std::unordered_map<std::string, std::vector<Referrer>> links;
+    // feature id -> data array id
+    std::unordered_map<std::string, std::string> feature_targets;
+};
+
+/**
+ * @brief The reference index of the block of an entity, if it was built.
+ *
+ * Entities update the index through this accessor, so that modifications
+ * do not build an index nobody asked for.
+ */
+std::shared_ptr<ReferenceIndex> existingReferenceIndex(const std::shared_ptr<base::IFile> &file,
+                                                       const std::shared_ptr<base::IBlock> &block);
+
+/**
+ * @brief The reference index of the block of an entity, built on first use.
+ */
+std::shared_ptr<ReferenceIndex> referenceIndex(const std::shared_ptr<base::IFile> &file,
+                                               const std::shared_ptr<base::IBlock> &block);
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_REFERENCE_INDEX_HDF5_H
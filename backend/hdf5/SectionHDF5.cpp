@@ -14,6 +14,9 @@
 #include <nix/Section.hpp>
 
 #include "PropertyHDF5.hpp"
+#include "FileHDF5.hpp"
+
+#include <map>
 
 using namespace std;
 using namespace nix::base;
@@ -228,6 +231,7 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
             for (auto &child : section.sections()) {
                 section.deleteSection(child.id());
             }
+            dropPendingUpdates(g->openGroup(section.name(), false));
             // if hasSection is true then section_group always exists
             deleted = g->removeAllLinks(section.name());
         }
@@ -286,25 +290,85 @@ shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const Data
 
 
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const Value &value) {
-    shared_ptr<IProperty> p = createProperty(name, value.type());
     vector<Value> val{value};
-    p->values(val);
-    return p;
+    return createProperty(name, val);
 }
 
 
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const vector<Value> &values) {
-    shared_ptr<IProperty> p = createProperty(name, values[0].type());
+    string new_id = util::createId();
+    boost::optional<H5Group> g = property_group(true);
+
+    // the values are known: in compact mode use the smallest layout that holds them
+    ValueLayout layout = file()->compactProperties() ? PropertyHDF5::valueLayout(values) : ValueLayout::Full;
+    if (layout != ValueLayout::Full) {
+        dynamic_pointer_cast<FileHDF5>(file())->requireCompactVersion();
+    }
+    h5x::DataType fileType = PropertyHDF5::fileTypeForValue(values[0].type(), layout);
+    DataSet dataset = g->createData(name, fileType, {0});
+
+    shared_ptr<IProperty> p = make_shared<PropertyHDF5>(file(), dataset, new_id, name);
     p->values(values);
     return p;
 }
 
 
+vector<shared_ptr<IProperty>> SectionHDF5::createProperties(const vector<PropertySpec> &specs) {
+    vector<shared_ptr<IProperty>> props;
+    if (specs.empty()) {
+        return props;
+    }
+
+    boost::optional<H5Group> g = property_group(true);
+    for (const auto &spec : specs) {
+        if (g->hasObject(spec.name)) {
+            throw DuplicateName("createProperties");
+        }
+    }
+
+    // reuse one creation plist and the file types of all value types seen
+    H5Lock lock;
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("Could not create data creation plist");
+    map<pair<DataType, ValueLayout>, h5x::DataType> file_types;
+    time_t now = util::getTime();
+    bool compact = file()->compactProperties();
+
+    props.reserve(specs.size());
+    for (const auto &spec : specs) {
+        ValueLayout layout = compact ? PropertyHDF5::valueLayout(spec.values) : ValueLayout::Full;
+        if (layout != ValueLayout::Full) {
+            dynamic_pointer_cast<FileHDF5>(file())->requireCompactVersion();
+        }
+        auto key = make_pair(spec.values[0].type(), layout);
+        auto it = file_types.find(key);
+        if (it == file_types.end()) {
+            it = file_types.emplace(key, PropertyHDF5::fileTypeForValue(key.first, key.second)).first;
+        }
+
+        const h5x::DataType &fileType = it->second;
+        NDSize size{spec.values.size()};
+        NDSize chunks = DataSet::guessChunking(size, fileType.size());
+        HErr res = H5Pset_chunk(dcpl.h5id(), static_cast<int>(chunks.size()), chunks.data());
+        res.check("Could not set chunk size on data set creation plist");
+
+        DataSet dataset = g->createData(spec.name, fileType, DataSpace::create(size, true), dcpl);
+        auto p = make_shared<PropertyHDF5>(file(), dataset, util::createId(), spec.name, now);
+        p->values(spec.values);
+        props.push_back(p);
+    }
+
+    return props;
+}
+
+
 bool SectionHDF5::deleteProperty(const string &name_or_id) {
     boost::optional<H5Group> g = property_group();
     bool deleted = false;
     if (g && hasProperty(name_or_id)) {
-        g->removeData(getProperty(name_or_id)->name());
+        std::string name = getProperty(name_or_id)->name();
+        dropPendingUpdates(g->openData(name), false);
+        g->removeData(name);
         deleted = true;
     }
 
@@ -91,6 +91,7 @@ bool SourceHDF5::deleteSource(const string &name_or_id) {
             for(auto &child : source.sources()) {
                 source.deleteSource(child.id());
             }
+            dropPendingUpdates(g->openGroup(source.name(), false));
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
         }
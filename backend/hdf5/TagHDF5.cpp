@@ -101,6 +101,11 @@ void TagHDF5::extent(const none_t t) {
 // Other methods and functions
 
 
+ReferenceIndex::Referrer TagHDF5::indexReferrer() const {
+    return ReferenceIndex::tag(name());
+}
+
+
 TagHDF5::~TagHDF5()
 {
 }
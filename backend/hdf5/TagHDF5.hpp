@@ -79,6 +79,10 @@ public:
      */
     virtual ~TagHDF5();
 
+protected:
+
+    ReferenceIndex::Referrer indexReferrer() const;
+
 };
 
 
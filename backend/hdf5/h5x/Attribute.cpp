@@ -10,6 +10,7 @@
 
 #include "Attribute.hpp"
 #include "H5DataType.hpp"
+#include "IOCounters.hpp"
 
 namespace nix {
 namespace hdf5 {
@@ -26,11 +27,17 @@ Attribute::Attribute(const Attribute &other) : H5Object(other) {
 
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, void *data) {
+    H5Lock lock;
+    IOScope scope(hid, IOCall::AttrRead);
     HErr status = H5Aread(hid, mem_type.h5id(), data);
     status.check("Attribute::read(): Could not read data");
+    if (scope) {
+        scope->read(selectionBytes(mem_type.h5id(), getSpace().h5id()));
+    }
 }
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *data) {
+    H5Lock lock;
     StringWriter writer(size, data);
     read(mem_type, size, *writer);
     writer.finish();
@@ -42,8 +49,13 @@ void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *da
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const void *data) {
+    H5Lock lock;
+    IOScope scope(hid, IOCall::AttrWrite);
     HErr status = H5Awrite(hid, mem_type.h5id(), data);
     status.check("Attribute::write(): Could not write data");
+    if (scope) {
+        scope->written(selectionBytes(mem_type.h5id(), getSpace().h5id()));
+    }
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const std::string *data) {
@@ -53,6 +65,7 @@ void Attribute::write(h5x::DataType mem_type, const NDSize &size, const std::str
 
 
 DataSpace Attribute::getSpace() const {
+    H5Lock lock;
 
     DataSpace space = H5Aget_space(hid);
     space.check("Attribute::getSpace(): Dould not get data space");
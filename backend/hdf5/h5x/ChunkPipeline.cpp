@@ -0,0 +1,518 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "ChunkPipeline.hpp"
+#include "H5Exception.hpp"
+#include "IOCounters.hpp"
+
+#include <nix/Exception.hpp>
+#include <nix/util/trace.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+struct RawChunk {
+    // the position of the chunk, in elements
+    std::vector<hsize_t> offset;
+    // the stored bytes, empty if the chunk was never written
+    std::vector<unsigned char> data;
+    uint32_t filter_mask;
+};
+
+
+/**
+ * @brief The chunks of a data set that a region touches and how to copy
+ *        the part of a chunk inside the region into the buffer.
+ */
+class ChunkRegion {
+public:
+
+    ChunkRegion(const NDSize &count, const NDSize &offset, const std::vector<hsize_t> &chunk, size_t esize)
+        : count(count), offset(offset), chunk(chunk), esize(esize), first(chunk.size()), grid(chunk.size()) {
+        for (size_t d = 0; d < chunk.size(); d++) {
+            first[d] = offset[d] / chunk[d];
+            grid[d] = (offset[d] + count[d] - 1) / chunk[d] - first[d] + 1;
+        }
+    }
+
+    hsize_t chunkCount() const {
+        hsize_t n = 1;
+        for (hsize_t g : grid) {
+            n *= g;
+        }
+        return n;
+    }
+
+    size_t chunkBytes() const {
+        size_t n = esize;
+        for (hsize_t c : chunk) {
+            n *= static_cast<size_t>(c);
+        }
+        return n;
+    }
+
+    // the position of the i-th touched chunk, in row-major order
+    std::vector<hsize_t> chunkOffset(hsize_t index) const {
+        std::vector<hsize_t> position(chunk.size());
+        for (size_t d = chunk.size(); d-- > 0;) {
+            position[d] = (first[d] + index % grid[d]) * chunk[d];
+            index /= grid[d];
+        }
+        return position;
+    }
+
+    // copy the part of a decoded chunk inside the region into the buffer
+    void scatter(const std::vector<hsize_t> &position, const unsigned char *plain, unsigned char *buffer) const {
+        forEachRow(position, [&](size_t src, size_t dst, size_t row) {
+            std::memcpy(buffer + dst * esize, plain + src * esize, row);
+        });
+    }
+
+    // copy the part of the buffer inside a chunk into the chunk, which
+    // must already hold the fill value where the region does not cover it
+    void gather(const std::vector<hsize_t> &position, const unsigned char *buffer, unsigned char *plain) const {
+        forEachRow(position, [&](size_t src, size_t dst, size_t row) {
+            std::memcpy(plain + src * esize, buffer + dst * esize, row);
+        });
+    }
+
+    // whether the region covers the chunk at position completely
+    bool covers(const std::vector<hsize_t> &position) const {
+        for (size_t d = 0; d < chunk.size(); d++) {
+            if (position[d] < offset[d] || position[d] + chunk[d] > offset[d] + count[d]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    // call f(chunk index, buffer index, row bytes) for each row of the
+    // intersection of the chunk at position with the region
+    template<typename F>
+    void forEachRow(const std::vector<hsize_t> &position, F f) const {
+        const size_t rank = chunk.size();
+        std::vector<hsize_t> lo(rank), hi(rank);
+        for (size_t d = 0; d < rank; d++) {
+            lo[d] = std::max<hsize_t>(position[d], offset[d]);
+            hi[d] = std::min<hsize_t>(position[d] + chunk[d], offset[d] + count[d]);
+        }
+
+        const size_t row = static_cast<size_t>(hi[rank - 1] - lo[rank - 1]) * esize;
+        std::vector<hsize_t> index(lo);
+        for (;;) {
+            size_t src = 0, dst = 0;
+            for (size_t d = 0; d < rank; d++) {
+                src = src * static_cast<size_t>(chunk[d]) + static_cast<size_t>(index[d] - position[d]);
+                dst = dst * static_cast<size_t>(count[d]) + static_cast<size_t>(index[d] - offset[d]);
+            }
+            f(src, dst, row);
+
+            // next row: increment the index over all but the last dimension
+            size_t d = rank - 1;
+            while (d-- > 0) {
+                if (++index[d] < hi[d]) {
+                    break;
+                }
+                index[d] = lo[d];
+            }
+            if (d == static_cast<size_t>(-1)) {
+                return;
+            }
+        }
+    }
+
+    NDSize count;
+    NDSize offset;
+    std::vector<hsize_t> chunk;
+    size_t esize;
+    std::vector<hsize_t> first;
+    std::vector<hsize_t> grid;
+};
+
+
+#if H5_VERSION_GE(1, 10, 2)
+
+/**
+ * @brief Get the chunk shape, the fill value and the deflate level of a
+ *        data set whose chunks can be coded outside of hdf5.
+ *
+ * @return False if the data set is not chunked, has other filters than
+ *         deflate or needs a conversion from or to memType.
+ */
+bool deflateLayout(const DataSet &ds, const h5x::DataType &memType, std::vector<hsize_t> &chunk,
+                   std::vector<unsigned char> &fill, int &level) {
+    const int rank = static_cast<int>(chunk.size());
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(ds.h5id());
+    dcpl.check("deflateLayout: H5Dget_create_plist failed");
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED || H5Pget_chunk(dcpl.h5id(), rank, chunk.data()) != rank) {
+        return false;
+    }
+
+    unsigned flags, config, values[1] = {0};
+    size_t nvalues = 1;
+    if (H5Pget_nfilters(dcpl.h5id()) != 1 ||
+        H5Pget_filter2(dcpl.h5id(), 0, &flags, &nvalues, values, 0, nullptr, &config) != H5Z_FILTER_DEFLATE) {
+        return false;
+    }
+    level = nvalues > 0 ? static_cast<int>(values[0]) : Z_DEFAULT_COMPRESSION;
+
+    h5x::DataType fileType = ds.dataType();
+    if (memType.isVariableString() || H5Tequal(fileType.h5id(), memType.h5id()) <= 0) {
+        return false;
+    }
+    fill.resize(fileType.size());
+    HErr res = H5Pget_fill_value(dcpl.h5id(), fileType.h5id(), fill.data());
+    res.check("deflateLayout: could not get the fill value");
+    return true;
+}
+
+
+std::vector<unsigned char> fillChunk(const std::vector<unsigned char> &fill, size_t chunk_bytes) {
+    std::vector<unsigned char> chunk(chunk_bytes);
+    for (size_t i = 0; i < chunk_bytes; i += fill.size()) {
+        std::memcpy(&chunk[i], fill.data(), fill.size());
+    }
+    return chunk;
+}
+
+#endif
+
+} // anonymous namespace
+
+
+bool readChunksParallel(const DataSet &ds, void *data, const h5x::DataType &memType,
+                        const NDSize &count, const NDSize &offset, size_t threads) {
+#if !H5_VERSION_GE(1, 10, 5)
+    return false;
+#else
+    const size_t rank = count.size();
+    if (threads < 2 || rank == 0 || offset.size() != rank || count.nelms() == 0) {
+        return false;
+    }
+
+    // chunks beyond the extent would be read as the fill value
+    const NDSize extent = ds.size();
+    if (extent.size() != rank) {
+        return false;
+    }
+    for (size_t d = 0; d < rank; d++) {
+        if (offset[d] > extent[d] || count[d] > extent[d] - offset[d]) {
+            throw OutOfBounds("readChunksParallel: region exceeds the data set", offset[d] + count[d]);
+        }
+    }
+
+    std::vector<hsize_t> chunk(rank);
+    std::vector<unsigned char> fill;
+    int level;
+    if (!deflateLayout(ds, memType, chunk, fill, level)) {
+        return false;
+    }
+
+    const ChunkRegion region(count, offset, chunk, fill.size());
+    const hsize_t n = region.chunkCount();
+    if (n < 2) {
+        return false;
+    }
+    // counted like the H5Dread it replaces
+    IOScope scope(ds.h5id(), IOCall::DataRead);
+    util::TraceSpan span("H5Dread_chunk", "h5x");
+
+    const size_t chunk_bytes = region.chunkBytes();
+    const std::vector<unsigned char> fill_chunk = fillChunk(fill, chunk_bytes);
+
+    const size_t workers_count = static_cast<size_t>(std::min<hsize_t>(threads, n));
+    const size_t max_in_flight = 2 * workers_count + 2;
+    unsigned char *buffer = static_cast<unsigned char *>(data);
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<RawChunk> queue;
+    size_t in_flight = 0;
+    bool read_done = false;
+    std::exception_ptr error;
+
+    auto fail = [&](std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!error) {
+            error = e;
+        }
+        cv.notify_all();
+    };
+
+    // the workers inflate chunks and copy them into the buffer; the parts
+    // of the buffer written by different chunks do not overlap
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < workers_count; t++) {
+        workers.emplace_back([&] {
+            std::vector<unsigned char> plain(chunk_bytes);
+            for (;;) {
+                RawChunk raw;
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait(lock, [&] { return !queue.empty() || read_done || error; });
+                    if (error || queue.empty()) {
+                        return;
+                    }
+                    raw = std::move(queue.front());
+                    queue.pop_front();
+                }
+
+                try {
+                    const unsigned char *decoded = plain.data();
+                    if (raw.data.empty()) {
+                        decoded = fill_chunk.data();
+                    } else if (raw.filter_mask & 1) {
+                        // stored without the (optional) deflate filter
+                        if (raw.data.size() != chunk_bytes) {
+                            throw H5Exception("readChunksParallel: unfiltered chunk has the wrong size");
+                        }
+                        decoded = raw.data.data();
+                    } else {
+                        uLongf len = static_cast<uLongf>(chunk_bytes);
+                        int res = uncompress(plain.data(), &len, raw.data.data(), static_cast<uLong>(raw.data.size()));
+                        if (res != Z_OK || len != chunk_bytes) {
+                            throw H5Exception("readChunksParallel: could not inflate chunk");
+                        }
+                    }
+                    region.scatter(raw.offset, decoded, buffer);
+                } catch (...) {
+                    fail(std::current_exception());
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(mtx);
+                in_flight--;
+                cv.notify_all();
+            }
+        });
+    }
+
+    // the calling thread reads the stored chunks, at most a few per worker ahead
+    try {
+        for (hsize_t i = 0; i < n; i++) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&] { return in_flight < max_in_flight || error; });
+                if (error) {
+                    break;
+                }
+                in_flight++;
+            }
+
+            RawChunk raw;
+            raw.offset = region.chunkOffset(i);
+            raw.filter_mask = 0;
+            {
+                H5Lock lock;
+                haddr_t address;
+                hsize_t stored = 0;
+                HErr res = H5Dget_chunk_info_by_coord(ds.h5id(), raw.offset.data(), &raw.filter_mask,
+                                                      &address, &stored);
+                res.check("readChunksParallel: H5Dget_chunk_info_by_coord failed");
+                if (address != HADDR_UNDEF && stored > 0) {
+                    raw.data.resize(static_cast<size_t>(stored));
+                    res = H5Dread_chunk(ds.h5id(), H5P_DEFAULT, raw.offset.data(), &raw.filter_mask, raw.data.data());
+                    res.check("readChunksParallel: H5Dread_chunk failed");
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mtx);
+            queue.push_back(std::move(raw));
+            cv.notify_all();
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        read_done = true;
+        cv.notify_all();
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (scope) {
+        scope->read(count.nelms() * memType.size());
+    }
+    return true;
+#endif
+}
+
+bool writeChunksParallel(const DataSet &ds, const void *data, const h5x::DataType &memType,
+                         const NDSize &count, const NDSize &offset, size_t threads) {
+#if !H5_VERSION_GE(1, 10, 2)
+    return false;
+#else
+    const size_t rank = count.size();
+    if (threads < 2 || rank == 0 || offset.size() != rank || count.nelms() == 0) {
+        return false;
+    }
+
+    std::vector<hsize_t> chunk(rank);
+    std::vector<unsigned char> fill;
+    int level;
+    if (!deflateLayout(ds, memType, chunk, fill, level)) {
+        return false;
+    }
+
+    // only whole chunks are written, and chunks at the end of the data
+    // whose part beyond the extent holds the fill value
+    const NDSize extent = ds.size();
+    for (size_t d = 0; d < rank; d++) {
+        if (offset[d] + count[d] > extent[d] || offset[d] % chunk[d] != 0 ||
+            (count[d] % chunk[d] != 0 && offset[d] + count[d] != extent[d])) {
+            return false;
+        }
+    }
+
+    const ChunkRegion region(count, offset, chunk, fill.size());
+    const hsize_t n = region.chunkCount();
+    if (n < 2) {
+        return false;
+    }
+    // counted like the H5Dwrite it replaces
+    IOScope scope(ds.h5id(), IOCall::DataWrite);
+    util::TraceSpan span("H5Dwrite_chunk", "h5x");
+
+    const size_t chunk_bytes = region.chunkBytes();
+    const std::vector<unsigned char> fill_chunk = fillChunk(fill, chunk_bytes);
+
+    const size_t workers_count = static_cast<size_t>(std::min<hsize_t>(threads, n));
+    const size_t max_in_flight = 2 * workers_count + 2;
+    const unsigned char *buffer = static_cast<const unsigned char *>(data);
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<RawChunk> queue;
+    hsize_t next = 0;
+    size_t in_flight = 0;
+    std::exception_ptr error;
+
+    auto fail = [&](std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!error) {
+            error = e;
+        }
+        cv.notify_all();
+    };
+
+    // the workers copy chunks out of the buffer and deflate them
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < workers_count; t++) {
+        workers.emplace_back([&] {
+            std::vector<unsigned char> plain(chunk_bytes);
+            for (;;) {
+                hsize_t index;
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait(lock, [&] { return in_flight < max_in_flight || next == n || error; });
+                    if (error || next == n) {
+                        return;
+                    }
+                    index = next++;
+                    in_flight++;
+                }
+
+                RawChunk raw;
+                try {
+                    raw.offset = region.chunkOffset(index);
+                    if (!region.covers(raw.offset)) {
+                        plain = fill_chunk;
+                    }
+                    region.gather(raw.offset, buffer, plain.data());
+
+                    uLongf len = compressBound(static_cast<uLong>(chunk_bytes));
+                    raw.data.resize(static_cast<size_t>(len));
+                    int res = compress2(raw.data.data(), &len, plain.data(), static_cast<uLong>(chunk_bytes), level);
+                    if (res != Z_OK) {
+                        throw H5Exception("writeChunksParallel: could not deflate chunk");
+                    }
+
+                    if (len < chunk_bytes) {
+                        raw.data.resize(static_cast<size_t>(len));
+                        raw.filter_mask = 0;
+                    } else {
+                        // like hdf5, keep chunks that do not shrink without the optional filter
+                        raw.data.assign(plain.begin(), plain.end());
+                        raw.filter_mask = 1;
+                    }
+                } catch (...) {
+                    fail(std::current_exception());
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(mtx);
+                queue.push_back(std::move(raw));
+                cv.notify_all();
+            }
+        });
+    }
+
+    // the calling thread writes the deflated chunks in the order they are done
+    try {
+        for (hsize_t i = 0; i < n; i++) {
+            RawChunk raw;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&] { return !queue.empty() || error; });
+                if (error) {
+                    break;
+                }
+                raw = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            {
+                H5Lock lock;
+                HErr res = H5Dwrite_chunk(ds.h5id(), H5P_DEFAULT, raw.filter_mask, raw.offset.data(),
+                                          raw.data.size(), raw.data.data());
+                res.check("writeChunksParallel: H5Dwrite_chunk failed");
+            }
+
+            std::lock_guard<std::mutex> lock(mtx);
+            in_flight--;
+            cv.notify_all();
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (scope) {
+        scope->written(count.nelms() * memType.size());
+    }
+    return true;
+#endif
+}
+
+} // namespace hdf5
+} // namespace nix
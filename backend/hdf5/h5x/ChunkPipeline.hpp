@@ -0,0 +1,63 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CHUNK_PIPELINE_H5_H
+#define NIX_CHUNK_PIPELINE_H5_H
+
+#include "H5DataSet.hpp"
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Read a region of a deflate compressed data set with the
+ *        decompression spread over several threads.
+ *
+ * The calling thread reads the compressed chunks of the region with
+ * H5Dread_chunk, one after the other under the hdf5 lock, while the
+ * worker threads inflate them and copy their part of the region into
+ * the buffer. Chunks that were never written yield the fill value.
+ *
+ * This needs hdf5 1.10.5 or later. Only data sets whose sole filter is
+ * deflate are read this way, only if the memory type is the file type,
+ * so that no conversion is needed, and only if the region touches more
+ * than one chunk. Everything else is left to H5Dread.
+ *
+ * @return False if the data set or region is not suited, in which case
+ *         nothing was read.
+ *
+ * @throws OutOfBounds If the region exceeds the extent of the data set.
+ */
+bool readChunksParallel(const DataSet &ds, void *data, const h5x::DataType &memType,
+                        const NDSize &count, const NDSize &offset, size_t threads);
+
+/**
+ * @brief Write a chunk aligned region of a deflate compressed data set
+ *        with the compression spread over several threads.
+ *
+ * The worker threads copy the chunks of the region out of the buffer
+ * and deflate them, while the calling thread stores the compressed
+ * chunks with H5Dwrite_chunk. The chunks are coded exactly like the
+ * deflate filter of the data set codes them, so any reader decodes them.
+ *
+ * This needs hdf5 1.10.2 or later and the same kind of data set and
+ * memory type as {@link readChunksParallel}. The region has to start at
+ * a chunk boundary and consist of whole chunks, except at the end of the
+ * data set, where the part of a chunk beyond the extent gets the fill
+ * value. Everything else is left to H5Dwrite.
+ *
+ * @return False if the data set or region is not suited, in which case
+ *         nothing was written.
+ */
+bool writeChunksParallel(const DataSet &ds, const void *data, const h5x::DataType &memType,
+                         const NDSize &count, const NDSize &offset, size_t threads);
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_CHUNK_PIPELINE_H5_H
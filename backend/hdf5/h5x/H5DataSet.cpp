@@ -8,6 +8,7 @@
 
 #include "H5DataSet.hpp"
 #include "H5Exception.hpp"
+#include "IOCounters.hpp"
 
 #include <iostream>
 #include <cmath>
@@ -25,16 +26,41 @@ DataSet::DataSet(const DataSet &other)
 
 }
 
+namespace {
+
+// bytes in memory of a transfer between memSpace & fileSpace
+uint64_t transferBytes(hid_t ds, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace) {
+    if (memSpace.h5id() != H5S_ALL) {
+        return selectionBytes(memType.h5id(), memSpace.h5id());
+    } else if (fileSpace.h5id() != H5S_ALL) {
+        return selectionBytes(memType.h5id(), fileSpace.h5id());
+    }
+    DataSpace space = H5Dget_space(ds);
+    return selectionBytes(memType.h5id(), space.h5id());
+}
+
+} // anonymous namespace
+
 void DataSet::read(void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace) const
 {
+    H5Lock lock;
+    IOScope scope(hid, IOCall::DataRead);
     HErr res = H5Dread(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::read() IO error");
+    if (scope) {
+        scope->read(transferBytes(hid, memType, memSpace, fileSpace));
+    }
 }
 
 void DataSet::write(const void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace)
 {
+    H5Lock lock;
+    IOScope scope(hid, IOCall::DataWrite);
     HErr res = H5Dwrite(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::write() IOError");
+    if (scope) {
+        scope->written(transferBytes(hid, memType, memSpace, fileSpace));
+    }
 }
 
 void DataSet::read(void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset) const
@@ -153,6 +179,7 @@ NDSize DataSet::guessChunking(NDSize chunks, size_t element_size)
 
 void DataSet::setExtent(const NDSize &dims)
 {
+    H5Lock lock;
     DataSpace space = getSpace();
 
     if (space.extent().size() != dims.size()) {
@@ -170,8 +197,30 @@ NDSize DataSet::size() const
     return getSpace().extent();
 }
 
+
+NDSize DataSet::chunking() const
+{
+    H5Lock lock;
+    hid_t dcpl = H5Dget_create_plist(hid);
+    if (dcpl < 0) {
+        throw H5Exception("DataSet::chunking(): H5Dget_create_plist failed");
+    }
+
+    NDSize chunks;
+    if (H5Pget_layout(dcpl) == H5D_CHUNKED) {
+        int rank = H5Pget_chunk(dcpl, 0, nullptr);
+        if (rank > 0) {
+            chunks = NDSize(static_cast<size_t>(rank));
+            H5Pget_chunk(dcpl, rank, chunks.data());
+        }
+    }
+    H5Pclose(dcpl);
+    return chunks;
+}
+
 void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace) const
 {
+    H5Lock lock;
     HErr res;
     if (dspace != nullptr) {
         res = H5Dvlen_reclaim(mem_type.h5id(), dspace->h5id(), H5P_DEFAULT, data);
@@ -186,12 +235,14 @@ void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace)
 
 h5x::DataType DataSet::dataType(void) const
 {
+    H5Lock lock;
     h5x::DataType ftype = H5Dget_type(hid);
     ftype.check("DataSet::dataType(): H5Dget_type failed");
     return ftype;
 }
 
 DataSpace DataSet::getSpace() const {
+    H5Lock lock;
     DataSpace space = H5Dget_space(hid);
     space.check("DataSet::getSpace(): Could not obtain dataspace");
     return space;
@@ -50,13 +50,17 @@ public:
     void setExtent(const NDSize &dims);
     NDSize size() const;
 
+    /**
+     * @brief The chunk shape of the data set, empty unless it is chunked.
+     */
+    NDSize chunking() const;
+
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
     h5x::DataType dataType(void) const;
 
     DataSpace getSpace() const;
 
-private:
     std::tuple<DataSpace, DataSpace> offsetCount2DataSpaces(const NDSize &count, const NDSize &offset) const;
 };
 
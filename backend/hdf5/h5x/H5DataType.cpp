@@ -18,18 +18,21 @@ namespace h5x {
 
 
 DataType DataType::copy(hid_t source) {
+    H5Lock lock;
     DataType hi_copy = H5Tcopy(source);
     hi_copy.check("Could not copy type");
     return hi_copy;
 }
 
 DataType DataType::make(H5T_class_t klass, size_t size) {
+    H5Lock lock;
     DataType dt = H5Tcreate(klass, size);
     dt.check("Could not create datatype");
     return dt;
 }
 
 DataType DataType::makeStrType(size_t size) {
+    H5Lock lock;
     DataType str_type = H5Tcopy(H5T_C_S1);
     str_type.check("Could not create string type");
     str_type.size(size);
@@ -37,41 +40,49 @@ DataType DataType::makeStrType(size_t size) {
 }
 
 DataType DataType::makeCompound(size_t size) {
+    H5Lock lock;
     DataType res = H5Tcreate(H5T_COMPOUND, size);
     res.check("Could not create compound type");
     return res;
 }
 
 DataType DataType::makeEnum(const DataType &base) {
+    H5Lock lock;
     DataType res = H5Tenum_create(base.h5id());
     res.check("Could not create enum type");
     return res;
 }
 
 H5T_class_t DataType::class_t() const {
+    H5Lock lock;
     return H5Tget_class(hid);
 }
 
 void DataType::size(size_t t) {
+    H5Lock lock;
     HErr res = H5Tset_size(hid, t);
     res.check("DataType::size: Could not set size");
 }
 
 size_t DataType::size() const {
+    H5Lock lock;
     return H5Tget_size(hid); //FIXME: throw on 0?
 }
 
 void DataType::sign(H5T_sign_t sign) {
+    H5Lock lock;
     HErr res = H5Tset_sign(hid, sign);
     res.check("DataType::sign(): H5Tset_sign failed");
 }
 
 H5T_sign_t DataType::sign() const {
+    H5Lock lock;
     H5T_sign_t res = H5Tget_sign(hid);
     return res;
 }
 
 bool DataType::isVariableString() const {
+    H5Lock lock;
     HTri res = H5Tis_variable_str(hid);
     res.check("DataType::isVariableString(): H5Tis_variable_str failed");
     return res.result();
@@ -82,6 +93,7 @@ bool DataType::isCompound() const {
 }
 
 unsigned int DataType::member_count() const {
+    H5Lock lock;
     int res = H5Tget_nmembers(hid);
     if (res < 0) {
         throw H5Exception("DataType::member_count(): H5Tget_nmembers faild");
@@ -90,10 +102,12 @@ unsigned int DataType::member_count() const {
 }
 
 H5T_class_t DataType::member_class(unsigned int index) const {
+    H5Lock lock;
     return H5Tget_member_class(hid, index);
 }
 
 std::string DataType::member_name(unsigned int index) const {
+    H5Lock lock;
     char *data = H5Tget_member_name(hid, index);
     std::string res(data);
     std::free(data);
@@ -112,10 +126,12 @@ std::vector<std::string> DataType::member_names() const {
 }
 
 size_t DataType::member_offset(unsigned int index) const {
+    H5Lock lock;
     return H5Tget_member_offset(hid, index);
 }
 
 DataType DataType::member_type(unsigned int index) const {
+    H5Lock lock;
     h5x::DataType res = H5Tget_member_type(hid, index);
     res.check("DataType::member_type(): H5Tget_member_type failed");
     return res;
@@ -123,16 +139,19 @@ DataType DataType::member_type(unsigned int index) const {
 
 
 void DataType::insert(const std::string &name, size_t offset, const DataType &dtype) {
+    H5Lock lock;
     HErr res = H5Tinsert(hid, name.c_str(), offset, dtype.hid);
     res.check("DataType::insert(): H5Tinsert failed.");
 }
 
 void DataType::insert(const std::string &name, void *value) {
+    H5Lock lock;
     HErr res = H5Tenum_insert(hid, name.c_str(), value);
     res.check("DataType::insert(): H5Tenum_insert failed.");
 }
 
 void DataType::enum_valueof(const std::string &name, void *value) {
+    H5Lock lock;
     HErr res = H5Tenum_valueof(hid, name.c_str(), value);
     res.check("DataType::enum_valueof(): H5Tenum_valueof failed");
 }
@@ -174,6 +193,7 @@ h5x::DataType make_file_booltype() {
 }
 
 h5x::DataType make_mem_booltype() {
+    H5Lock lock;
     h5x::DataType booltype = h5x::DataType::make(H5T_ENUM, sizeof(bool));
     booltype.insert("FALSE", false);
     booltype.insert("TRUE", true);
@@ -340,9 +360,9 @@ DataType data_type_from_h5(const h5x::DataType &dtype) {
 
     if (ftclass == H5T_COMPOUND) {
         //if it is a compound data type then it must be a
-        //a property dataset, we can handle that
+        //a property dataset (full or with uncertainties), we can handle that
         int nmems = dtype.member_count();
-        assert(nmems == 6);
+        assert(nmems == 6 || nmems == 2);
         h5x::DataType vtype = dtype.member_type(0);
 
         ftclass = vtype.class_t();
@@ -9,6 +9,7 @@
 #include "H5Group.hpp"
 #include <nix/util/util.hpp>
 #include "H5Exception.hpp"
+#include "IOCounters.hpp"
 
 
 namespace nix {
@@ -19,6 +20,7 @@ optGroup::optGroup(const H5Group &parent, const std::string &g_name)
 {}
 
 boost::optional<H5Group> optGroup::operator() (bool create) const {
+    H5Lock lock;
     if (parent.hasGroup(g_name)) {
         g = boost::optional<H5Group>(parent.openGroup(g_name));
     } else if (create) {
@@ -38,6 +40,8 @@ H5Group::H5Group(const H5Group &other) : LocID(other) {}
 
 
 bool H5Group::hasObject(const std::string &name) const {
+    H5Lock lock;
+    IOScope scope(hid, IOCall::HasObject);
     // empty string should return false, not exception (which H5Lexists would)
     if (name.empty()) {
         return false;
@@ -48,6 +52,7 @@ bool H5Group::hasObject(const std::string &name) const {
 }
 
 bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
+    H5Lock lock;
     H5O_info_t info;
 
     hid_t obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
@@ -66,6 +71,7 @@ bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
 }
 
 ndsize_t H5Group::objectCount() const {
+    H5Lock lock;
     hsize_t n_objs;
     HErr res = H5Gget_num_objs(hid, &n_objs);
     res.check("Could not get object count");
@@ -124,6 +130,8 @@ boost::optional<DataSet> H5Group::findDataByAttribute(const std::string &attribu
 
 
 std::string H5Group::objectName(ndsize_t index) const {
+    H5Lock lock;
+    IOScope scope(hid, IOCall::ObjectName);
     // check if index valid
     if(index > objectCount()) {
         throw OutOfBounds("No object at given index",
@@ -179,7 +187,12 @@ bool H5Group::hasData(const std::string &name) const {
 }
 
 
+// small enough for the object header, which is limited to 64 KiB, to stay small
+const size_t H5Group::compactLimit = 1024;
+
+
 void H5Group::removeData(const std::string &name) {
+    H5Lock lock;
     if (hasData(name)) {
         HErr res = H5Gunlink(hid, name.c_str());
         res.check("H5Group::removeData(): Could not unlink DataSet");
@@ -187,6 +200,35 @@ void H5Group::removeData(const std::string &name) {
 }
 
 
+DataSet H5Group::prepareData(const std::string &name, const h5x::DataType &fileType, const NDSize &shape) {
+    H5Lock lock;
+    h5x::DataType type = fileType;
+    if (hasData(name)) {
+        DataSet ds = openData(name);
+        if (ds.chunking()) {
+            ds.setExtent(shape);
+            return ds;
+        }
+        if (ds.size() == shape) {
+            return ds;
+        }
+        type = ds.dataType();
+        removeData(name);
+    }
+
+    const ndsize_t elements = shape.size() > 0 ? shape.nelms() : 0;
+    if (elements == 0 || elements * type.size() > compactLimit) {
+        return createData(name, type, shape);
+    }
+
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("Could not create data creation plist");
+    HErr res = H5Pset_layout(dcpl.h5id(), H5D_COMPACT);
+    res.check("Could not set compact layout on data set creation plist");
+    return createData(name, type, DataSpace::create(shape, false), dcpl);
+}
+
+
 DataSet H5Group::createData(const std::string &name,
                             const h5x::DataType &fileType,
                             const NDSize &size,
@@ -195,6 +237,7 @@ DataSet H5Group::createData(const std::string &name,
                             bool max_size_unlimited,
                             bool guess_chunks) const
 {
+    H5Lock lock;
     DataSpace space;
 
     if (size) {
@@ -218,16 +261,35 @@ DataSet H5Group::createData(const std::string &name,
         res.check("Could not set chunk size on data set creation plist");
     }
 
+    return createData(name, fileType, space, dcpl);
+}
+
+
+DataSet H5Group::createData(const std::string &name,
+                            const h5x::DataType &fileType,
+                            const DataSpace &space,
+                            const H5Object &dcpl) const
+{
+    H5Lock lock;
+    util::TraceSpan span("H5Dcreate", "h5x");
     DataSet ds = H5Dcreate(hid, name.c_str(), fileType.h5id(), space.h5id(), H5P_DEFAULT, dcpl.h5id(), H5P_DEFAULT);
     ds.check("H5Group::createData: Could not create DataSet with name " + name);
+    if (IOCounters *counters = IOCounters::find(hid)) {
+        counters->openedDataSet();
+    }
 
     return ds;
 }
 
 
 DataSet H5Group::openData(const std::string &name) const {
+    H5Lock lock;
+    util::TraceSpan span("H5Dopen", "h5x");
     DataSet ds = H5Dopen(hid, name.c_str(), H5P_DEFAULT);
     ds.check("H5Group::openData(): Could not open DataSet");
+    if (IOCounters *counters = IOCounters::find(hid)) {
+        counters->openedDataSet();
+    }
     return ds;
 }
 
@@ -238,6 +300,8 @@ bool H5Group::hasGroup(const std::string &name) const {
 
 
 H5Group H5Group::openGroup(const std::string &name, bool create) const {
+    H5Lock lock;
+    IOScope scope(hid, IOCall::GroupOpen);
     check_h5_arg_name(name);
 
     H5Group g;
@@ -245,18 +309,11 @@ H5Group H5Group::openGroup(const std::string &name, bool create) const {
     if (hasGroup(name)) {
         g = H5Group(H5Gopen(hid, name.c_str(), H5P_DEFAULT));
         g.check("H5Group::openGroup(): Could not open group: " + name);
+        if (scope) {
+            scope->openedGroup();
+        }
     } else if (create) {
-        H5Object gcpl = H5Pcreate(H5P_GROUP_CREATE);
-        gcpl.check("Unable to create group with name '" + name + "'! (H5Pcreate)");
-
-        //we want hdf5 to keep track of the order in which links were created so that
-        //the order for indexed based accessors is stable cf. issue #387
-        HErr res = H5Pset_link_creation_order(gcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
-        res.check("Unable to create group with name '" + name + "'! (H5Pset_link_cr...)");
-
-        g = H5Group(H5Gcreate2(hid, name.c_str(), H5P_DEFAULT, gcpl.h5id(), H5P_DEFAULT));
-        g.check("Unable to create group with name '" + name + "'! (H5Gcreate2)");
-
+        g = createGroup(name, groupCreationPList());
     } else {
         throw H5Exception("Unable to open group with name '" + name + "'!");
     }
@@ -265,6 +322,34 @@ H5Group H5Group::openGroup(const std::string &name, bool create) const {
 }
 
 
+H5Group H5Group::createGroup(const std::string &name, const H5Object &gcpl) const {
+    H5Lock lock;
+    util::TraceSpan span("H5Gcreate", "h5x");
+    check_h5_arg_name(name);
+
+    H5Group g = H5Group(H5Gcreate2(hid, name.c_str(), H5P_DEFAULT, gcpl.h5id(), H5P_DEFAULT));
+    g.check("Unable to create group with name '" + name + "'! (H5Gcreate2)");
+    if (IOCounters *counters = IOCounters::find(hid)) {
+        counters->openedGroup();
+    }
+    return g;
+}
+
+
+H5Object H5Group::groupCreationPList() {
+    H5Lock lock;
+    H5Object gcpl = H5Pcreate(H5P_GROUP_CREATE);
+    gcpl.check("Unable to create group creation plist! (H5Pcreate)");
+
+    //we want hdf5 to keep track of the order in which links were created so that
+    //the order for indexed based accessors is stable cf. issue #387
+    HErr res = H5Pset_link_creation_order(gcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+    res.check("Unable to set link creation order on group creation plist!");
+
+    return gcpl;
+}
+
+
 optGroup H5Group::openOptGroup(const std::string &name) {
     check_h5_arg_name(name);
     return optGroup(*this, name);
@@ -272,12 +357,14 @@ optGroup H5Group::openOptGroup(const std::string &name) {
 
 
 void H5Group::removeGroup(const std::string &name) {
+    H5Lock lock;
     if (hasGroup(name))
         H5Gunlink(hid, name.c_str());
 }
 
 
 void H5Group::renameGroup(const std::string &old_name, const std::string &new_name) {
+    H5Lock lock;
     check_h5_arg_name(new_name);
 
     if (hasGroup(old_name)) {
@@ -287,6 +374,7 @@ void H5Group::renameGroup(const std::string &old_name, const std::string &new_na
 
 
 H5Group H5Group::createLink(const H5Group &target, const std::string &link_name) {
+    H5Lock lock;
     check_h5_arg_name(link_name);
 
     HErr res = H5Lcreate_hard(target.hid, ".", hid, link_name.c_str(),
@@ -297,6 +385,7 @@ H5Group H5Group::createLink(const H5Group &target, const std::string &link_name)
 
 // TODO implement some kind of roll-back in order to avoid half renamed links.
 bool H5Group::renameAllLinks(const std::string &old_name, const std::string &new_name) {
+    H5Lock lock;
     check_h5_arg_name(new_name);
 
     bool renamed = false;
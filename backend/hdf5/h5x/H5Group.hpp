@@ -50,9 +50,43 @@ public:
             const NDSize &size, const NDSize &maxsize = {}, NDSize chunks = {},
             bool maxSizeUnlimited = true, bool guessChunks = true) const;
 
+    /**
+     * @brief Create a DataSet with an explicit data space and an already
+     *        prepared data set creation property list. Used when many
+     *        data sets are created in a row and the plist can be reused.
+     */
+    DataSet createData(const std::string &name, const h5x::DataType &fileType,
+            const DataSpace &space, const H5Object &dcpl) const;
+
     DataSet openData(const std::string &name) const;
     void removeData(const std::string &name);
 
+    /**
+     * @brief Open or create a data set that is written as a whole, with
+     *        the given shape.
+     *
+     * New data sets of at most {@link compactLimit} bytes are stored
+     * compact, inside their object header, so they need neither a chunk
+     * index nor a block of their own and are read along with the header.
+     * Larger ones are chunked and extendible. A compact data set that is
+     * given another shape is replaced by a new one, chunked once it
+     * outgrows the limit; the type of the old one is kept. Chunked data
+     * sets are resized in place.
+     *
+     * @param name      The name of the data set.
+     * @param fileType  The type of the data set if it is created.
+     * @param shape     The shape of the data to write.
+     *
+     * @return The data set, with the given shape.
+     */
+    DataSet prepareData(const std::string &name, const h5x::DataType &fileType, const NDSize &shape);
+
+    /**
+     * @brief The size in bytes up to which {@link prepareData} stores
+     *        data sets compact.
+     */
+    static const size_t compactLimit;
+
     template<typename T>
     void setData(const std::string &name, const T &value);
     template<typename T>
@@ -73,6 +107,25 @@ public:
      */
     H5Group openGroup(const std::string &name, bool create = true) const;
 
+    /**
+     * @brief Create a new group with the given name inside this group
+     *        using the given group creation property list. The group
+     *        must not exist yet.
+     *
+     * @param name    The name of the group to create.
+     * @param gcpl    The group creation plist, see {@link groupCreationPList}.
+     *
+     * @return The created group.
+     */
+    H5Group createGroup(const std::string &name, const H5Object &gcpl) const;
+
+    /**
+     * @brief The group creation property list used for all groups
+     *        created by {@link openGroup} (link creation order tracked
+     *        and indexed).
+     */
+    static H5Object groupCreationPList();
+
     /**
      * @brief Create an {@link optGroup} functor that can be used to
      *        open and eventually create an optional group inside this
@@ -190,14 +243,7 @@ void H5Group::setData(const std::string &name, const T &value)
     DataType dtype = hydra.element_data_type();
     NDSize shape = hydra.shape();
 
-    DataSet ds;
-    if (!hasData(name)) {
-        h5x::DataType fileType = data_type_to_h5_filetype(dtype);
-        ds = createData(name, fileType, shape);
-    } else {
-        ds = openData(name);
-        ds.setExtent(shape);
-    }
+    DataSet ds = prepareData(name, data_type_to_h5_filetype(dtype), shape);
 
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
     ds.write(hydra.data(), memType, shape);
@@ -17,6 +17,7 @@
 #include "H5Exception.hpp"
 
 #include <string>
+#include <mutex>
 #include <boost/optional.hpp>
 
 namespace nix {
@@ -91,6 +92,27 @@ private:
 };
 
 
+/**
+ * @brief Scoped lock that serializes all calls into the HDF5 library.
+ *
+ * The lock is process wide and recursive, so wrapper methods can call
+ * each other freely. Every function of the backend that calls HDF5
+ * directly must hold it for the duration of the call(s).
+ */
+class NIXAPI H5Lock {
+public:
+    H5Lock() : guard(mutex()) { }
+
+    H5Lock(const H5Lock &other) = delete;
+    H5Lock &operator=(const H5Lock &other) = delete;
+
+private:
+    static std::recursive_mutex &mutex();
+
+    std::lock_guard<std::recursive_mutex> guard;
+};
+
+
 class NIXAPI H5Object {
 
 protected:
@@ -0,0 +1,111 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "IOCounters.hpp"
+#include "H5Object.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// counters by file id; only accessed with the H5Lock held
+std::unordered_map<hid_t, std::shared_ptr<IOCounters>> &registry() {
+    static std::unordered_map<hid_t, std::shared_ptr<IOCounters>> files;
+    return files;
+}
+
+} // anonymous namespace
+
+
+std::atomic<size_t> IOCounters::attached(0);
+
+
+IOCounters::IOCounters() {
+    reset();
+}
+
+
+void IOCounters::add(IOCall call, uint64_t us) {
+    calls[static_cast<size_t>(call)]++;
+    micros[static_cast<size_t>(call)] += us;
+}
+
+
+IOStatistics IOCounters::statistics() const {
+    IOStatistics stats;
+    IOStatistics::Calls *fields[] = {&stats.data_read, &stats.data_write, &stats.group_open,
+                                     &stats.has_object, &stats.object_name,
+                                     &stats.attr_read, &stats.attr_write};
+
+    for (size_t i = 0; i < calls.size(); i++) {
+        fields[i]->count = calls[i];
+        fields[i]->micros = micros[i];
+    }
+    stats.bytes_read = bytes_read;
+    stats.bytes_written = bytes_written;
+    stats.data_sets_opened = data_sets_opened;
+    stats.groups_opened = groups_opened;
+    return stats;
+}
+
+
+void IOCounters::reset() {
+    for (size_t i = 0; i < calls.size(); i++) {
+        calls[i] = 0;
+        micros[i] = 0;
+    }
+    bytes_read = 0;
+    bytes_written = 0;
+    data_sets_opened = 0;
+    groups_opened = 0;
+}
+
+
+void IOCounters::attach(hid_t file, const std::shared_ptr<IOCounters> &counters) {
+    H5Lock lock;
+    if (registry().insert({file, counters}).second) {
+        attached++;
+    }
+}
+
+
+void IOCounters::detach(hid_t file) {
+    H5Lock lock;
+    if (registry().erase(file) > 0) {
+        attached--;
+    }
+}
+
+
+IOCounters *IOCounters::lookup(hid_t obj) {
+    H5Lock lock;
+    // the id of an open file is the same for all objects opened through it
+    hid_t file = H5Iget_file_id(obj);
+    if (file < 0) {
+        H5Eclear2(H5E_DEFAULT);
+        return nullptr;
+    }
+    H5Idec_ref(file);
+
+    auto it = registry().find(file);
+    return it == registry().end() ? nullptr : it->second.get();
+}
+
+
+uint64_t selectionBytes(hid_t mem_type, hid_t space) {
+    H5Lock lock;
+    hssize_t n = H5Sget_select_npoints(space);
+    return n > 0 ? static_cast<uint64_t>(n) * H5Tget_size(mem_type) : 0;
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,158 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_IO_COUNTERS_H5_H
+#define NIX_IO_COUNTERS_H5_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/Platform.hpp>
+#include <nix/util/trace.hpp>
+
+#include <hdf5.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief The wrapper calls counted by {@link IOCounters}.
+ */
+enum class IOCall : size_t {
+    DataRead = 0,
+    DataWrite,
+    GroupOpen,
+    HasObject,
+    ObjectName,
+    AttrRead,
+    AttrWrite,
+    Count
+};
+
+/**
+ * @brief Storage call counters of one file.
+ *
+ * Counters are attached to an open file; the wrappers look them up by
+ * the file of the object they operate on. As long as no file has
+ * counters attached the lookup is a single atomic load.
+ */
+class NIXAPI IOCounters {
+public:
+
+    IOCounters();
+
+    void add(IOCall call, uint64_t micros);
+
+    void read(uint64_t bytes) { bytes_read += bytes; }
+
+    void written(uint64_t bytes) { bytes_written += bytes; }
+
+    void openedDataSet() { data_sets_opened++; }
+
+    void openedGroup() { groups_opened++; }
+
+    IOStatistics statistics() const;
+
+    void reset();
+
+    /**
+     * @brief Start counting the calls on objects of the file.
+     */
+    static void attach(hid_t file, const std::shared_ptr<IOCounters> &counters);
+
+    /**
+     * @brief Stop counting the calls on objects of the file.
+     */
+    static void detach(hid_t file);
+
+    /**
+     * @brief The counters of the file the object belongs to, if any.
+     */
+    static IOCounters *find(hid_t obj) {
+        if (attached.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        return lookup(obj);
+    }
+
+private:
+
+    static IOCounters *lookup(hid_t obj);
+
+    static std::atomic<size_t> attached;
+
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(IOCall::Count)> calls;
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(IOCall::Count)> micros;
+    std::atomic<uint64_t> bytes_read;
+    std::atomic<uint64_t> bytes_written;
+    std::atomic<uint64_t> data_sets_opened;
+    std::atomic<uint64_t> groups_opened;
+};
+
+
+/**
+ * @brief The name of the trace span of a wrapper call.
+ */
+inline const char *traceName(IOCall call) {
+    static const char *names[] = {"H5Dread", "H5Dwrite", "H5Gopen", "H5Lexists",
+                                  "H5Lget_name_by_idx", "H5Aread", "H5Awrite"};
+    return names[static_cast<size_t>(call)];
+}
+
+/**
+ * @brief Counts and times one wrapper call, if the file of the object
+ *        has counters attached, and records it as a trace span.
+ */
+class NIXAPI IOScope {
+public:
+    typedef std::chrono::steady_clock clock_t;
+
+    IOScope(hid_t obj, IOCall call)
+        : span(traceName(call), "h5x"), counters(IOCounters::find(obj)), call(call) {
+        if (counters) {
+            start = clock_t::now();
+        }
+    }
+
+    IOScope(const IOScope &other) = delete;
+    IOScope &operator=(const IOScope &other) = delete;
+
+    explicit operator bool() const {
+        return counters != nullptr;
+    }
+
+    IOCounters *operator->() const {
+        return counters;
+    }
+
+    ~IOScope() {
+        if (counters) {
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(clock_t::now() - start).count();
+            counters->add(call, static_cast<uint64_t>(us));
+        }
+    }
+
+private:
+    util::TraceSpan span;
+    IOCounters *counters;
+    IOCall call;
+    clock_t::time_point start;
+};
+
+/**
+ * @brief The number of bytes in memory of a selection of elements.
+ */
+NIXAPI uint64_t selectionBytes(hid_t mem_type, hid_t space);
+
+} // namespace hdf5
+} // namespace nix
+
+#endif
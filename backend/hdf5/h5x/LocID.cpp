@@ -10,6 +10,9 @@
 
 #include "LocID.hpp"
 
+#include <algorithm>
+#include <exception>
+
 namespace nix {
 
 namespace hdf5 {
@@ -24,18 +27,21 @@ LocID::LocID(const LocID &other) : H5Object(other) {}
 
 
 bool LocID::hasAttr(const std::string &name) const {
+    H5Lock lock;
     HTri res = H5Aexists(hid, name.c_str());
     return res.check("LocID.hasAttr() failed");
 }
 
 
 void LocID::removeAttr(const std::string &name) const {
+    H5Lock lock;
     HErr res = H5Adelete(hid, name.c_str());
     res.check("LocID::removeAttr(): could not delete attribute");
 }
 
 
 Attribute LocID::openAttr(const std::string &name) const {
+    H5Lock lock;
     Attribute attr = H5Aopen(hid, name.c_str(), H5P_DEFAULT);
     attr.check("LocID::openAttr: Could not open attribute " + name);
     return attr;
@@ -43,24 +49,99 @@ Attribute LocID::openAttr(const std::string &name) const {
 
 
 Attribute LocID::createAttr(const std::string &name, h5x::DataType fileType, const DataSpace &fileSpace) const {
+    H5Lock lock;
     Attribute attr = H5Acreate(hid, name.c_str(), fileType.h5id(), fileSpace.h5id(), H5P_DEFAULT, H5P_DEFAULT);
     attr.check("LocID::openAttr: Could not create attribute " + name);
     return attr;
 }
 
 
+namespace {
+
+struct StringAttrsOp {
+    const std::vector<std::string> &names;
+    std::vector<boost::optional<std::string>> &values;
+    std::exception_ptr error;
+};
+
+herr_t read_string_attr(hid_t loc, const char *name, const H5A_info_t *info, void *op_data) {
+    H5Lock lock;
+    StringAttrsOp *op = static_cast<StringAttrsOp *>(op_data);
+
+    auto it = std::find(op->names.begin(), op->names.end(), name);
+    if (it == op->names.end()) {
+        return 0;
+    }
+
+    // never let an exception unwind through the HDF5 library
+    try {
+        Attribute attr = H5Aopen(loc, name, H5P_DEFAULT);
+        attr.check(std::string("LocID::getStringAttrs: Could not open attribute ") + name);
+
+        h5x::DataType file_type = H5Aget_type(attr.h5id());
+        NDSize dims = attr.extent();
+        if (file_type.class_t() != H5T_STRING || dims.nelms() != 1) {
+            return 0;
+        }
+
+        std::string value;
+        h5x::DataType mem_type = data_type_to_h5_memtype(DataType::String);
+        attr.read(mem_type, dims, &value);
+        op->values[it - op->names.begin()] = value;
+    } catch (...) {
+        op->error = std::current_exception();
+        return -1;
+    }
+
+    return 0;
+}
+
+} // anonymous namespace
+
+
+void LocID::getStringAttrs(const std::vector<std::string> &names,
+                           std::vector<boost::optional<std::string>> &values) const {
+    values.assign(names.size(), boost::none);
+
+    StringAttrsOp op = {names, values, nullptr};
+    hsize_t idx = 0;
+    HErr res = H5Aiterate2(hid, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, read_string_attr, &op);
+
+    if (op.error) {
+        std::rethrow_exception(op.error);
+    }
+
+    res.check("LocID::getStringAttrs: Could not iterate over attributes");
+}
+
+
 void LocID::deleteLink(std::string name, hid_t plist) {
+    H5Lock lock;
     HErr res = H5Ldelete(hid, name.c_str(), plist);
     res.check("LocIDL::deleteLink: Could not delete link: " + name);
 }
 
 
 unsigned int LocID::referenceCount() const {
+    H5Lock lock;
     H5O_info_t oInfo;
     HErr res = H5Oget_info(hid, &oInfo);
     res.check("LocID:referenceCount: Coud not get object info");
     return oInfo.rc;
 }
+
+
+haddr_t LocID::address() const {
+    H5Lock lock;
+    H5O_info_t oInfo;
+#if H5_VERSION_GE(1, 10, 3)
+    HErr res = H5Oget_info2(hid, &oInfo, H5O_INFO_BASIC);
+#else
+    HErr res = H5Oget_info(hid, &oInfo);
+#endif
+    res.check("LocID:address: Could not get object info");
+    return oInfo.addr;
+}
 } // nix::hdf5
 
 } // nix::
\ No newline at end of file
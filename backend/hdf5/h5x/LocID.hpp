@@ -16,6 +16,11 @@
 #include <nix/Hydra.hpp>
 #include "H5DataType.hpp"
 
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
 namespace nix {
 namespace hdf5 {
 
@@ -38,9 +43,27 @@ public:
     template <typename T>
     bool getAttr(const std::string &name, T &value) const;
 
+    /**
+     * @brief Read several string attributes with a single pass over the
+     *        attribute table of the object (H5Aiterate) instead of one
+     *        H5Aexists/H5Aopen round trip per attribute.
+     *
+     * @param names   The names of the attributes to read.
+     * @param values  Receives the values, in the order of names; entries
+     *                for attributes that do not exist are left unset.
+     */
+    void getStringAttrs(const std::vector<std::string> &names,
+                        std::vector<boost::optional<std::string>> &values) const;
+
     void deleteLink(std::string name, hid_t plist = H5L_SAME_LOC);
 
     unsigned int referenceCount() const;
+
+    /**
+     * @brief The address of the object in the file. Unlike the hid it
+     *        is the same for all open handles of the object.
+     */
+    haddr_t address() const;
 private:
 
     Attribute openAttr(const std::string &name) const;
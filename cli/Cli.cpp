@@ -27,6 +27,8 @@ namespace po = boost::program_options;
 #include <modules/IModule.hpp>
 #include <modules/Validate.hpp>
 #include <modules/Dump.hpp>
+#include <modules/Stat.hpp>
+#include <modules/Repack.hpp>
 
 namespace cli {
 
@@ -41,7 +43,9 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
 // define all module types
 std::unordered_map<std::string, std::shared_ptr<cli::module::IModule>> modules = {
     {std::string(cli::module::Validate::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Validate())},
-    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())}
+    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())},
+    {std::string(cli::module::Stat::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Stat())},
+    {std::string(cli::module::Repack::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Repack())}
 };
 
 } // namespace cli
@@ -102,15 +106,18 @@ int main(int argc, char* argv[]) {
         auto it = cli::modules.find(name);
         if (it != cli::modules.end()) {
             (*it).second->load(desc);    
-            // process the cmd line input
+            // process the cmd line input again, now knowing the module's options
+            // (values of those were taken for input-files by the first passes)
+            vm = po::variables_map();
             po::store(parser3.options(desc).positional(pdesc).run(), vm);
             po::notify(vm);
             out << (*it).second->call(vm, desc);
         }
         else {
             out << std::endl << "Nix command line tool " <<  "\n\n";
-            out << "\tUse the modules of this tool to dump nix-file contents as yaml to std out\n";
-            out << "\tor validate the nix file to detect structural and/or logical errors.\n\n";
+            out << "\tUse the modules of this tool to dump nix-file contents as yaml to std out,\n";
+            out << "\tvalidate the nix file to detect structural and/or logical errors\n";
+            out << "\tor report its storage layout to find out why reading or writing it is slow.\n\n";
             out << "\tUsage: ./nix-tool module [--help] [[module args] input-file] \n\n";
             out << desc << std::endl;
         }
@@ -38,17 +38,28 @@ const char* yamlstream::scalar_end = "\n";
 const char* yamlstream::item_str = "- ";
 const char* plot_script::plot_file = "dump_plot.gnu";
 
+void yamlstream::put(const std::string &str) {
+    if (!str.empty()) {
+        ostream << str;
+        last = *str.rbegin();
+    }
+}
+
+bool yamlstream::selected(const std::string &type) const {
+    return types.empty() || std::find(types.begin(), types.end(), type) != types.end();
+}
+
 void yamlstream::indent_if() {
     // if endl
-    if (!strcmp(&*sstream.str().rbegin(), "\n")) {
+    if (last == '\n') {
         (*this)[level];
     }
 }
 
 void yamlstream::endl_if() {
     // if _not_ endl
-    if (strcmp(&*sstream.str().rbegin(), "\n")) {
-        sstream << "\n";
+    if (last != '\n') {
+        put("\n");
     }
 }
 
@@ -57,7 +68,7 @@ std::string yamlstream::item() {
 }
 
 yamlstream& yamlstream::operator++() {
-    sstream << sequ_start;
+    put(sequ_start);
     level++;
     return *this;
 }
@@ -68,7 +79,7 @@ yamlstream yamlstream::operator++(int) {
     return tmp;   // return value before increment
 }
 
-yamlstream yamlstream::operator--() {
+yamlstream& yamlstream::operator--() {
     endl_if();
     level--;
     return *this;
@@ -83,7 +94,7 @@ yamlstream yamlstream::operator--(int) {
 yamlstream& yamlstream::operator[](const size_t n_indent) {
     endl_if();
     for (size_t i = 0; i < n_indent; i++) {
-        sstream << indent_str;
+        put(indent_str);
     }
     return *this;
 }
@@ -109,10 +120,6 @@ std::string yamlstream::t(const time_t &tm) {
     return std::string(tbuff);
 }
 
-std::string yamlstream::str() {
-    return sstream.str();
-}
-
 yamlstream& yamlstream::operator<<(const nix::NDSize &t)
 {
     indent_if();
@@ -199,13 +206,7 @@ yamlstream& yamlstream::operator<<(const nix::Source &source) {
         << "sourceCount" << scalar_start << source.sourceCount() << scalar_end;
 
         // Sources
-        *this << "sources";
-        ++(*this);
-            auto sources = source.sources();
-            for (auto &source : sources) {
-                *this << source;            
-            }
-        --(*this);
+        children("sources", source.sourceCount(), [&source](nix::ndsize_t i) { return source.getSource(i); });
     --(*this);
     return *this;
 }
@@ -222,24 +223,13 @@ yamlstream& yamlstream::operator<<(const nix::Section &section) {
         << "sectionCount" << scalar_start << section.sectionCount() << scalar_end
         << "mapping" << scalar_start << section.mapping() << scalar_end
         << "repository" << scalar_start << section.repository() << scalar_end
-        << "link"; ++(*this) << section.link(); --(*this);
+        ;
+        child("link", [&section] { return section.link(); });
 
         // Properties
-        *this << "properties";
-        ++(*this);
-            auto properties = section.properties();
-            for (auto &property : properties) {
-                *this << property;
-            }
-        --(*this);
+        children("properties", section.propertyCount(), [&section](nix::ndsize_t i) { return section.getProperty(i); });
         // Sections
-        *this << "sections";
-        ++(*this);
-            auto sections = section.sections();
-            for (auto &section : sections) {
-                *this << section;            
-            }
-        --(*this);
+        children("sections", section.sectionCount(), [&section](nix::ndsize_t i) { return section.getSection(i); });
     --(*this);
     return *this;
 }
@@ -324,14 +314,8 @@ yamlstream& yamlstream::operator<<(const nix::DataArray &data_array) {
         << "label" << scalar_start << data_array.label() << scalar_end
         << "unit" << scalar_start << data_array.unit() << scalar_end
         << "dimensionCount" << scalar_start << data_array.dimensionCount() << scalar_end;
-        // Dimensions
-        *this << "dimensions";
-        ++(*this);
-            auto dims = data_array.dimensions();
-            for (auto &dim : dims) {
-                *this << dim;
-            }
-        --(*this);
+        // Dimensions (ids start at 1)
+        children("dimensions", data_array.dimensionCount(), [&data_array](nix::ndsize_t i) { return data_array.getDimension(i + 1); });
     --(*this);
     return *this;
 }
@@ -345,7 +329,12 @@ yamlstream& yamlstream::operator<<(const nix::Feature &feature) {
     ++(*this)
         << static_cast<nix::base::Entity<nix::base::IFeature>>(feature)
         << "linkType" << scalar_start << feature.linkType() << scalar_end
-        << "data" << sequ_start << feature.data();
+        << "data" << sequ_start;
+        if (depth < max_depth) {
+            depth++;
+            *this << feature.data();
+            depth--;
+        }
     --(*this);
     return *this;
 }
@@ -364,21 +353,9 @@ yamlstream& yamlstream::operator<<(const nix::Tag &tag) {
         << "extent" << scalar_start << tag.extent() << scalar_end
         << "position" << scalar_start << tag.position() << scalar_end;
         // References
-        *this << "references";
-        ++(*this);
-            auto refs = tag.references();
-            for (auto &ref : refs) {
-                *this << ref;
-            }
-        --(*this);
+        children("references", tag.referenceCount(), [&tag](nix::ndsize_t i) { return tag.getReference(static_cast<size_t>(i)); });
         // Features
-        *this << "features";
-        ++(*this);
-            auto features = tag.features();
-            for (auto &feature : features) {
-                *this << feature;
-            }
-        --(*this);
+        children("features", tag.featureCount(), [&tag](nix::ndsize_t i) { return tag.getFeature(i); });
     --(*this);
     return *this;
 }
@@ -394,24 +371,13 @@ yamlstream& yamlstream::operator<<(const nix::MultiTag &multi_tag) {
         << "units" << scalar_start << multi_tag.units() << scalar_end
         << "featureCount" << scalar_start << multi_tag.featureCount() << scalar_end
         << "referenceCount" << scalar_start << multi_tag.referenceCount() << scalar_end
-        << "extents"; ++(*this) << multi_tag.extents(); --(*this)
-        << "positions"; ++(*this) << multi_tag.positions(); --(*this);
+        ;
+        child("extents", [&multi_tag] { return multi_tag.extents(); });
+        child("positions", [&multi_tag] { return multi_tag.positions(); });
         // References
-        *this << "references";
-        ++(*this);
-            auto refs = multi_tag.references();
-            for (auto &ref : refs) {
-                *this << ref;
-            }
-        --(*this);
+        children("references", multi_tag.referenceCount(), [&multi_tag](nix::ndsize_t i) { return multi_tag.getReference(static_cast<size_t>(i)); });
         // Features
-        *this << "features";
-        ++(*this);
-            auto features = multi_tag.features();
-            for (auto &feature : features) {
-                *this << feature;
-            }
-        --(*this);
+        children("features", multi_tag.featureCount(), [&multi_tag](nix::ndsize_t i) { return multi_tag.getFeature(static_cast<size_t>(i)); });
     --(*this);
     return *this;
 }
@@ -429,37 +395,13 @@ yamlstream& yamlstream::operator<<(const nix::Block &block) {
         << "multiTagCount" << scalar_start << block.multiTagCount() << scalar_end
         << "dataArrayCount" << scalar_start << block.dataArrayCount() << scalar_end;
         // DataArrays
-        *this << "data_arrays";
-        ++(*this);
-            auto data_arrays = block.dataArrays();
-            for (auto &data_array : data_arrays) {
-                *this << data_array;
-            }
-        --(*this);
+        children("data_arrays", block.dataArrayCount(), [&block](nix::ndsize_t i) { return block.getDataArray(i); }, true);
         // MultiTags
-        *this << "multi_tags";
-        ++(*this);
-            auto multi_tags = block.multiTags();
-            for (auto &multi_tag : multi_tags) {
-                *this << multi_tag;
-            }
-        --(*this);
+        children("multi_tags", block.multiTagCount(), [&block](nix::ndsize_t i) { return block.getMultiTag(i); }, true);
         // Tags
-        *this << "tags";
-        ++(*this);
-            auto tags = block.tags();
-            for (auto &tag : tags) {
-                *this << tag;
-            }
-        --(*this);
+        children("tags", block.tagCount(), [&block](nix::ndsize_t i) { return block.getTag(i); }, true);
         // Sources
-        *this << "sources";
-        ++(*this);
-            auto sources = block.sources();
-            for (auto &source : sources) {
-                *this << source;            
-            }
-        --(*this);
+        children("sources", block.sourceCount(), [&block](nix::ndsize_t i) { return block.getSource(i); }, true);
     --(*this);
     return *this;
 }
@@ -480,21 +422,17 @@ yamlstream& yamlstream::operator<<(const nix::File &file) {
         << "blockCount" << scalar_start << file.blockCount() << scalar_end
         << "sectionCount" << scalar_start << file.sectionCount() << scalar_end;
         // Blocks
-        *this << "blocks";
-        ++(*this);
-            auto blocks = file.blocks();
-            for (auto &block : blocks) {
-                *this << block;
-            }
-        --(*this);
+        if (blocks.empty()) {
+            children("blocks", file.blockCount(), [&file](nix::ndsize_t i) { return file.getBlock(i); });
+        } else {
+            // only open the selected blocks
+            auto selected = [&file](const std::string &name_or_id) {
+                return file.hasBlock(name_or_id) ? file.getBlock(name_or_id) : nix::Block();
+            };
+            children("blocks", blocks.size(), [this, &selected](nix::ndsize_t i) { return selected(blocks[i]); });
+        }
         // Sections
-        *this << "sections";
-        ++(*this);
-            auto sections = file.sections();
-            for (auto &section : sections) {
-                *this << section;            
-            }
-        --(*this);
+        children("sections", file.sectionCount(), [&file](nix::ndsize_t i) { return file.getSection(i); });
     --(*this);
     
     return *this;
@@ -510,20 +448,49 @@ void Dump::load(po::options_description &desc) const {
     opt.add_options()
         (DATA_OPTION, "dump data from all 2D DataArrays")
         (PLOT_OPTION, ("dump & plot (only) data from all 2D DataArrays (linux only, invokes --" + std::string(DATA_OPTION) + ")").c_str())
+        (DEPTH_OPTION, po::value<size_t>(), "dump entities only down to the given depth (0: file, 1: blocks & sections, ...)")
+        (BLOCK_OPTION, po::value< std::vector<std::string> >(), "dump only the block with the given name or id (repeatable)")
+        (TYPE_OPTION, po::value< std::vector<std::string> >(), "dump only DataArrays, Tags, MultiTags & Sources of the given type (repeatable)")
     ;
     desc.add(opt);
 }
 
+void Dump::dumpData(const nix::DataArray &data_array, std::ostream &out, double &min, double &max) const {
+    // number of values read & written at once
+    const nix::ndsize_t block_size = 1 << 20;
+
+    nix::NDSize extent = data_array.dataExtent();
+    nix::ndsize_t dim1 = extent[0];
+    nix::ndsize_t dim2 = extent[1];
+    nix::ndsize_t rows = std::max<nix::ndsize_t>(1, block_size / std::max<nix::ndsize_t>(1, dim2));
+    std::vector<double> A;
+
+    // loop through data_array values, a block of rows at a time
+    for (nix::ndsize_t row = 0; row < dim1; row += rows) {
+        nix::ndsize_t n = std::min(rows, dim1 - row);
+        A.resize(static_cast<size_t>(n * dim2));
+        data_array.getData(nix::DataType::Double, A.data(), {n, dim2}, {row, static_cast<nix::ndsize_t>(0)});
+
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            for (nix::ndsize_t j = 0; j < dim2; j++) {
+                double val = A[static_cast<size_t>(i * dim2 + j)];
+                out << val << ((j != dim2-1) ? " " : "");
+                if (val < min) min = val;
+                if (val > max) max = val;
+            }
+            out << ((row + i != dim1-1) ? "\n" : "");
+        }
+    }
+}
+
 std::string Dump::call(const po::variables_map &vm, const po::options_description &desc) {
-    std::vector<nix::File> files; // opened nix files
+    std::vector<std::string> file_paths;
     std::stringstream out;
     std::ofstream fout;
-    nix::File tmp_file;
     std::string file_name;
-    double A_min = std::numeric_limits<double>::max();
-    double A_max = std::numeric_limits<double>::min();
-    typedef boost::multi_array<double, 2> array_type;
-    typedef array_type::index index;
+    std::vector<std::string> blocks;
+    std::vector<std::string> types;
+    size_t depth = std::numeric_limits<size_t>::max();
     
     // --help
     if (vm.count(HELP_OPTION)) {
@@ -532,59 +499,72 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
         out << temp << std::endl;
         return out.str();
     }
+    // selectors
+    if (vm.count(DEPTH_OPTION)) {
+        depth = vm[DEPTH_OPTION].as<size_t>();
+    }
+    if (vm.count(BLOCK_OPTION)) {
+        blocks = vm[BLOCK_OPTION].as< std::vector<std::string> >();
+    }
+    if (vm.count(TYPE_OPTION)) {
+        types = vm[TYPE_OPTION].as< std::vector<std::string> >();
+    }
     // --input-file
     if (vm.count(INPFILE_OPTION)) {
-        // open all files
+        // check all files before writing anything
         for (auto &file_path : vm[INPFILE_OPTION].as< std::vector<std::string> >()) {
             // file exists?
             if (!boost::filesystem::exists(file_path)) {
                 throw FileNotFound(file_path);
             }
+            file_paths.push_back(file_path);
+        }
+        // loop through entities in all files, opening one file at a time;
+        // output is written to std out as it is produced
+        for (auto &file_path : file_paths) {
             // try to open!
-            tmp_file = nix::File::open(file_path, nix::FileMode::ReadOnly);
+            nix::File file = nix::File::open(file_path, nix::FileMode::ReadOnly);
             // file opened?
-            if (!tmp_file.isOpen()) {
+            if (!file.isOpen()) {
                 throw FileNotOpen(file_path);
             }
-            // save it!
-            files.push_back(tmp_file); // ReadOnly, ReadWrite, Overwrite
-        }
-        // loop through entities in all files
-        for (auto &file : files) {
             if ( ! (vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)) ) {
+                yamlstream yaml(std::cout, depth, blocks, types);
                 yaml << file;
-                out << yaml.str();
+                std::cout.flush();
             }
             else {
-                // loop through all data_arrays
-                auto blcks = file.blocks();
+                // loop through selected blocks
+                std::vector<nix::Block> blcks;
+                if (blocks.empty()) {
+                    blcks = file.blocks();
+                } else {
+                    for (auto &name_or_id : blocks) {
+                        if (file.hasBlock(name_or_id)) {
+                            blcks.push_back(file.getBlock(name_or_id));
+                        }
+                    }
+                }
                 for (auto &block : blcks) {
-                    auto data_arrays = block.dataArrays();
-                    for (auto &data_array : data_arrays) {
+                    for (nix::ndsize_t k = 0; k < block.dataArrayCount(); k++) {
+                        nix::DataArray data_array = block.getDataArray(k);
+                        if (!types.empty() && std::find(types.begin(), types.end(), data_array.type()) == types.end()) {
+                            continue;
+                        }
+                        nix::NDSize extent = data_array.dataExtent();
                         // if we have a 2D data_array, output data & plot script
-                        if (data_array.dataExtent().size() == 2) {
+                        if (extent.size() == 2) {
+                            double A_min = std::numeric_limits<double>::max();
+                            double A_max = std::numeric_limits<double>::lowest();
                             file_name = "data_array_" + data_array.id();
                             fout.open(file_name + ".txt");
-                            index dim1 = static_cast<index>(data_array.dataExtent()[0]);
-                            index dim2 = static_cast<index>(data_array.dataExtent()[1]);
-                            array_type A(boost::extents[ dim1 ]
-                                                       [ dim2 ]);
-                            data_array.getData(A);
-                            // loop through data_array values
-                            for (index i = 0; i < dim1; i++) {
-                                for (index j = 0; j < dim2; j++) {
-                                    fout << A[i][j] << ((j != dim2-1) ? " " : "");
-                                    if (A[i][j] < A_min) A_min = A[i][j];
-                                    if (A[i][j] > A_max) A_max = A[i][j];
-                                }
-                                fout << ((i != dim1-1) ? "\n" : "");
-                            }
+                            dumpData(data_array, fout, A_min, A_max);
                             fout.close();
 
                             #ifndef _WIN32
                             if (vm.count(PLOT_OPTION)) {
                                 std::cout << "press ctrl+c for next plot" << std::endl;
-                                plot_script script(A_min, A_max, static_cast<size_t>(dim1), static_cast<size_t>(dim2), file_name + ".txt");
+                                plot_script script(A_min, A_max, static_cast<size_t>(extent[0]), static_cast<size_t>(extent[1]), file_name + ".txt");
                                 fout.open(file_name + ".gnu");
                                 fout << script.str();
                                 fout.close();
@@ -592,10 +572,11 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
                                 std::system(("./" + file_name + ".gnu").c_str());
                             }
                             #endif
-                        } // if data_array.dataExtent().size() == 2
+                        } // if extent.size() == 2
                     } // for data_arrays
                 } // for blcks
             } // if vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)
+            file.close();
         } // for: files
     } // if: INPFILE_OPTION
     else {
@@ -27,6 +27,9 @@
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
+#include <limits>
+#include <sstream>
+#include <vector>
 
 #include <boost/program_options.hpp>
 namespace po = boost::program_options;
@@ -36,6 +39,9 @@ namespace module {
 
 const char *const DATA_OPTION = "data";
 const char *const PLOT_OPTION = "plot";
+const char *const DEPTH_OPTION = "depth";
+const char *const BLOCK_OPTION = "block";
+const char *const TYPE_OPTION = "type";
 
 class plot_script {
 private:
@@ -101,8 +107,123 @@ class yamlstream {
     static const char* item_str;
     
     size_t level;
-    std::stringstream &sstream;
-    
+    std::ostream &ostream;
+    char last;
+
+    size_t depth;
+    size_t max_depth;
+    std::vector<std::string> blocks;
+    std::vector<std::string> types;
+
+    /**
+     * @brief write string to the output stream
+     *
+     * Write the string to the output stream and remember its last
+     * char, so that indentation does not need to look at the output.
+     *
+     * @param str the string to write
+     * @return void
+     */
+    void put(const std::string &str);
+
+    /**
+     * @brief format value and write it to the output stream
+     *
+     * @param t parameter of any given type T
+     * @return void
+     */
+    template<typename T>
+    void put(const T &t) {
+        std::stringstream tmp;
+        tmp << t;
+        put(tmp.str());
+    }
+
+    /**
+     * @brief check whether entity type passes the type selection
+     *
+     * @param type the type of the entity
+     * @return bool true if no types are selected or type is one of them
+     */
+    bool selected(const std::string &type) const;
+
+    template<typename T>
+    bool selected(const T &entity) const {
+        return true;
+    }
+
+    bool selected(const nix::DataArray &data_array) const {
+        return selected(data_array.type());
+    }
+
+    bool selected(const nix::Tag &tag) const {
+        return selected(tag.type());
+    }
+
+    bool selected(const nix::MultiTag &multi_tag) const {
+        return selected(multi_tag.type());
+    }
+
+    bool selected(const nix::Source &source) const {
+        return selected(source.type());
+    }
+
+    /**
+     * @brief output a child entity as sequence
+     *
+     * Output the key and, if the depth limit allows to descend, the
+     * entity returned by get(). The entity is not opened otherwise.
+     *
+     * @param key name of the sequence
+     * @param get getter returning the child entity
+     * @return self
+     */
+    template<typename F>
+    yamlstream& child(const std::string &key, F get) {
+        (*this) << key;
+        ++(*this);
+        if (depth < max_depth) {
+            depth++;
+            (*this) << get();
+            depth--;
+        }
+        --(*this);
+        return *this;
+    }
+
+    /**
+     * @brief output child entities as sequence, one at a time
+     *
+     * Output the key and, if the depth limit allows to descend, each
+     * of the count entities returned by get(i). The entities are opened
+     * and written one after another, so only one of them is held in
+     * memory at a time. With by_type set, entities not passing the type
+     * selection are skipped.
+     *
+     * @param key name of the sequence
+     * @param count number of child entities
+     * @param get getter returning the i-th child entity
+     * @param by_type apply type selection
+     * @return self
+     */
+    template<typename F>
+    yamlstream& children(const std::string &key, nix::ndsize_t count, F get, bool by_type = false) {
+        (*this) << key;
+        ++(*this);
+        if (depth < max_depth) {
+            depth++;
+            for (nix::ndsize_t i = 0; i < count; i++) {
+                auto entity = get(i);
+                if (!by_type || selected(entity)) {
+                    (*this) << entity;
+                }
+            }
+            depth--;
+        }
+        --(*this);
+        return *this;
+    }
+
     /**
      * @brief apply indentation on sstream if last char is "\n"
      *
@@ -159,7 +280,7 @@ class yamlstream {
      *
      * @return self
      */
-    yamlstream operator--();
+    yamlstream& operator--();
 
     /**
      * @brief end yaml sequence & decrease indent level
@@ -194,17 +315,19 @@ public:
      * @brief default ctor
      *
      * The default constructor.
-     */
-    yamlstream(std::stringstream &sstream) : level(0), sstream(sstream) {};
-
-    /**
-     * @brief return stringstream as string
-     *
-     * Return string from stringstream
      *
-     * @return string string content of the stream
+     * @param ostream stream to write the yaml output to
+     * @param max_depth number of entity levels below the file to output
+     * @param blocks names or ids of the blocks to output, all if empty; the
+     *               other blocks are not opened
+     * @param types entity types of the block contents to output, all if empty
      */
-    std::string str();
+    yamlstream(std::ostream &ostream,
+               size_t max_depth = std::numeric_limits<size_t>::max(),
+               const std::vector<std::string> &blocks = std::vector<std::string>(),
+               const std::vector<std::string> &types = std::vector<std::string>())
+        : level(0), ostream(ostream), last('\0'), depth(0), max_depth(max_depth),
+          blocks(blocks), types(types) {};
 
     /**
      * @brief default output into stringstream
@@ -217,7 +340,7 @@ public:
     template<typename T>
     yamlstream& operator<<(const T &t) {
         indent_if();
-        sstream << t;
+        put(t);
         return *this;
     }
     
@@ -233,11 +356,12 @@ public:
     yamlstream& operator<<(const std::vector<T> &t) {
         indent_if();
         if (t.size()) {
-            sstream << "[";
+            put("[");
             for (auto &el : t) {
-                sstream << el << ((*t.rbegin()) != el ? ", " : "");            
+                put(el);
+                put((*t.rbegin()) != el ? ", " : "");
             }
-            sstream << "]";
+            put("]");
         }
         return *this;
     }
@@ -265,22 +389,22 @@ public:
     yamlstream& operator<<(const boost::optional<T> &t) {
         indent_if();
         auto opt = nix::util::deRef(t);
-        sstream << opt;
+        put(opt);
         return *this;
     }
     
     /**
-     * @brief pointer to stringstream output into stringstream
+     * @brief stream manipulator output into stream
      *
-     * Output via pointer to stringstream.
+     * Apply manipulator to the output stream.
      *
-     * @param ps pointer to stringstream
+     * @param ps stream manipulator
      * @return self
      */
-	yamlstream& operator<<(std::stringstream& (*ps)(std::stringstream&))
+	yamlstream& operator<<(std::ostream& (*ps)(std::ostream&))
 	{
         indent_if();
-		sstream << ps;
+		put(ps);
 		return *this;
 	}
     
@@ -332,8 +456,8 @@ public:
     template<typename T>
     yamlstream& operator<<(const nix::base::EntityWithMetadata<T> &entityWithMetadata) {
         (*this)
-        << static_cast<nix::base::NamedEntity<T>>(entityWithMetadata)
-        << "metadata"; ++(*this) << entityWithMetadata.metadata(); --(*this);
+        << static_cast<nix::base::NamedEntity<T>>(entityWithMetadata);
+        child("metadata", [&entityWithMetadata] { return entityWithMetadata.metadata(); });
         
         return *this;
     }
@@ -499,12 +623,17 @@ public:
 };
 
 class Dump : virtual public IModule {
-    
-    yamlstream yaml;
-    std::stringstream sstream;
-    
+
+    /**
+     * @brief write data of a 2D DataArray as text matrix
+     *
+     * Read and write the data block by block of rows, so that memory use
+     * does not depend on the size of the DataArray. Updates min & max to
+     * the range of the data.
+     */
+    void dumpData(const nix::DataArray &data_array, std::ostream &out, double &min, double &max) const;
+
 public:
-    Dump() : yaml(yamlstream(sstream)) {}
 
     static const char* module_name;
 
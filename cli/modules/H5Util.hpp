@@ -0,0 +1,115 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_H5UTIL_H
+#define CLI_H5UTIL_H
+
+#include <hdf5.h>
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cli {
+namespace h5 {
+
+/*
+ * Small helpers for modules that look at the hdf5 file directly, below
+ * the nix API (e.g. to get at the storage layout).
+ */
+
+inline void check(herr_t err, const std::string &msg) {
+    if (err < 0) {
+        throw std::runtime_error(msg);
+    }
+}
+
+inline hid_t checkId(hid_t id, const std::string &msg) {
+    if (id < 0) {
+        throw std::runtime_error(msg);
+    }
+    return id;
+}
+
+/**
+ * @brief Closes an HDF5 id when leaving the scope.
+ */
+class Handle {
+    hid_t id;
+    herr_t (*closer)(hid_t);
+
+public:
+    Handle(hid_t id, herr_t (*closer)(hid_t)) : id(id), closer(closer) {}
+    Handle(const Handle &other) = delete;
+    Handle& operator=(const Handle &other) = delete;
+    ~Handle() { if (id >= 0) closer(id); }
+    operator hid_t() const { return id; }
+};
+
+/**
+ * @brief The index to iterate the links of a group in: creation order
+ *        if the group has a creation order index, name otherwise.
+ */
+inline H5_index_t linkIndex(hid_t group) {
+    Handle gcpl(checkId(H5Gget_create_plist(group), "could not get group creation properties"), H5Pclose);
+    unsigned flags = 0;
+    check(H5Pget_link_creation_order(gcpl, &flags), "could not get link creation order");
+    return (flags & H5P_CRT_ORDER_INDEXED) ? H5_INDEX_CRT_ORDER : H5_INDEX_NAME;
+}
+
+/**
+ * @brief Names of all links in a group, in the given index order.
+ */
+inline std::vector<std::string> linkNames(hid_t group, H5_index_t index = H5_INDEX_NAME) {
+    H5G_info_t info;
+    check(H5Gget_info(group, &info), "could not get group info");
+
+    std::vector<std::string> names;
+    for (hsize_t i = 0; i < info.nlinks; i++) {
+        ssize_t len = H5Lget_name_by_idx(group, ".", index, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+        check(static_cast<herr_t>(len < 0 ? -1 : 0), "could not get link name");
+        std::string name(static_cast<size_t>(len), '\0');
+        H5Lget_name_by_idx(group, ".", index, H5_ITER_INC, i, &name[0], name.size() + 1, H5P_DEFAULT);
+        names.push_back(name);
+    }
+    return names;
+}
+
+inline bool hasObject(hid_t loc, const std::string &name, H5O_type_t type) {
+    if (H5Lexists(loc, name.c_str(), H5P_DEFAULT) <= 0) {
+        return false;
+    }
+    H5O_info_t info;
+    if (H5Oget_info_by_name(loc, name.c_str(), &info, H5P_DEFAULT) < 0) {
+        return false;
+    }
+    return info.type == type;
+}
+
+/**
+ * @brief Human readable byte count.
+ */
+inline std::string bytes(hsize_t size) {
+    const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    double val = static_cast<double>(size);
+    size_t unit = 0;
+    while (val >= 1024 && unit < 4) {
+        val /= 1024;
+        unit++;
+    }
+    std::stringstream ss;
+    ss << std::setprecision(unit ? 3 : 0) << std::fixed << val << " " << units[unit];
+    return ss.str();
+}
+
+} // namespace h5
+} // namespace cli
+
+#endif
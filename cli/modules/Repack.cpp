@@ -0,0 +1,898 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <modules/Repack.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>
+
+#include <hdf5/h5x/H5Object.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Repack::module_name = "repack";
+
+// deflate level used by the auto policy
+static const int AUTO_DEFLATE_LEVEL = 4;
+// data sets smaller than this are not compressed by the auto policy
+static const hsize_t AUTO_MIN_SIZE = 4096;
+// data is compared in slabs of about this size
+static const hsize_t VERIFY_SLAB_SIZE = 1 << 20;
+
+using namespace h5;
+
+// ---------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------
+
+/**
+ * @brief Whether values of the type hold pointers to variable length data.
+ */
+static bool isVariable(hid_t type) {
+    switch (H5Tget_class(type)) {
+        case H5T_STRING:
+            return H5Tis_variable_str(type) > 0;
+        case H5T_VLEN:
+            return true;
+        case H5T_COMPOUND: {
+            int n = H5Tget_nmembers(type);
+            for (unsigned m = 0; m < static_cast<unsigned>(n); m++) {
+                Handle member(H5Tget_member_type(type, m), H5Tclose);
+                if (isVariable(member)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case H5T_ARRAY: {
+            Handle base(H5Tget_super(type), H5Tclose);
+            return isVariable(base);
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief A buffer holding values of an hdf5 type, that frees variable
+ *        length data read into it.
+ */
+class Values {
+    hid_t type;
+    hid_t space;
+    bool read;
+
+public:
+    std::vector<unsigned char> data;
+
+    Values(hid_t type, hid_t space) : type(type), space(space), read(false) {
+        hssize_t n = H5Sget_select_npoints(space);
+        data.resize(static_cast<size_t>(std::max<hssize_t>(n, 0)) * H5Tget_size(type));
+    }
+
+    void readAttr(hid_t attr) {
+        check(H5Aread(attr, type, data.data()), "could not read attribute");
+        read = true;
+    }
+
+    void readData(hid_t ds, hid_t mspace, hid_t fspace) {
+        check(H5Dread(ds, type, mspace, fspace, H5P_DEFAULT, data.data()), "could not read data");
+        read = true;
+    }
+
+    ~Values() {
+        if (read && isVariable(type)) {
+            H5Dvlen_reclaim(type, space, H5P_DEFAULT, data.data());
+        }
+    }
+};
+
+static H5_index_t attrIndex(hid_t obj) {
+    H5I_type_t type = H5Iget_type(obj);
+    hid_t cpl = type == H5I_DATASET ? H5Dget_create_plist(obj) :
+                type == H5I_GROUP ? H5Gget_create_plist(obj) : -1;
+    if (cpl < 0) {
+        return H5_INDEX_NAME;
+    }
+    Handle plist(cpl, H5Pclose);
+    unsigned flags = 0;
+    H5Pget_attr_creation_order(plist, &flags);
+    return (flags & H5P_CRT_ORDER_INDEXED) ? H5_INDEX_CRT_ORDER : H5_INDEX_NAME;
+}
+
+static std::string attrName(hid_t attr) {
+    ssize_t len = H5Aget_name(attr, 0, NULL);
+    check(static_cast<herr_t>(len < 0 ? -1 : 0), "could not get attribute name");
+    std::string name(static_cast<size_t>(len), '\0');
+    H5Aget_name(attr, name.size() + 1, &name[0]);
+    return name;
+}
+
+static void copyAttributes(hid_t src, hid_t dst) {
+    H5O_info_t info;
+    check(H5Oget_info(src, &info), "could not get object info");
+    H5_index_t index = attrIndex(src);
+
+    for (hsize_t i = 0; i < info.num_attrs; i++) {
+        Handle attr(checkId(H5Aopen_by_idx(src, ".", index, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT),
+                            "could not open attribute"), H5Aclose);
+        std::string name = attrName(attr);
+        Handle type(checkId(H5Aget_type(attr), "could not get attribute type"), H5Tclose);
+        Handle space(checkId(H5Aget_space(attr), "could not get attribute space"), H5Sclose);
+
+        Values values(type, space);
+        values.readAttr(attr);
+        Handle copy(checkId(H5Acreate2(dst, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT),
+                            "could not create attribute " + name), H5Aclose);
+        check(H5Awrite(copy, type, values.data.data()), "could not write attribute " + name);
+    }
+}
+
+/**
+ * @brief Fresh creation properties with the settings of an existing group.
+ *
+ * The properties returned by H5Gget_create_plist carry the location of the
+ * group's link storage and can therefore not be used to create a new group.
+ */
+static hid_t groupCreateProperties(hid_t group) {
+    Handle src(checkId(H5Gget_create_plist(group), "could not get group creation properties"), H5Pclose);
+    hid_t gcpl = checkId(H5Pcreate(H5P_GROUP_CREATE), "could not create group creation properties");
+
+    unsigned link_order = 0, attr_order = 0, max_compact = 0, min_dense = 0, est_num = 0, est_len = 0;
+    H5Pget_link_creation_order(src, &link_order);
+    H5Pget_attr_creation_order(src, &attr_order);
+    H5Pget_link_phase_change(src, &max_compact, &min_dense);
+    H5Pget_est_link_info(src, &est_num, &est_len);
+    if (H5Pset_link_creation_order(gcpl, link_order) < 0 ||
+        H5Pset_attr_creation_order(gcpl, attr_order) < 0 ||
+        H5Pset_link_phase_change(gcpl, max_compact, min_dense) < 0 ||
+        H5Pset_est_link_info(gcpl, est_num, est_len) < 0) {
+        H5Pclose(gcpl);
+        throw std::runtime_error("could not set group creation properties");
+    }
+    return gcpl;
+}
+
+/**
+ * @brief Compare single values of a type in memory, following variable
+ *        length data.
+ */
+static bool equalValue(hid_t type, const unsigned char *a, const unsigned char *b) {
+    switch (H5Tget_class(type)) {
+        case H5T_STRING:
+            if (H5Tis_variable_str(type) > 0) {
+                const char *sa, *sb;
+                std::memcpy(&sa, a, sizeof(sa));
+                std::memcpy(&sb, b, sizeof(sb));
+                return (sa && sb) ? std::strcmp(sa, sb) == 0 : sa == sb;
+            }
+            break;
+        case H5T_COMPOUND: {
+            int n = H5Tget_nmembers(type);
+            for (unsigned m = 0; m < static_cast<unsigned>(n); m++) {
+                size_t offset = H5Tget_member_offset(type, m);
+                Handle member(H5Tget_member_type(type, m), H5Tclose);
+                if (!equalValue(member, a + offset, b + offset)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case H5T_VLEN: {
+            hvl_t va, vb;
+            std::memcpy(&va, a, sizeof(va));
+            std::memcpy(&vb, b, sizeof(vb));
+            if (va.len != vb.len) {
+                return false;
+            }
+            Handle base(H5Tget_super(type), H5Tclose);
+            size_t size = H5Tget_size(base);
+            for (size_t i = 0; i < va.len; i++) {
+                if (!equalValue(base, static_cast<unsigned char *>(va.p) + i * size,
+                                static_cast<unsigned char *>(vb.p) + i * size)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case H5T_ARRAY: {
+            Handle base(H5Tget_super(type), H5Tclose);
+            size_t size = H5Tget_size(base);
+            size_t n = H5Tget_size(type) / size;
+            for (size_t i = 0; i < n; i++) {
+                if (!equalValue(base, a + i * size, b + i * size)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            break;
+    }
+    return std::memcmp(a, b, H5Tget_size(type)) == 0;
+}
+
+static bool equalValues(hid_t type, const Values &a, const Values &b) {
+    if (a.data.size() != b.data.size()) {
+        return false;
+    }
+    if (!isVariable(type)) {
+        return a.data == b.data;
+    }
+    size_t size = H5Tget_size(type);
+    for (size_t i = 0; i < a.data.size(); i += size) {
+        if (!equalValue(type, &a.data[i], &b.data[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::vector<hsize_t> extentOf(hid_t space) {
+    int rank = H5Sget_simple_extent_ndims(space);
+    std::vector<hsize_t> extent(static_cast<size_t>(std::max(rank, 0)));
+    H5Sget_simple_extent_dims(space, extent.data(), NULL);
+    return extent;
+}
+
+static hsize_t product(const std::vector<hsize_t> &values, size_t from = 0) {
+    hsize_t p = 1;
+    for (size_t i = from; i < values.size(); i++) {
+        p *= values[i];
+    }
+    return p;
+}
+
+/**
+ * @brief Choose the chunk shape for a data set from the access hint.
+ */
+static std::vector<hsize_t> chooseChunk(const std::vector<hsize_t> &extent, hsize_t type_size, const RepackOptions &opts) {
+    hsize_t target = std::max<hsize_t>(1, opts.chunk_size / type_size);
+    std::vector<hsize_t> chunk(extent.size());
+    std::transform(extent.begin(), extent.end(), chunk.begin(), [](hsize_t e) { return std::max<hsize_t>(e, 1); });
+
+    auto halveLargest = [&chunk](size_t from) {
+        auto it = std::max_element(chunk.begin() + from, chunk.end());
+        *it = (*it + 1) / 2;
+    };
+
+    if (opts.access == AccessHint::Sequential && chunk.size() > 1) {
+        // whole rows (all but the first axis), as many of them as fit
+        while (product(chunk, 1) > target) {
+            halveLargest(1);
+        }
+        chunk[0] = std::min(chunk[0], std::max<hsize_t>(1, target / product(chunk, 1)));
+    } else {
+        while (product(chunk) > target) {
+            halveLargest(0);
+        }
+    }
+
+    return chunk;
+}
+
+// ---------------------------------------------------------------------
+// Chunk pipeline
+// ---------------------------------------------------------------------
+
+struct Chunk {
+    std::vector<hsize_t> offset;
+    std::vector<hsize_t> count;     // extent of the data within the chunk
+    std::vector<unsigned char> data;
+    uint32_t filter_mask = 0;
+    bool skip = false;
+};
+
+/**
+ * @brief Reads data from the source data set in the chunk shape of the
+ *        destination; partial edge chunks are padded with the fill value.
+ */
+class ChunkReader {
+    hid_t src;
+    hid_t type;
+    hid_t space;
+    std::vector<hsize_t> extent;
+    std::vector<hsize_t> chunk;
+    std::vector<hsize_t> grid;
+    std::vector<unsigned char> fill;
+
+public:
+    ChunkReader(hid_t src, hid_t type, hid_t space, const std::vector<hsize_t> &chunk, const std::vector<unsigned char> &fill)
+        : src(src), type(type), space(space), extent(extentOf(space)), chunk(chunk), grid(chunk.size()), fill(fill) {
+        for (size_t d = 0; d < chunk.size(); d++) {
+            grid[d] = (extent[d] + chunk[d] - 1) / chunk[d];
+        }
+    }
+
+    hsize_t count() const {
+        return product(grid);
+    }
+
+    void read(hsize_t index, Chunk &c) const {
+        size_t rank = chunk.size();
+        std::vector<hsize_t> zero(rank, 0);
+        c.offset.resize(rank);
+        c.count.resize(rank);
+        for (size_t d = rank; d-- > 0;) {
+            c.offset[d] = (index % grid[d]) * chunk[d];
+            c.count[d] = std::min(chunk[d], extent[d] - c.offset[d]);
+            index /= grid[d];
+        }
+
+        c.data.resize(static_cast<size_t>(product(chunk)) * fill.size());
+        for (size_t i = 0; i < c.data.size(); i += fill.size()) {
+            std::memcpy(&c.data[i], fill.data(), fill.size());
+        }
+
+        nix::hdf5::H5Lock lock;
+        Handle fspace(checkId(H5Scopy(space), "could not copy data space"), H5Sclose);
+        check(H5Sselect_hyperslab(fspace, H5S_SELECT_SET, c.offset.data(), NULL, c.count.data(), NULL), "could not select chunk");
+        Handle mspace(checkId(H5Screate_simple(static_cast<int>(rank), chunk.data(), NULL), "could not create data space"), H5Sclose);
+        check(H5Sselect_hyperslab(mspace, H5S_SELECT_SET, zero.data(), NULL, c.count.data(), NULL), "could not select chunk");
+        check(H5Dread(src, type, mspace, fspace, H5P_DEFAULT, c.data.data()), "could not read chunk");
+    }
+
+    /**
+     * @brief Write an uncompressed chunk through the filter pipeline of the
+     *        destination.
+     */
+    void write(hid_t dst, const Chunk &c) const {
+        std::vector<hsize_t> zero(chunk.size(), 0);
+        nix::hdf5::H5Lock lock;
+        Handle fspace(checkId(H5Scopy(space), "could not copy data space"), H5Sclose);
+        check(H5Sselect_hyperslab(fspace, H5S_SELECT_SET, c.offset.data(), NULL, c.count.data(), NULL), "could not select chunk");
+        Handle mspace(checkId(H5Screate_simple(static_cast<int>(chunk.size()), chunk.data(), NULL), "could not create data space"), H5Sclose);
+        check(H5Sselect_hyperslab(mspace, H5S_SELECT_SET, zero.data(), NULL, c.count.data(), NULL), "could not select chunk");
+        check(H5Dwrite(dst, type, mspace, fspace, H5P_DEFAULT, c.data.data()), "could not write chunk");
+    }
+
+    /**
+     * @brief Whether the chunk only holds the fill value, so that it
+     *        does not need to be stored.
+     */
+    bool isFill(const Chunk &c) const {
+        for (size_t i = 0; i < c.data.size(); i += fill.size()) {
+            if (std::memcmp(&c.data[i], fill.data(), fill.size()) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Deflate the chunk the way the hdf5 deflate filter does. Chunks
+ *        that do not shrink are stored unfiltered.
+ */
+static void compress(Chunk &c, int level) {
+    uLongf len = compressBound(static_cast<uLong>(c.data.size()));
+    std::vector<unsigned char> out(len);
+    int res = compress2(out.data(), &len, c.data.data(), static_cast<uLong>(c.data.size()), level);
+    if (res == Z_OK && len < c.data.size()) {
+        out.resize(len);
+        c.data.swap(out);
+        c.filter_mask = 0;
+    } else {
+        c.filter_mask = 1; // skip the (optional) deflate filter
+    }
+}
+
+/**
+ * @brief Copy all chunks: one thread reads, threads compress and the
+ *        calling thread writes them, in order. At most a few chunks per
+ *        thread are in flight at any time.
+ *
+ * Reading and writing call hdf5, which is not reentrant, and hold the
+ * process wide H5Lock for it; only the fill check and the compression
+ * run in parallel.
+ *
+ * Without H5Dwrite_chunk (hdf5 < 1.10.2) chunks are compressed by hdf5
+ * while writing, on the calling thread.
+ */
+static size_t copyChunks(const ChunkReader &reader, hid_t dst, int level, size_t threads) {
+#if !H5_VERSION_GE(1, 10, 2)
+    level = 0;
+#endif
+    const hsize_t n = reader.count();
+    const size_t max_in_flight = 2 * threads + 2;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::pair<hsize_t, Chunk>> to_compress;
+    std::map<hsize_t, Chunk> done;
+    size_t in_flight = 0;
+    bool read_done = false;
+    std::exception_ptr error;
+
+    auto fail = [&](std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!error) {
+            error = e;
+        }
+        cv.notify_all();
+    };
+
+    std::vector<std::thread> workers;
+    workers.emplace_back([&] {
+        try {
+            for (hsize_t i = 0; i < n; i++) {
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait(lock, [&] { return in_flight < max_in_flight || error; });
+                    if (error) {
+                        return;
+                    }
+                    in_flight++;
+                }
+                Chunk c;
+                reader.read(i, c);
+                std::lock_guard<std::mutex> lock(mtx);
+                to_compress.emplace_back(i, std::move(c));
+                cv.notify_all();
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        read_done = true;
+        cv.notify_all();
+    });
+
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            for (;;) {
+                std::pair<hsize_t, Chunk> item;
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait(lock, [&] { return !to_compress.empty() || read_done || error; });
+                    if (error || to_compress.empty()) {
+                        return;
+                    }
+                    item = std::move(to_compress.front());
+                    to_compress.pop_front();
+                }
+                item.second.skip = reader.isFill(item.second);
+                if (!item.second.skip && level > 0) {
+                    compress(item.second, level);
+                }
+                std::lock_guard<std::mutex> lock(mtx);
+                done.emplace(item.first, std::move(item.second));
+                cv.notify_all();
+            }
+        });
+    }
+
+    size_t written = 0;
+    try {
+        for (hsize_t i = 0; i < n; i++) {
+            Chunk c;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&] { return done.count(i) > 0 || error; });
+                if (error) {
+                    break;
+                }
+                c = std::move(done[i]);
+                done.erase(i);
+            }
+            if (!c.skip) {
+#if H5_VERSION_GE(1, 10, 2)
+                nix::hdf5::H5Lock lock;
+                check(H5Dwrite_chunk(dst, H5P_DEFAULT, c.filter_mask, c.offset.data(), c.data.size(), c.data.data()),
+                      "could not write chunk");
+#else
+                reader.write(dst, c);
+#endif
+                written++;
+            }
+            std::lock_guard<std::mutex> lock(mtx);
+            in_flight--;
+            cv.notify_all();
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return written;
+}
+
+// ---------------------------------------------------------------------
+// Repack
+// ---------------------------------------------------------------------
+
+void Repack::copyData(hid_t src_parent, const std::string &name, hid_t dst_parent, RepackOptions &opts) const {
+    Handle src(checkId(H5Dopen(src_parent, name.c_str(), H5P_DEFAULT), "could not open " + name), H5Dclose);
+    Handle type(checkId(H5Dget_type(src), "could not get data type"), H5Tclose);
+    Handle space(checkId(H5Dget_space(src), "could not get data space"), H5Sclose);
+    Handle src_dcpl(checkId(H5Dget_create_plist(src), "could not get creation properties"), H5Pclose);
+
+    // variable length data & references can not be written as raw chunks
+    if (isVariable(type) || H5Tget_class(type) == H5T_REFERENCE ||
+        H5Sget_simple_extent_ndims(space) < 1) {
+        check(H5Ocopy(src_parent, name.c_str(), dst_parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT),
+              "could not copy " + name);
+        return;
+    }
+
+    std::vector<hsize_t> extent = extentOf(space);
+    hsize_t type_size = H5Tget_size(type);
+    std::vector<hsize_t> chunk = chooseChunk(extent, type_size, opts);
+
+    // keep a user defined fill value
+    std::vector<unsigned char> fill(type_size, 0);
+    H5D_fill_value_t fill_status;
+    check(H5Pfill_value_defined(src_dcpl, &fill_status), "could not get fill value");
+    Handle dcpl(checkId(H5Pcreate(H5P_DATASET_CREATE), "could not create creation properties"), H5Pclose);
+    check(H5Pset_chunk(dcpl, static_cast<int>(chunk.size()), chunk.data()), "could not set chunk size");
+    if (fill_status == H5D_FILL_VALUE_USER_DEFINED) {
+        check(H5Pget_fill_value(src_dcpl, type, fill.data()), "could not get fill value");
+        check(H5Pset_fill_value(dcpl, type, fill.data()), "could not set fill value");
+    }
+
+    ChunkReader reader(src, type, space, chunk, fill);
+
+    int level = 0;
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+        switch (opts.compression) {
+            case CompressionPolicy::Fast:
+                level = 1;
+                break;
+            case CompressionPolicy::Best:
+                level = 9;
+                break;
+            case CompressionPolicy::Auto:
+                // compress if the first chunk shrinks by at least 10%
+                if (product(extent) * type_size >= AUTO_MIN_SIZE) {
+                    Chunk sample;
+                    reader.read(0, sample);
+                    size_t raw = sample.data.size();
+                    compress(sample, AUTO_DEFLATE_LEVEL);
+                    if (sample.filter_mask == 0 && sample.data.size() * 10 <= raw * 9) {
+                        level = AUTO_DEFLATE_LEVEL;
+                    }
+                }
+                break;
+            case CompressionPolicy::None:
+                break;
+        }
+    }
+    if (level > 0) {
+        check(H5Pset_deflate(dcpl, static_cast<unsigned>(level)), "could not set compression");
+        opts.compressed++;
+    }
+
+    Handle dst(checkId(H5Dcreate2(dst_parent, name.c_str(), type, space, H5P_DEFAULT, dcpl, H5P_DEFAULT),
+                       "could not create " + name), H5Dclose);
+    copyAttributes(src, dst);
+
+    opts.chunks += copyChunks(reader, dst, level, std::max<size_t>(opts.threads, 1));
+    opts.data_sets++;
+}
+
+
+void Repack::copyLink(hid_t src_parent, const std::string &name, hid_t dst_parent, const std::string &dst_path,
+                      std::map<haddr_t, std::string> &copied, RepackOptions &opts) const {
+    H5L_info_t linfo;
+    check(H5Lget_info(src_parent, name.c_str(), &linfo, H5P_DEFAULT), "could not get link info of " + name);
+
+    if (linfo.type == H5L_TYPE_SOFT || linfo.type == H5L_TYPE_EXTERNAL) {
+        std::vector<char> val(linfo.u.val_size);
+        check(H5Lget_val(src_parent, name.c_str(), val.data(), val.size(), H5P_DEFAULT), "could not get link value of " + name);
+        if (linfo.type == H5L_TYPE_SOFT) {
+            check(H5Lcreate_soft(val.data(), dst_parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT), "could not create link " + name);
+        } else {
+            unsigned flags;
+            const char *file_name, *obj_name;
+            check(H5Lunpack_elink_val(val.data(), val.size(), &flags, &file_name, &obj_name), "could not unpack link " + name);
+            check(H5Lcreate_external(file_name, obj_name, dst_parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT),
+                  "could not create link " + name);
+        }
+        return;
+    }
+    if (linfo.type != H5L_TYPE_HARD) {
+        throw std::runtime_error("unsupported link type of " + name);
+    }
+
+    // object copied before: link it again
+    auto it = copied.find(linfo.u.address);
+    if (it != copied.end()) {
+        check(H5Lcreate_hard(dst_parent, it->second.c_str(), dst_parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT),
+              "could not create link " + name);
+        return;
+    }
+
+    std::string path = dst_path + "/" + name;
+    copied[linfo.u.address] = path;
+
+    H5O_info_t info;
+    check(H5Oget_info_by_name(src_parent, name.c_str(), &info, H5P_DEFAULT), "could not get object info of " + name);
+
+    if (info.type == H5O_TYPE_GROUP) {
+        Handle src(checkId(H5Gopen(src_parent, name.c_str(), H5P_DEFAULT), "could not open " + name), H5Gclose);
+        Handle gcpl(groupCreateProperties(src), H5Pclose);
+        Handle dst(checkId(H5Gcreate2(dst_parent, name.c_str(), H5P_DEFAULT, gcpl, H5P_DEFAULT), "could not create " + name), H5Gclose);
+        copyAttributes(src, dst);
+        copyGroup(src, dst, path, copied, opts);
+    } else if (info.type == H5O_TYPE_DATASET && name == "data" && H5Aexists(src_parent, "entity_id") > 0) {
+        // the data of a DataArray
+        copyData(src_parent, name, dst_parent, opts);
+    } else {
+        check(H5Ocopy(src_parent, name.c_str(), dst_parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT),
+              "could not copy " + name);
+    }
+}
+
+
+void Repack::copyGroup(hid_t src, hid_t dst, const std::string &dst_path,
+                       std::map<haddr_t, std::string> &copied, RepackOptions &opts) const {
+    for (const auto &name : linkNames(src, linkIndex(src))) {
+        copyLink(src, name, dst, dst_path, copied, opts);
+    }
+}
+
+
+void Repack::verify(hid_t src, hid_t dst, const std::string &path, std::map<haddr_t, haddr_t> &seen) const {
+    auto differs = [&path](const std::string &what) {
+        return std::runtime_error("verification failed: " + what + " differs at " + (path.empty() ? "/" : path));
+    };
+
+    H5O_info_t src_info, dst_info;
+    check(H5Oget_info(src, &src_info), "could not get object info");
+    check(H5Oget_info(dst, &dst_info), "could not get object info");
+
+    // objects linked from several places must be shared in the copy as well
+    auto it = seen.find(src_info.addr);
+    if (it != seen.end()) {
+        if (it->second != dst_info.addr) {
+            throw differs("object identity");
+        }
+        return;
+    }
+    seen[src_info.addr] = dst_info.addr;
+
+    if (src_info.type != dst_info.type) {
+        throw differs("object type");
+    }
+
+    // attributes
+    if (src_info.num_attrs != dst_info.num_attrs) {
+        throw differs("attribute count");
+    }
+    for (hsize_t i = 0; i < src_info.num_attrs; i++) {
+        Handle src_attr(checkId(H5Aopen_by_idx(src, ".", H5_INDEX_NAME, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT),
+                                "could not open attribute"), H5Aclose);
+        std::string name = attrName(src_attr);
+        if (H5Aexists(dst, name.c_str()) <= 0) {
+            throw differs("attribute " + name);
+        }
+        Handle dst_attr(checkId(H5Aopen(dst, name.c_str(), H5P_DEFAULT), "could not open attribute"), H5Aclose);
+        Handle type(checkId(H5Aget_type(src_attr), "could not get attribute type"), H5Tclose);
+        Handle dst_type(checkId(H5Aget_type(dst_attr), "could not get attribute type"), H5Tclose);
+        Handle space(checkId(H5Aget_space(src_attr), "could not get attribute space"), H5Sclose);
+        Handle dst_space(checkId(H5Aget_space(dst_attr), "could not get attribute space"), H5Sclose);
+        if (H5Tequal(type, dst_type) <= 0 || extentOf(space) != extentOf(dst_space)) {
+            throw differs("attribute " + name);
+        }
+        Values a(type, space), b(type, dst_space);
+        a.readAttr(src_attr);
+        b.readAttr(dst_attr);
+        if (!equalValues(type, a, b)) {
+            throw differs("value of attribute " + name);
+        }
+    }
+
+    if (src_info.type == H5O_TYPE_GROUP) {
+        std::vector<std::string> names = linkNames(src, linkIndex(src));
+        if (names != linkNames(dst, linkIndex(dst))) {
+            throw differs("links or their order");
+        }
+        for (const auto &name : names) {
+            H5L_info_t src_link, dst_link;
+            check(H5Lget_info(src, name.c_str(), &src_link, H5P_DEFAULT), "could not get link info");
+            check(H5Lget_info(dst, name.c_str(), &dst_link, H5P_DEFAULT), "could not get link info");
+            if (src_link.type != dst_link.type) {
+                throw differs("type of link " + name);
+            }
+            if (src_link.type != H5L_TYPE_HARD) {
+                std::vector<char> a(src_link.u.val_size), b(dst_link.u.val_size);
+                H5Lget_val(src, name.c_str(), a.data(), a.size(), H5P_DEFAULT);
+                H5Lget_val(dst, name.c_str(), b.data(), b.size(), H5P_DEFAULT);
+                if (a != b) {
+                    throw differs("target of link " + name);
+                }
+                continue;
+            }
+            Handle src_obj(checkId(H5Oopen(src, name.c_str(), H5P_DEFAULT), "could not open " + name), H5Oclose);
+            Handle dst_obj(checkId(H5Oopen(dst, name.c_str(), H5P_DEFAULT), "could not open " + name), H5Oclose);
+            verify(src_obj, dst_obj, path + "/" + name, seen);
+        }
+    } else if (src_info.type == H5O_TYPE_DATASET) {
+        Handle type(checkId(H5Dget_type(src), "could not get data type"), H5Tclose);
+        Handle dst_type(checkId(H5Dget_type(dst), "could not get data type"), H5Tclose);
+        Handle space(checkId(H5Dget_space(src), "could not get data space"), H5Sclose);
+        Handle dst_space(checkId(H5Dget_space(dst), "could not get data space"), H5Sclose);
+        std::vector<hsize_t> extent = extentOf(space);
+        if (H5Tequal(type, dst_type) <= 0 || extent != extentOf(dst_space)) {
+            throw differs("data type or extent");
+        }
+        if (extent.empty()) {
+            Values a(type, space), b(type, dst_space);
+            a.readData(src, H5S_ALL, H5S_ALL);
+            b.readData(dst, H5S_ALL, H5S_ALL);
+            if (!equalValues(type, a, b)) {
+                throw differs("data");
+            }
+            return;
+        }
+
+        // compare in slabs along the first axis
+        hsize_t row_size = std::max<hsize_t>(1, product(extent, 1) * H5Tget_size(type));
+        hsize_t rows = std::max<hsize_t>(1, VERIFY_SLAB_SIZE / row_size);
+        std::vector<hsize_t> offset(extent.size(), 0), count(extent);
+        for (hsize_t row = 0; row < extent[0]; row += rows) {
+            offset[0] = row;
+            count[0] = std::min(rows, extent[0] - row);
+            Handle mspace(checkId(H5Screate_simple(static_cast<int>(count.size()), count.data(), NULL), "could not create data space"), H5Sclose);
+            check(H5Sselect_hyperslab(space, H5S_SELECT_SET, offset.data(), NULL, count.data(), NULL), "could not select data");
+            check(H5Sselect_hyperslab(dst_space, H5S_SELECT_SET, offset.data(), NULL, count.data(), NULL), "could not select data");
+            Values a(type, mspace), b(type, mspace);
+            a.readData(src, mspace, space);
+            b.readData(dst, mspace, dst_space);
+            if (!equalValues(type, a, b)) {
+                throw differs("data");
+            }
+        }
+    }
+}
+
+
+void Repack::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Copy a given nix-file into a new one with fresh chunking, compression and\n\t" +
+                                     "without free space. Entity ids, links and order are preserved.\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (OUTPUT_OPTION, po::value<std::string>(), "file to write (must not exist)")
+        (ACCESS_OPTION, po::value<std::string>()->default_value("sequential"),
+         "access hint for chunking: sequential (whole rows along the first axis) or balanced (blocks)")
+        (CHUNK_SIZE_OPTION, po::value<size_t>()->default_value(256 * 1024), "target chunk size in bytes")
+        (COMPRESSION_OPTION, po::value<std::string>()->default_value("auto"),
+         "compression policy: none, auto (deflate if it saves at least 10%), fast or best")
+        (THREADS_OPTION, po::value<size_t>(), "number of compression threads (default: number of cores)")
+        (NOVERIFY_OPTION, "do not compare the new file with the original")
+    ;
+    desc.add(opt);
+}
+
+
+std::string Repack::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+    // --input-file
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+    auto inputs = vm[INPFILE_OPTION].as< std::vector<std::string> >();
+    if (inputs.size() != 1) {
+        throw std::invalid_argument("repack takes exactly one input file");
+    }
+    if (!vm.count(OUTPUT_OPTION)) {
+        throw std::invalid_argument("no output file given");
+    }
+    std::string input = inputs[0];
+    std::string output = vm[OUTPUT_OPTION].as<std::string>();
+    if (!boost::filesystem::exists(input)) {
+        throw FileNotFound(input);
+    }
+    if (boost::filesystem::exists(output)) {
+        throw std::invalid_argument("File '" + output + "' already exists");
+    }
+
+    RepackOptions opts;
+    std::string access = vm[ACCESS_OPTION].as<std::string>();
+    if (access == "sequential") {
+        opts.access = AccessHint::Sequential;
+    } else if (access == "balanced") {
+        opts.access = AccessHint::Balanced;
+    } else {
+        throw std::invalid_argument("unknown access hint '" + access + "'");
+    }
+    std::string compression = vm[COMPRESSION_OPTION].as<std::string>();
+    if (compression == "none") {
+        opts.compression = CompressionPolicy::None;
+    } else if (compression == "auto") {
+        opts.compression = CompressionPolicy::Auto;
+    } else if (compression == "fast") {
+        opts.compression = CompressionPolicy::Fast;
+    } else if (compression == "best") {
+        opts.compression = CompressionPolicy::Best;
+    } else {
+        throw std::invalid_argument("unknown compression policy '" + compression + "'");
+    }
+    opts.chunk_size = std::max<hsize_t>(1, vm[CHUNK_SIZE_OPTION].as<size_t>());
+    opts.threads = vm.count(THREADS_OPTION) ? vm[THREADS_OPTION].as<size_t>() : std::thread::hardware_concurrency();
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        hid_t fid = H5Fopen(input.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        if (fid < 0) {
+            throw FileNotOpen(input);
+        }
+        Handle src(fid, H5Fclose);
+        Handle src_root(checkId(H5Gopen(src, "/", H5P_DEFAULT), "could not open root group"), H5Gclose);
+        Handle fcpl(checkId(H5Fget_create_plist(src), "could not get file creation properties"), H5Pclose);
+
+        // the file creation properties do not report the root group's creation order flags
+        Handle root_gcpl(checkId(H5Gget_create_plist(src_root), "could not get group creation properties"), H5Pclose);
+        unsigned link_order = 0, attr_order = 0;
+        check(H5Pget_link_creation_order(root_gcpl, &link_order), "could not get link creation order");
+        check(H5Pget_attr_creation_order(root_gcpl, &attr_order), "could not get attribute creation order");
+        check(H5Pset_link_creation_order(fcpl, link_order), "could not set link creation order");
+        check(H5Pset_attr_creation_order(fcpl, attr_order), "could not set attribute creation order");
+
+        Handle dst(checkId(H5Fcreate(output.c_str(), H5F_ACC_EXCL, fcpl, H5P_DEFAULT), "could not create " + output), H5Fclose);
+        Handle dst_root(checkId(H5Gopen(dst, "/", H5P_DEFAULT), "could not open root group"), H5Gclose);
+
+        H5O_info_t root_info;
+        check(H5Oget_info(src_root, &root_info), "could not get object info");
+        std::map<haddr_t, std::string> copied = {{root_info.addr, "/"}};
+
+        copyAttributes(src_root, dst_root);
+        copyGroup(src_root, dst_root, "", copied, opts);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    hsize_t in_size = boost::filesystem::file_size(input);
+    hsize_t out_size = boost::filesystem::file_size(output);
+    out << "repacked " << input << " into " << output << " in " << seconds << " s\n"
+        << "    dataArrays: " << opts.data_sets << " (" << opts.compressed << " compressed)\n"
+        << "    chunksWritten: " << opts.chunks << "\n"
+        << "    size: " << bytes(in_size) << " -> " << bytes(out_size) << "\n";
+
+    if (!vm.count(NOVERIFY_OPTION)) {
+        Handle src(checkId(H5Fopen(input.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT), "could not open " + input), H5Fclose);
+        Handle dst(checkId(H5Fopen(output.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT), "could not open " + output), H5Fclose);
+        Handle src_root(checkId(H5Gopen(src, "/", H5P_DEFAULT), "could not open root group"), H5Gclose);
+        Handle dst_root(checkId(H5Gopen(dst, "/", H5P_DEFAULT), "could not open root group"), H5Gclose);
+        std::map<haddr_t, haddr_t> seen;
+        verify(src_root, dst_root, "", seen);
+        out << "    verified: " << seen.size() << " objects equal\n";
+    }
+
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
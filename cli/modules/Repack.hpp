@@ -0,0 +1,120 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_REPACK_H
+#define CLI_REPACK_H
+
+#include <Cli.hpp>
+#include <modules/IModule.hpp>
+#include <modules/H5Util.hpp>
+
+#include <map>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char *const OUTPUT_OPTION = "output";
+const char *const ACCESS_OPTION = "access";
+const char *const CHUNK_SIZE_OPTION = "chunk-size";
+const char *const COMPRESSION_OPTION = "compression";
+const char *const THREADS_OPTION = "threads";
+const char *const NOVERIFY_OPTION = "no-verify";
+
+/**
+ * @brief How the data of a repacked file is going to be accessed.
+ */
+enum class AccessHint {
+    Sequential,     // front to back along the first axis, e.g. time series
+    Balanced        // blocks of all dimensions, e.g. images or random access
+};
+
+/**
+ * @brief Which data sets to compress on repacking.
+ */
+enum class CompressionPolicy {
+    None,           // no compression
+    Auto,           // deflate, if a sample chunk shrinks by at least 10%
+    Fast,           // deflate level 1
+    Best            // deflate level 9
+};
+
+/**
+ * @brief Settings & statistics of one repack run.
+ */
+struct RepackOptions {
+    AccessHint access = AccessHint::Sequential;
+    CompressionPolicy compression = CompressionPolicy::Auto;
+    hsize_t chunk_size = 256 * 1024;    // target chunk size in bytes
+    size_t threads = 1;                 // compression threads
+
+    size_t data_sets = 0;               // DataArray data sets re-chunked
+    size_t compressed = 0;              // of which compressed
+    size_t chunks = 0;                  // chunks written
+};
+
+class Repack : virtual public IModule {
+
+    /**
+     * @brief Copy an object and everything below it.
+     *
+     * Groups are re-created with their creation properties, attributes
+     * and links in creation order; objects reachable by several hard
+     * links are copied once and linked again. DataArray data sets are
+     * re-chunked, everything else is copied as is.
+     *
+     * @param src_parent group containing the object
+     * @param name link name of the object
+     * @param dst_parent group to copy the object to
+     * @param copied destination path of every object copied so far, by source address
+     * @param dst_path path of the destination parent
+     * @param opts repack settings
+     */
+    void copyLink(hid_t src_parent, const std::string &name, hid_t dst_parent, const std::string &dst_path,
+                  std::map<haddr_t, std::string> &copied, RepackOptions &opts) const;
+
+    void copyGroup(hid_t src, hid_t dst, const std::string &dst_path,
+                   std::map<haddr_t, std::string> &copied, RepackOptions &opts) const;
+
+    /**
+     * @brief Copy a DataArray data set with a new chunk layout.
+     *
+     * Data is copied chunk by chunk: reading, compressing and writing of
+     * different chunks run concurrently on separate threads.
+     */
+    void copyData(hid_t src_parent, const std::string &name, hid_t dst_parent, RepackOptions &opts) const;
+
+    /**
+     * @brief Check that two objects, their attributes and everything
+     *        below them are equal. Throws on the first difference.
+     */
+    void verify(hid_t src, hid_t dst, const std::string &path, std::map<haddr_t, haddr_t> &seen) const;
+
+public:
+
+    static const char* module_name;
+
+    std::string name() const {
+        return std::string(module_name);
+    }
+
+    void load(po::options_description &desc) const;
+
+    std::string call(const po::variables_map &vm, const po::options_description &desc);
+
+};
+
+} // namespace module
+} // namespace cli
+
+#endif
@@ -0,0 +1,393 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <modules/Stat.hpp>
+
+#include <algorithm>
+#include <iomanip>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Stat::module_name = "stat";
+
+// chunks smaller than this cause a lot of per chunk overhead (index entries, filter calls, seeks)
+static const hsize_t SMALL_CHUNK_SIZE = 4096;
+// fragmentation is estimated from at most this many chunks
+static const hsize_t FRAGMENTATION_SAMPLE = 1024;
+
+using namespace h5;
+
+// ---------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------
+
+static std::string typeName(hid_t type) {
+    std::string size = std::to_string(H5Tget_size(type) * 8);
+    switch (H5Tget_class(type)) {
+        case H5T_INTEGER:
+            return (H5Tget_sign(type) == H5T_SGN_NONE ? "uint" : "int") + size;
+        case H5T_FLOAT:
+            return "float" + size;
+        case H5T_STRING:
+            return "string";
+        case H5T_ENUM:
+            return "enum" + size;
+        case H5T_COMPOUND:
+            return "compound";
+        default:
+            return "other";
+    }
+}
+
+template<typename T>
+static std::string list(const std::vector<T> &values) {
+    std::stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < values.size(); i++) {
+        ss << (i ? ", " : "");
+        if (values[i] == H5S_UNLIMITED) {
+            ss << "inf";
+        } else {
+            ss << values[i];
+        }
+    }
+    ss << "]";
+    return ss.str();
+}
+
+template<>
+std::string list(const std::vector<std::string> &values) {
+    std::stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < values.size(); i++) {
+        ss << (i ? ", " : "") << values[i];
+    }
+    ss << "]";
+    return ss.str();
+}
+
+// ---------------------------------------------------------------------
+// Stat
+// ---------------------------------------------------------------------
+
+DataSetStat Stat::statDataSet(hid_t ds, const std::string &name) const {
+    DataSetStat stat;
+    stat.name = name;
+
+    Handle type(checkId(H5Dget_type(ds), "could not get data type"), H5Tclose);
+    Handle space(checkId(H5Dget_space(ds), "could not get data space"), H5Sclose);
+    Handle dcpl(checkId(H5Dget_create_plist(ds), "could not get creation properties"), H5Pclose);
+
+    stat.dtype = typeName(type);
+    int rank = H5Sget_simple_extent_ndims(space);
+    stat.extent.resize(static_cast<size_t>(rank));
+    stat.max_extent.resize(static_cast<size_t>(rank));
+    H5Sget_simple_extent_dims(space, stat.extent.data(), stat.max_extent.data());
+
+    hsize_t elements = static_cast<hsize_t>(H5Sget_simple_extent_npoints(space));
+    hsize_t type_size = H5Tget_size(type);
+    stat.logical_size = elements * type_size;
+    stat.storage_size = H5Dget_storage_size(ds);
+
+    if (H5Pget_layout(dcpl) != H5D_CHUNKED) {
+        stat.chunk_count = stat.storage_size ? 1 : 0;
+        return stat;
+    }
+
+    // chunking & filters
+    stat.chunk.resize(static_cast<size_t>(rank));
+    H5Pget_chunk(dcpl, rank, stat.chunk.data());
+    hsize_t chunk_size = type_size;
+    for (auto c : stat.chunk) {
+        chunk_size *= c;
+    }
+
+    int nfilters = H5Pget_nfilters(dcpl);
+    for (int i = 0; i < nfilters; i++) {
+        unsigned int flags, config;
+        size_t cd_nelmts = 1;
+        unsigned int cd_values[1] = {0};
+        char filter_name[64] = "";
+        H5Z_filter_t filter = H5Pget_filter2(dcpl, static_cast<unsigned>(i), &flags, &cd_nelmts, cd_values,
+                                             sizeof(filter_name), filter_name, &config);
+        std::string desc = filter_name[0] ? filter_name : "filter " + std::to_string(filter);
+        if (filter == H5Z_FILTER_DEFLATE && cd_nelmts > 0) {
+            desc += " " + std::to_string(cd_values[0]);
+        }
+        stat.filters.push_back(desc);
+    }
+
+    // allocated chunks & their placement in the file
+#if H5_VERSION_GE(1, 10, 5)
+    check(H5Dget_num_chunks(ds, space, &stat.chunk_count), "could not get number of chunks");
+
+    // chunks that do not start where their predecessor (in index order) ends
+    // need a seek when reading the data set front to back
+    hsize_t sampled = std::min(stat.chunk_count, FRAGMENTATION_SAMPLE);
+    hsize_t breaks = 0;
+    haddr_t next = HADDR_UNDEF;
+    std::vector<hsize_t> offset(static_cast<size_t>(rank));
+    for (hsize_t i = 0; i < sampled; i++) {
+        unsigned filter_mask;
+        haddr_t addr;
+        hsize_t size;
+        check(H5Dget_chunk_info(ds, space, i, offset.data(), &filter_mask, &addr, &size), "could not get chunk info");
+        if (i > 0 && addr != next) {
+            breaks++;
+        }
+        next = addr + size;
+    }
+    stat.fragmentation = sampled > 1 ? static_cast<double>(breaks) / static_cast<double>(sampled - 1) : 0;
+#else
+    stat.chunk_count = stat.filters.empty() ? stat.storage_size / chunk_size : 0;
+#endif
+
+    // flag pathological layouts
+    if (chunk_size < SMALL_CHUNK_SIZE && stat.logical_size > chunk_size) {
+        stat.flags.push_back("small chunks: " + bytes(chunk_size) + " per chunk (< " + bytes(SMALL_CHUNK_SIZE) + ")");
+    }
+
+    // the append axis is the growable one; if all are, the longest one
+    size_t append_axis = rank;
+    for (size_t d = 0; d < static_cast<size_t>(rank); d++) {
+        if (stat.max_extent[d] == H5S_UNLIMITED || stat.max_extent[d] > stat.extent[d]) {
+            if (append_axis == static_cast<size_t>(rank) || stat.extent[d] > stat.extent[append_axis]) {
+                append_axis = d;
+            }
+        }
+    }
+    if (append_axis < static_cast<size_t>(rank)) {
+        // chunks not spanning the full extent of the other axes: each append touches several chunks
+        hsize_t touched = 1;
+        for (size_t d = 0; d < static_cast<size_t>(rank); d++) {
+            if (d != append_axis && stat.chunk[d] && stat.chunk[d] < stat.extent[d]) {
+                touched *= (stat.extent[d] + stat.chunk[d] - 1) / stat.chunk[d];
+            }
+        }
+        if (touched > 1) {
+            stat.flags.push_back("chunks cut across append axis " + std::to_string(append_axis) +
+                                 ": each append touches " + std::to_string(touched) + " chunks");
+        }
+    }
+
+    if (stat.chunk_count > 1 && stat.fragmentation > 0.5) {
+        std::stringstream ss;
+        ss << "fragmented: " << std::setprecision(0) << std::fixed << stat.fragmentation * 100
+           << "% of chunks are not contiguous";
+        stat.flags.push_back(ss.str());
+    }
+
+    if (stat.filters.empty() && stat.storage_size > 2 * stat.logical_size && stat.storage_size > SMALL_CHUNK_SIZE) {
+        stat.flags.push_back("storage overhead: " + bytes(stat.storage_size) + " allocated for " +
+                             bytes(stat.logical_size) + " of data");
+    }
+
+    return stat;
+}
+
+
+void Stat::statObject(hid_t obj, GroupStat &stat) const {
+    H5O_info_t info;
+#if H5_VERSION_GE(1, 10, 3)
+    check(H5Oget_info2(obj, &info, H5O_INFO_BASIC | H5O_INFO_HDR | H5O_INFO_META_SIZE | H5O_INFO_NUM_ATTRS),
+          "could not get object info");
+#else
+    check(H5Oget_info(obj, &info), "could not get object info");
+#endif
+
+    if (!stat.visited.insert(info.addr).second) {
+        return;
+    }
+
+    stat.attributes += static_cast<size_t>(info.num_attrs);
+    stat.metadata_size += info.hdr.space.total +
+                          info.meta_size.obj.index_size + info.meta_size.obj.heap_size +
+                          info.meta_size.attr.index_size + info.meta_size.attr.heap_size;
+
+    if (info.type == H5O_TYPE_DATASET) {
+        stat.datasets++;
+        return;
+    }
+    if (info.type != H5O_TYPE_GROUP) {
+        return;
+    }
+
+    stat.groups++;
+    for (const auto &name : linkNames(obj)) {
+        stat.links++;
+        H5L_info_t linfo;
+        check(H5Lget_info(obj, name.c_str(), &linfo, H5P_DEFAULT), "could not get link info");
+        if (linfo.type != H5L_TYPE_HARD || name == "metadata") {
+            continue; // do not follow soft & external links, sections are counted under /metadata
+        }
+        Handle child(checkId(H5Oopen(obj, name.c_str(), H5P_DEFAULT), "could not open " + name), H5Oclose);
+        statObject(child, stat);
+    }
+}
+
+
+void Stat::write(std::ostream &out, const DataSetStat &stat) const {
+    const char *indent = "            ";
+    out << "        - data_array " << stat.name << ":\n"
+        << indent << "dataType: " << stat.dtype << "\n"
+        << indent << "extent: " << list(stat.extent) << "\n"
+        << indent << "maxExtent: " << list(stat.max_extent) << "\n"
+        << indent << "chunk: " << (stat.chunk.empty() ? "contiguous" : list(stat.chunk)) << "\n"
+        << indent << "filters: " << list(stat.filters) << "\n"
+        << indent << "logicalSize: " << bytes(stat.logical_size) << "\n"
+        << indent << "storageSize: " << bytes(stat.storage_size);
+    if (stat.logical_size && stat.storage_size) {
+        out << " (" << std::setprecision(2) << std::fixed
+            << static_cast<double>(stat.storage_size) / static_cast<double>(stat.logical_size) << "x)";
+    }
+    out << "\n"
+        << indent << "chunkCount: " << stat.chunk_count << "\n"
+        << indent << "fragmentation: " << std::setprecision(2) << std::fixed << stat.fragmentation << "\n";
+    if (!stat.flags.empty()) {
+        out << indent << "flags:\n";
+        for (const auto &flag : stat.flags) {
+            out << indent << "    - " << flag << "\n";
+        }
+    }
+}
+
+
+void Stat::write(std::ostream &out, const GroupStat &stat) const {
+    const char *indent = "        ";
+    // every entity is a group
+    double entities = static_cast<double>(std::max<size_t>(stat.groups, 1));
+    out << indent << "groups: " << stat.groups << "\n"
+        << indent << "datasets: " << stat.datasets << "\n"
+        << indent << "attributes: " << stat.attributes
+        << " (" << std::setprecision(1) << std::fixed << stat.attributes / entities << " per group)\n"
+        << indent << "links: " << stat.links
+        << " (" << std::setprecision(1) << std::fixed << stat.links / entities << " per group)\n"
+        << indent << "metadataSize: " << bytes(stat.metadata_size)
+        << " (" << bytes(static_cast<hsize_t>(stat.metadata_size / entities)) << " per group)\n";
+}
+
+
+void Stat::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Report storage layout, chunking, compression and metadata overhead of a given nix-file.\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (FLAGGED_OPTION, "report only DataArrays with a pathological layout")
+    ;
+    desc.add(opt);
+}
+
+
+std::string Stat::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+    // --input-file
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+
+    bool flagged_only = vm.count(FLAGGED_OPTION) > 0;
+
+    for (auto &file_path : vm[INPFILE_OPTION].as< std::vector<std::string> >()) {
+        // file exists?
+        if (!boost::filesystem::exists(file_path)) {
+            throw FileNotFound(file_path);
+        }
+        // the storage layout is not part of the nix API: look at the hdf5 file directly
+        hid_t fid = H5Fopen(file_path.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        if (fid < 0 || !hasObject(fid, "data", H5O_TYPE_GROUP) || !hasObject(fid, "metadata", H5O_TYPE_GROUP)) {
+            if (fid >= 0) {
+                H5Fclose(fid);
+            }
+            throw FileNotOpen(file_path);
+        }
+        Handle file(fid, H5Fclose);
+
+        hsize_t file_size = 0;
+        H5Fget_filesize(file, &file_size);
+        hssize_t free_space = H5Fget_freespace(file);
+
+        out << "file " << file_path << ":\n"
+            << "    fileSize: " << bytes(file_size) << "\n"
+            << "    freeSpace: " << bytes(free_space > 0 ? static_cast<hsize_t>(free_space) : 0) << "\n";
+
+        hsize_t logical_total = 0;
+        hsize_t storage_total = 0;
+        size_t array_count = 0;
+        size_t flagged_count = 0;
+
+        // Blocks
+        out << "    blocks:\n";
+        Handle data(checkId(H5Gopen(file, "data", H5P_DEFAULT), "could not open /data"), H5Gclose);
+        for (const auto &block_name : linkNames(data)) {
+            Handle block(checkId(H5Gopen(data, block_name.c_str(), H5P_DEFAULT), "could not open block " + block_name), H5Gclose);
+            GroupStat group_stat;
+            statObject(block, group_stat);
+
+            out << "    - block " << block_name << ":\n";
+            write(out, group_stat);
+
+            // DataArrays
+            out << "        data_arrays:\n";
+            if (!hasObject(block, "data_arrays", H5O_TYPE_GROUP)) {
+                continue;
+            }
+            Handle arrays(checkId(H5Gopen(block, "data_arrays", H5P_DEFAULT), "could not open data_arrays"), H5Gclose);
+            for (const auto &array_name : linkNames(arrays)) {
+                Handle array(checkId(H5Gopen(arrays, array_name.c_str(), H5P_DEFAULT), "could not open " + array_name), H5Gclose);
+                if (!hasObject(array, "data", H5O_TYPE_DATASET)) {
+                    continue; // no data written yet
+                }
+                Handle ds(checkId(H5Dopen(array, "data", H5P_DEFAULT), "could not open data of " + array_name), H5Dclose);
+                DataSetStat ds_stat = statDataSet(ds, array_name);
+
+                array_count++;
+                logical_total += ds_stat.logical_size;
+                storage_total += ds_stat.storage_size;
+                if (!ds_stat.flags.empty()) {
+                    flagged_count++;
+                }
+                if (!flagged_only || !ds_stat.flags.empty()) {
+                    write(out, ds_stat);
+                }
+            }
+        }
+
+        // Sections
+        GroupStat metadata_stat;
+        Handle metadata(checkId(H5Gopen(file, "metadata", H5P_DEFAULT), "could not open /metadata"), H5Gclose);
+        statObject(metadata, metadata_stat);
+        out << "    metadata:\n";
+        write(out, metadata_stat);
+
+        out << "    summary:\n"
+            << "        dataArrays: " << array_count << "\n"
+            << "        flaggedDataArrays: " << flagged_count << "\n"
+            << "        logicalDataSize: " << bytes(logical_total) << "\n"
+            << "        storedDataSize: " << bytes(storage_total) << "\n"
+            << "        otherSize: " << bytes(file_size > storage_total ? file_size - storage_total : 0)
+            << " (metadata, free space & file overhead)\n";
+    }
+
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
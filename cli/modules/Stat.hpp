@@ -0,0 +1,105 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_STAT_H
+#define CLI_STAT_H
+
+#include <Cli.hpp>
+#include <modules/IModule.hpp>
+#include <modules/H5Util.hpp>
+
+#include <set>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char *const FLAGGED_OPTION = "flagged";
+
+/**
+ * @brief Storage statistics of the data set of a DataArray.
+ */
+struct DataSetStat {
+    std::string name;
+    std::string dtype;
+    std::vector<hsize_t> extent;
+    std::vector<hsize_t> max_extent;
+    std::vector<hsize_t> chunk;         // empty if not chunked
+    std::vector<std::string> filters;
+    hsize_t logical_size = 0;           // bytes of data as seen by the user
+    hsize_t storage_size = 0;           // bytes allocated in the file
+    hsize_t chunk_count = 0;            // number of allocated chunks
+    double fragmentation = 0;           // share of chunks not following their predecessor in the file
+    std::vector<std::string> flags;
+};
+
+/**
+ * @brief Object counts and metadata size of a group and everything below it.
+ */
+struct GroupStat {
+    size_t groups = 0;
+    size_t datasets = 0;
+    size_t attributes = 0;
+    size_t links = 0;
+    hsize_t metadata_size = 0;          // object headers, link & attribute heaps and indexes
+    std::set<haddr_t> visited;          // objects already counted (entities are linked from several places)
+};
+
+class Stat : virtual public IModule {
+
+    /**
+     * @brief collect layout, size and chunk statistics of a data set
+     *
+     * Also flags pathological layouts, like tiny chunks or chunks that
+     * cut across the append axis.
+     *
+     * @param ds open data set
+     * @param name name to report the data set under
+     * @return the collected statistics
+     */
+    DataSetStat statDataSet(hid_t ds, const std::string &name) const;
+
+    /**
+     * @brief add object counts and metadata size of an object and all
+     *        objects below it
+     *
+     * Objects reachable by several hard links are only counted once.
+     *
+     * @param obj open object (group or data set)
+     * @param stat statistics to add to
+     * @return void
+     */
+    void statObject(hid_t obj, GroupStat &stat) const;
+
+    void write(std::ostream &out, const DataSetStat &stat) const;
+
+    void write(std::ostream &out, const GroupStat &stat) const;
+
+public:
+
+    static const char* module_name;
+
+    std::string name() const {
+        return std::string(module_name);
+    }
+
+    void load(po::options_description &desc) const;
+
+    std::string call(const po::variables_map &vm, const po::options_description &desc);
+
+};
+
+} // namespace module
+} // namespace cli
+
+#endif
@@ -11,6 +11,8 @@
 #include <nix/None.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+
+#include <thread>
 namespace po = boost::program_options;
 
 namespace cli {
@@ -59,7 +61,8 @@ std::string Validate::call(const po::variables_map &vm, const po::options_descri
         }
         for (auto &nix_file : files) {
             out << "validating file " << nix_file.location() << std::endl;
-            nix::valid::Result res = nix_file.validate();
+            // the files are opened read only, so they can be validated concurrently
+            nix::valid::Result res = nix_file.validate(std::thread::hardware_concurrency());
             if (vm.count(NOWARN_OPTION)) {
                 res = nix::valid::Result(res.getErrors(), boost::none);
             }
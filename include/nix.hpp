@@ -22,6 +22,11 @@
 #include <nix/Tag.hpp>
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/IntervalIndex.hpp>
+#include <nix/DataAppender.hpp>
+#include <nix/util/trace.hpp>
+#include <nix/util/reduce.hpp>
 
 
 
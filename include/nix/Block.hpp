@@ -328,13 +328,15 @@ public:
     * @param type      The type of the data array.
     * @param data_type A nix::DataType indicating the format to store values.
     * @param shape     A NDSize holding the extent of the array to create.
+    * @param compression Whether to compress the data of the array.
     *
     * @return The newly created data array.
     */
     DataArray createDataArray(const std::string &name,
                               const std::string &type,
                               nix::DataType      data_type,
-                              const NDSize      &shape);
+                              const NDSize      &shape,
+                              Compression        compression = Compression::None);
 
     /**
     * @brief Create a new data array associated with this block.
@@ -343,6 +345,7 @@ public:
     * @param type      The type of the data array.
     * @param data      Data to create array with.
     * @param data_type A optional nix::DataType indicating the format to store values.
+    * @param compression Whether to compress the data of the array.
     *
     * Create a data array with shape and type inferred from data. After
     * successful creation, the contents of data will be written to the
@@ -355,7 +358,8 @@ public:
     DataArray createDataArray(const std::string &name,
                               const std::string &type,
                               const T &data,
-                              DataType data_type = DataType::Nothing) {
+                              DataType data_type = DataType::Nothing,
+                              Compression compression = Compression::None) {
          const Hydra<const T> hydra(data);
 
          if (data_type == DataType::Nothing) {
@@ -363,7 +367,7 @@ public:
          }
 
          const NDSize shape = hydra.shape();
-         DataArray da = createDataArray(name, type, data_type, shape);
+         DataArray da = createDataArray(name, type, data_type, shape, compression);
 
          const NDSize offset(shape.size(), 0);
          da.setData(data, offset);
@@ -371,6 +375,19 @@ public:
          return da;
     }
 
+    /**
+    * @brief Create several new data arrays associated with this block at once.
+    *
+    * All names and types are validated and checked for uniqueness (against the
+    * existing data arrays and within the batch) before anything is written.
+    * This is considerably faster than calling {@link createDataArray} in a loop.
+    *
+    * @param specs     Name, type, data type and shape of each array to create.
+    *
+    * @return The newly created data arrays, in the order of the specs.
+    */
+    std::vector<DataArray> createDataArrays(const std::vector<DataArraySpec> &specs);
+
     /**
      * @brief Deletes a data array from this block.
      *
@@ -397,6 +414,74 @@ public:
     */
     bool deleteDataArray(const DataArray &data_array);
 
+    /**
+     * @brief Copy a data array, possibly of another block or file, into
+     *        this block.
+     *
+     * The data, its chunks and compression, the dimensions and the
+     * envelope are copied as stored, without decoding the data. The
+     * sources of the data array are linked to the sources of this block
+     * with the same id. A source that this block lacks is copied along
+     * with those of its parents the block lacks, so that it keeps its
+     * place in the source tree. Likewise, the metadata is linked to the
+     * section of this file with the same id or copied.
+     *
+     * Only data arrays of files of the hdf5 backend can be copied into
+     * blocks of such files. Copies within the same file always get new
+     * ids, since ids are unique within a file.
+     *
+     * @param data_array    The data array to copy.
+     * @param name          The name of the copy, empty for the name of
+     *                      the data array.
+     * @param ids           Whether the copied entities keep their ids.
+     *
+     * @return The copy.
+     *
+     * @throws nix::DuplicateName If the block has a data array of that name,
+     *         or a copied source or section would replace another one.
+     */
+    DataArray copyDataArray(const DataArray &data_array, const std::string &name = "",
+                            CopyIds ids = CopyIds::Keep);
+
+    /**
+     * @brief Create a data array whose data is the concatenation of the
+     *        data of other data arrays, possibly of other files, along
+     *        an axis.
+     *
+     * The data is a virtual data set of the hdf5 backend: it maps the
+     * data of the parts without copying it, and reading it reads from
+     * the files of the parts. The parts are mapped with their extents at
+     * the time of the call, so later growth of a part is not seen.
+     * A part in the directory of this file is found by its file name,
+     * so the files can be moved together; any other part by its absolute
+     * path. Where the file of a part cannot be opened, the data reads as
+     * the fill value.
+     *
+     * The parts must agree in data type, unit, polynom and expansion
+     * origin, in their extent along all other axes and in the types of
+     * their dimensions. The dimension of the axis is composed of those
+     * of the parts: sampled dimensions must share interval and unit and
+     * follow each other without gap or overlap, the ticks of range
+     * dimensions and the labels of set dimensions are concatenated. All
+     * other dimensions, the label and the unit are those of the first part.
+     *
+     * Only data arrays of files of the hdf5 backend can be parts.
+     *
+     * @param name      The name of the data array.
+     * @param type      The type of the data array.
+     * @param parts     The data arrays to concatenate, in order.
+     * @param axis      The axis along which to concatenate.
+     *
+     * @return The virtual data array.
+     *
+     * @throws nix::DuplicateName If the block has a data array of that name.
+     * @throws nix::InvalidRank If the axis exceeds the rank of the parts.
+     * @throws nix::IncompatibleDimensions If the parts do not fit together.
+     * @throws nix::UnsortedTicks If the concatenated ticks are not ascending.
+     */
+    DataArray createVirtualDataArray(const std::string &name, const std::string &type,
+                                     const std::vector<DataArray> &parts, size_t axis = 0);
+
     //--------------------------------------------------
     // Methods concerning tags.
     //--------------------------------------------------
@@ -476,6 +561,18 @@ public:
     Tag createTag(const std::string &name, const std::string &type,
                               const std::vector<double> &position);
 
+    /**
+     * @brief Create several new tags associated with this block at once.
+     *
+     * All names and types are validated and checked for uniqueness (against
+     * the existing tags and within the batch) before anything is written.
+     *
+     * @param specs     Name, type and position of each tag to create.
+     *
+     * @return The newly created tags, in the order of the specs.
+     */
+    std::vector<Tag> createTags(const std::vector<TagSpec> &specs);
+
     /**
      * @brief Deletes a tag from the block.
      *
@@ -0,0 +1,26 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_COMPRESSION_H
+#define NIX_COMPRESSION_H
+
+namespace nix {
+
+/**
+ * @brief The compression of the data of a {@link nix::DataArray}.
+ */
+enum class Compression : int {
+    /** @brief Store the data as is. */
+    None = 0,
+    /** @brief Compress each chunk of the data with deflate at its default level. */
+    DeflateNormal
+};
+
+} // namespace nix
+
+#endif // NIX_COMPRESSION_H
@@ -0,0 +1,30 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_COPY_IDS_H
+#define NIX_COPY_IDS_H
+
+namespace nix {
+
+/**
+ * @brief The ids of the entities created by {@link nix::File::copyBlock}
+ *        and {@link nix::Block::copyDataArray}.
+ */
+enum class CopyIds : int {
+    /** @brief The copies have the ids of the originals, unless they are
+     *         copied within the same file. */
+    Keep = 0,
+    /** @brief The copied entities get new ids. Sources and sections
+     *         copied along into another file keep theirs, so that later
+     *         copies link to them. */
+    Regenerate
+};
+
+} // namespace nix
+
+#endif // NIX_COPY_IDS_H
@@ -0,0 +1,94 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_APPENDER_H
+#define NIX_DATA_APPENDER_H
+
+#include <nix/DataArray.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Appends rows along the first dimension of a data array in
+ *        multiples of its chunk rows.
+ *
+ * Rows passed to {@link append} are collected until they fill whole
+ * chunks, which are then appended at once. If the data array ends at a
+ * chunk boundary, every append then writes whole chunks, which a file
+ * with several {@link nix::File::filterThreads} compresses in parallel.
+ * The remaining rows are appended by {@link flush}, which also runs when
+ * the appender is destroyed.
+ *
+ * Data arrays that are not stored in chunks are appended to in blocks of
+ * a default number of rows.
+ */
+class NIXAPI DataAppender {
+public:
+
+    /**
+     * @brief Create an appender for a data array.
+     *
+     * @param array     The data array, with at least one dimension.
+     * @param dtype     The type of the rows passed to append.
+     *
+     * @throws nix::InvalidRank If the data array has no dimensions.
+     * @throws std::invalid_argument If dtype is a string type.
+     */
+    DataAppender(const DataArray &array, DataType dtype);
+
+    // a copy would append the collected rows a second time when destroyed
+    DataAppender(const DataAppender &other) = delete;
+    DataAppender &operator=(const DataAppender &other) = delete;
+
+    /**
+     * @brief Append rows to the data array.
+     *
+     * @param data      The rows, in row-major order.
+     * @param rows      The number of rows.
+     */
+    void append(const void *data, ndsize_t rows);
+
+    /**
+     * @brief Append the collected rows that do not fill a chunk.
+     */
+    void flush();
+
+    /**
+     * @brief The number of rows collected but not yet appended.
+     */
+    ndsize_t pending() const {
+        return row_bytes > 0 ? buffer.size() / row_bytes : 0;
+    }
+
+    /**
+     * @brief The number of rows appended at once.
+     */
+    ndsize_t blockRows() const {
+        return block_rows;
+    }
+
+    ~DataAppender();
+
+private:
+
+    void write(const unsigned char *data, ndsize_t rows);
+
+    DataArray array;
+    DataType dtype;
+    NDSize row_shape;
+    size_t row_bytes;
+    ndsize_t block_rows;
+    std::vector<unsigned char> buffer;
+};
+
+} // namespace nix
+
+#endif
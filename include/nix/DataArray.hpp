@@ -17,10 +17,37 @@
 #include <nix/Hydra.hpp>
 
 #include <nix/Platform.hpp>
+#include <nix/util/trace.hpp>
 
 
 namespace nix {
 
+class Tag;
+class MultiTag;
+class Feature;
+class Group;
+
+/**
+ * @brief The minimum, maximum and mean of consecutive buckets of samples
+ *        of a {@link nix::DataArray}, along its first dimension.
+ *
+ * The values of bucket b and value v of a sample are at index
+ * b * values + v of min, max and mean.
+ */
+struct NIXAPI Envelope {
+    /** @brief The index of the first sample of the first bucket. */
+    ndsize_t offset;
+    /** @brief The number of samples per bucket; the last may hold fewer. */
+    ndsize_t bucketSize;
+    /** @brief The number of buckets. */
+    ndsize_t buckets;
+    /** @brief The number of values per sample, 1 for 1-D data. */
+    ndsize_t values;
+    std::vector<double> min;
+    std::vector<double> max;
+    std::vector<double> mean;
+};
+
 // TODO add documentation for undocumented methods.
 
 /**
@@ -285,6 +312,7 @@ public:
      * @return The dimension object.
      */
     Dimension getDimension(ndsize_t id) const {
+        util::TraceSpan span("DataArray::getDimension");
         return backend()->getDimension(id);
     }
 
@@ -427,10 +455,7 @@ public:
     void setDataDirect(DataType dtype,
                        const void *data,
                        const NDSize &count,
-                       const NDSize &offset)
-    {
-        backend()->write(dtype, data, count, offset);
-    }
+                       const NDSize &offset);
 
 
     /**
@@ -445,10 +470,22 @@ public:
     /**
      * @brief Set the data extent of the DataArray entity.
      *
+     * A stored envelope is rebuilt if samples are removed or their shape
+     * changes.
+     *
      * @param extent    The extent of the data.
      */
-    void dataExtent(const NDSize &extent) {
-        backend()->dataExtent(extent);
+    void dataExtent(const NDSize &extent);
+
+    /**
+     * @brief Get the shape of the chunks the data is stored in.
+     *
+     * Reading whole chunks avoids decoding a chunk more than once.
+     *
+     * @return The chunk shape, empty if the data is not stored in chunks.
+     */
+    NDSize dataChunking() const {
+        return backend()->dataChunking();
     }
 
     /**
@@ -462,6 +499,182 @@ public:
 
     void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis);
 
+    /**
+     * @brief Get the offset and count of the data between physical positions.
+     *
+     * Each dimension is resolved through its dimension descriptor, like the
+     * position and extent of a {@link nix::Tag}: the range of dimension i
+     * starts at the index of start[i] and ends before the index of stop[i],
+     * but holds at least one element. Positions of set dimensions are
+     * indices.
+     *
+     * @param start         The start of the range in each dimension.
+     * @param stop          The end of the range in each dimension.
+     * @param units         The units of start and stop per dimension, "none"
+     *                      or missing for positions without unit.
+     * @param[out] offset   The offset of the range.
+     * @param[out] count    The number of elements in each dimension.
+     *
+     * @throws nix::IncompatibleDimensions If the number of positions does not
+     *         match the dimensionality or a unit does not fit a dimension.
+     * @throws nix::OutOfBounds If the range is not within the data.
+     */
+    void rangeToOffsetAndCount(const std::vector<double> &start,
+                               const std::vector<double> &stop,
+                               const std::vector<std::string> &units,
+                               NDSize &offset,
+                               NDSize &count) const;
+
+    /**
+     * @brief Read the data between physical positions with a single read.
+     *
+     * The range is resolved as by {@link rangeToOffsetAndCount}; polynomial
+     * coefficients and expansion origin are applied as by getData.
+     *
+     * ~~~
+     * DataArray da = ...; // time x channel
+     * std::vector<double> data;
+     * da.getDataInRange(data, {12.5, 7}, {13.0, 7}, {"s", "none"});
+     * ~~~
+     *
+     * @param value         The container the data is read into; it is resized
+     *                      to the range.
+     * @param start         The start of the range in each dimension.
+     * @param stop          The end of the range in each dimension.
+     * @param units         The units of start and stop per dimension.
+     */
+    template<typename T>
+    void getDataInRange(T &value,
+                        const std::vector<double> &start,
+                        const std::vector<double> &stop,
+                        const std::vector<std::string> &units = {}) const;
+
+    /**
+     * @brief Read the data between physical positions into a buffer of the
+     *        size of the range.
+     */
+    void getDataInRange(DataType dtype,
+                        void *data,
+                        const std::vector<double> &start,
+                        const std::vector<double> &stop,
+                        const std::vector<std::string> &units = {}) const;
+
+    /**
+     * @brief Read the data between physical positions into a region of a
+     *        larger buffer, for example one column of a matrix that collects
+     *        several ranges.
+     *
+     * @param dtype          The type of the buffer.
+     * @param data           The buffer.
+     * @param buffer_extent  The shape of the buffer, of the same rank as the data.
+     * @param buffer_offset  The position in the buffer where the range is placed.
+     * @param start          The start of the range in each dimension.
+     * @param stop           The end of the range in each dimension.
+     * @param units          The units of start and stop per dimension.
+     */
+    void getDataInRange(DataType dtype,
+                        void *data,
+                        const NDSize &buffer_extent,
+                        const NDSize &buffer_offset,
+                        const std::vector<double> &start,
+                        const std::vector<double> &stop,
+                        const std::vector<std::string> &units = {}) const;
+
+    //--------------------------------------------------
+    // Methods concerning the envelope.
+    //--------------------------------------------------
+
+    /**
+     * @brief Store a pyramid of per-bucket minimum, maximum and mean of the
+     *        data along its first dimension, which must be sampled.
+     *
+     * Level 1 holds buckets of factor samples, each further level buckets of
+     * factor buckets of the level below, up to a level with one bucket. The
+     * levels are stored beside the data and the buckets of written samples
+     * are updated by every write through the DataArray; changes of the
+     * polynomial or of the data made by other means require building the
+     * envelope again. Values are calibrated like those of getData.
+     *
+     * @param factor    The decimation factor between levels, at least 2.
+     */
+    void buildEnvelope(ndsize_t factor = 16);
+
+    /**
+     * @brief Whether the data array has a stored envelope.
+     */
+    bool hasEnvelope() const {
+        return backend()->envelopeFactor() > 0;
+    }
+
+    /**
+     * @brief Remove the stored envelope.
+     */
+    bool deleteEnvelope() {
+        return backend()->deleteEnvelope();
+    }
+
+    /**
+     * @brief Get the envelope of the samples [begin, end) with at least
+     *        target_points buckets, if there are as many samples.
+     *
+     * Reads the coarsest stored level with enough buckets, so the amount
+     * of data read is about factor * target_points. Without a stored
+     * envelope, or if the range is too short for level 1, the samples are
+     * read and reduced. Buckets of a stored level start at multiples of
+     * its bucket size, so the envelope may start before begin.
+     */
+    Envelope readEnvelopeIndices(ndsize_t begin, ndsize_t end, size_t target_points) const;
+
+    /**
+     * @brief Get the envelope of the range from start to end of the first
+     *        dimension, clamped to the data.
+     *
+     * @param start         The start of the range.
+     * @param end           The end of the range.
+     * @param target_points The minimum number of buckets.
+     * @param unit          The unit of start and end.
+     */
+    Envelope readEnvelope(double start, double end, size_t target_points,
+                          const std::string &unit = "none") const;
+
+    //--------------------------------------------------
+    // Methods concerning referencing entities.
+    //--------------------------------------------------
+
+    /**
+     * @brief Get all tags of the block that reference this data array.
+     *
+     * With the hdf5 backend the first query on a block builds an index of
+     * all links to its data arrays, which later queries and modifications
+     * use and keep up to date.
+     *
+     * @return The referencing tags.
+     */
+    std::vector<Tag> referencingTags() const;
+
+    /**
+     * @brief Get all multi tags of the block that reference this data array
+     *        or use it as their positions or extents.
+     *
+     * @return The referencing multi tags.
+     */
+    std::vector<MultiTag> referencingMultiTags() const;
+
+    /**
+     * @brief Get all features of the tags and multi tags of the block that
+     *        link to this data array.
+     *
+     * @return The referencing features.
+     */
+    std::vector<Feature> referencingFeatures() const;
+
+    /**
+     * @brief Get all groups of the block that contain this data array.
+     *
+     * @return The referencing groups.
+     */
+    std::vector<Group> referencingGroups() const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -491,8 +704,29 @@ protected:
                  const void *data,
                  const NDSize &count,
                  const NDSize &offset);
+
+private:
+    // recompute the buckets of the envelope containing the samples [from, to)
+    void updateEnvelope(ndsize_t from, ndsize_t to);
 };
 
+
+template<typename T>
+void DataArray::getDataInRange(T &value,
+                               const std::vector<double> &start,
+                               const std::vector<double> &stop,
+                               const std::vector<std::string> &units) const
+{
+    NDSize offset, count;
+    rangeToOffsetAndCount(start, stop, units, offset, count);
+
+    Hydra<T> hydra(value);
+    DataType dtype = hydra.element_data_type();
+
+    hydra.resize(count);
+    getData(dtype, hydra.data(), count, offset);
+}
+
 } // namespace nix
 
 #endif // NIX_DATA_ARRAY_H
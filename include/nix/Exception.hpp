@@ -91,6 +91,9 @@ class InvalidFile: public std::invalid_argument {
 public:
     InvalidFile(const std::string &caller):
         std::invalid_argument("Invalid file - file is not a nix file. (" + caller + ")") { }
+
+    InvalidFile(const std::string &what, const std::string &caller):
+        std::invalid_argument("Invalid file - " + what + ". (" + caller + ")") { }
 };
 
 
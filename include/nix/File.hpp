@@ -20,6 +20,24 @@
 namespace nix {
 
 
+/**
+ * @brief A NIX file, the root of the entity tree.
+ *
+ * ### Thread safety
+ *
+ * A file opened with {@link nix::FileMode::ReadOnly} by the HDF5 backend may be
+ * read from several threads at the same time. The file object, all entities
+ * obtained from it and copies of those may be shared between threads and used
+ * concurrently for any read operation. Internally every call into the HDF5
+ * library is serialized by a single process wide lock, so the HDF5 part of the
+ * work does not run in parallel; decoding and everything else done by the
+ * calling threads does.
+ *
+ * A file that is modified must only be used by one thread at a time, including
+ * reads. Different files can be used on different threads independently. A file
+ * must not be closed while other threads still use it. The filesystem backend
+ * gives no thread safety guarantees.
+ */
 class NIXAPI File : public base::ImplContainer<base::IFile> {
 
 public:
@@ -181,6 +199,31 @@ public:
      */
     bool deleteBlock(const Block &block);
 
+    /**
+     * @brief Copy a block, possibly of another file, into this file.
+     *
+     * All entities of the block are copied, the data of the data arrays
+     * as stored, so compressed chunks are not decoded. The metadata of
+     * the copied entities is linked to the sections of this file with
+     * the same id. A section that this file lacks is copied along with
+     * those of its parents the file lacks, so that it keeps its place in
+     * the section tree.
+     *
+     * Only blocks of files of the hdf5 backend can be copied into such
+     * files. Copies within the same file always get new ids, since ids
+     * are unique within a file.
+     *
+     * @param block   The block to copy.
+     * @param name    The name of the copy, empty for the name of the block.
+     * @param ids     Whether the copied entities keep their ids.
+     *
+     * @return The copy.
+     *
+     * @throws nix::DuplicateName If the file has a block of that name, or
+     *         a copied section would replace another one.
+     */
+    Block copyBlock(const Block &block, const std::string &name = "", CopyIds ids = CopyIds::Keep);
+
     /**
      * @brief Get all blocks within this file.
      *
@@ -468,6 +511,137 @@ public:
     FileMode fileMode() {
         return backend()->fileMode();
     }
+
+    /**
+     * @brief Defer writing the updated_at time stamps of entities.
+     *
+     * By default every modification of an entity immediately rewrites its
+     * updated_at attribute. With deferred time stamps the time of the last
+     * modification of each entity is only kept in memory and written once
+     * per entity when the file is flushed or closed, which saves a metadata
+     * write for every setter call when files are created programmatically.
+     * {@link nix::base::IEntity::updatedAt} returns the pending time stamp
+     * in the meantime. Disabling the mode writes all pending time stamps.
+     *
+     * Backends that write time stamps cheaply may ignore this setting.
+     *
+     * @param defer     True to defer time stamps, false to write them immediately.
+     */
+    void deferTimestamps(bool defer) {
+        backend()->deferTimestamps(defer);
+    }
+
+    /**
+     * @brief Whether updated_at time stamps are deferred until the file
+     * is flushed or closed.
+     *
+     * @return True if time stamps are deferred.
+     */
+    bool deferTimestamps() const {
+        return backend()->deferTimestamps();
+    }
+
+    /**
+     * @brief Store the values of new properties in compact layouts.
+     *
+     * By default the values of a property are stored together with their
+     * uncertainty, reference, filename, encoder and checksum, even if these
+     * are empty. In compact mode properties created from values only store
+     * the fields that these values use. Values that need more fields than
+     * a compact property stores cannot be written to it later. The first
+     * compact property raises the format version of the file to 1.2, which
+     * libraries older than format version 1.2 can not read.
+     *
+     * Backends without compact layouts ignore this setting.
+     *
+     * @param compact   True to store the values of new properties compactly.
+     */
+    void compactProperties(bool compact) {
+        backend()->compactProperties(compact);
+    }
+
+    /**
+     * @brief Whether the values of new properties are stored compactly.
+     *
+     * @return True if new properties use compact layouts.
+     */
+    bool compactProperties() const {
+        return backend()->compactProperties();
+    }
+
+    /**
+     * @brief Collect statistics of the storage calls made for this file.
+     *
+     * When enabled, the backend counts its calls to the storage library
+     * by type, together with the time spent in them, the bytes read and
+     * written and the number of data sets and groups opened. Collection
+     * is off by default and costs next to nothing while off. Disabling
+     * it keeps the counters collected so far.
+     *
+     * Backends without instrumentation ignore this setting.
+     *
+     * @param collect   True to start collecting, false to stop.
+     */
+    void collectIOStatistics(bool collect) {
+        backend()->collectIOStatistics(collect);
+    }
+
+    /**
+     * @brief Whether statistics of the storage calls are collected.
+     *
+     * @return True if statistics are collected.
+     */
+    bool collectIOStatistics() const {
+        return backend()->collectIOStatistics();
+    }
+
+    /**
+     * @brief The storage call statistics collected since collection was
+     *        enabled or last reset.
+     *
+     * @return The statistics; all zero if nothing was collected.
+     */
+    IOStatistics ioStatistics() const {
+        return backend()->ioStatistics();
+    }
+
+    /**
+     * @brief Set all storage call statistics back to zero.
+     */
+    void resetIOStatistics() {
+        backend()->resetIOStatistics();
+    }
+
+    /**
+     * @brief Set the number of threads that compress and decompress the
+     *        chunks of compressed data arrays.
+     *
+     * With more than one thread, reads of several deflate compressed
+     * chunks fetch the compressed chunks from the file one after the
+     * other and decompress them on that many threads, instead of having
+     * the storage library decompress them one by one. Likewise, writes
+     * of whole chunks, such as appends of a multiple of the chunk rows
+     * to data that ends at a chunk boundary, compress the chunks on that
+     * many threads and store them as they are. The default is one
+     * thread, which leaves the compression to the storage library.
+     *
+     * Backends without compression ignore this setting.
+     *
+     * @param threads   The number of threads, 0 for the number of cores.
+     */
+    void filterThreads(size_t threads) {
+        backend()->filterThreads(threads);
+    }
+
+    /**
+     * @brief The number of threads that compress and decompress chunks.
+     *
+     * @return The number of threads.
+     */
+    size_t filterThreads() const {
+        return backend()->filterThreads();
+    }
+
     /**
      * @brief Assignment operator for none.
      */
@@ -480,8 +654,29 @@ public:
     // Validate
     //------------------------------------------------------
 
+    /**
+     * @brief Validate the file and all entities it contains, on the
+     *        calling thread.
+     *
+     * @return The validation results.
+     */
     valid::Result validate() const;
 
+    /**
+     * @brief Validate the file and all entities it contains.
+     *
+     * Blocks and sections are validated concurrently, which is only safe for
+     * files opened with {@link nix::FileMode::ReadOnly} by the HDF5 backend
+     * (see the thread safety notes above). The result does not depend on
+     * the number of threads.
+     *
+     * @param threads   The number of threads that validate blocks and sections
+     *                  concurrently; 0 or 1 validates on the calling thread.
+     *
+     * @return The validation results, in the same order as for a sequential run.
+     */
+    valid::Result validate(size_t threads) const;
+
 };
 
 
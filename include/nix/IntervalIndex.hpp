@@ -0,0 +1,117 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_INTERVAL_INDEX_H
+#define NIX_INTERVAL_INDEX_H
+
+#include <nix/DataArray.hpp>
+#include <nix/util/dataAccess.hpp>
+#include <nix/Platform.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief An index of the regions that the tags and multi tags referencing
+ *        a data array mark along one of its dimensions.
+ *
+ * The index reads the positions and extents of all tags and multi tags that
+ * reference the data array once and converts them to index space using the
+ * dimension descriptor, like {@link nix::util::getOffsetAndCount} does. The
+ * regions are kept in a centered interval tree, so an overlap query takes
+ * O(log n + k) for k results and does not access the file.
+ *
+ * The index is not updated when tags or the data array change; build a new
+ * one instead.
+ */
+class NIXAPI IntervalIndex {
+public:
+
+    /**
+     * @brief A region of the data array marked by a tag or by one position
+     *        of a multi tag.
+     */
+    struct Interval {
+        /** @brief The first index of the region. */
+        ndsize_t begin;
+        /** @brief One past the last index of the region. */
+        ndsize_t end;
+        /** @brief The id of the tag or multi tag. */
+        std::string tag;
+        /** @brief Whether the region belongs to a multi tag. */
+        bool multiTag;
+        /** @brief The index of the position in the multi tag, 0 for tags. */
+        ndsize_t position;
+    };
+
+    /**
+     * @brief Build the index for one dimension of a data array.
+     *
+     * Positions that lie before the start of the dimension are left out.
+     *
+     * @param array      The data array.
+     * @param dimension  The dimension, starting at 1.
+     *
+     * @throws nix::IncompatibleDimensions If the units of a tag do not match
+     *         those of the dimension.
+     */
+    explicit IntervalIndex(const DataArray &array, ndsize_t dimension = 1);
+
+    /**
+     * @brief All regions overlapping the index range [begin, end).
+     */
+    std::vector<Interval> overlappingIndices(ndsize_t begin, ndsize_t end) const;
+
+    /**
+     * @brief All regions overlapping the range from start to end, given in
+     *        the same way as the positions of a tag.
+     *
+     * The range is converted to index space like a tag with position start
+     * and extent end - start.
+     */
+    std::vector<Interval> overlapping(double start, double end, const std::string &unit = "none") const;
+
+    /**
+     * @brief The number of regions in the index.
+     */
+    size_t size() const {
+        return intervals.size();
+    }
+
+    const Interval &interval(size_t index) const {
+        return intervals.at(index);
+    }
+
+private:
+
+    struct Node {
+        ndsize_t center;
+        // intervals containing center, by ascending begin and descending end
+        std::vector<size_t> by_begin;
+        std::vector<size_t> by_end;
+        size_t left;
+        size_t right;
+    };
+
+    size_t build(std::vector<size_t> &members);
+
+    void query(size_t node, ndsize_t begin, ndsize_t end, std::vector<Interval> &result) const;
+
+    std::vector<Interval> intervals;
+    std::vector<Node> nodes;
+    size_t root;
+
+    // kept to convert the positions of queries
+    util::PositionConverter converter;
+};
+
+} // namespace nix
+
+#endif
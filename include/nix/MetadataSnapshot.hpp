@@ -0,0 +1,199 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_METADATA_SNAPSHOT_H
+#define NIX_METADATA_SNAPSHOT_H
+
+#include <nix/File.hpp>
+#include <nix/Value.hpp>
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief An in-memory copy of the metadata tree of a file.
+ *
+ * The snapshot loads all sections and properties of a file in a single
+ * traversal and indexes them by id, name and type and the properties by
+ * name and value. Queries on the snapshot do not access the file; they
+ * refer to sections and properties by their position in the snapshot.
+ *
+ * The snapshot is not updated when the metadata of the file changes.
+ */
+class NIXAPI MetadataSnapshot {
+public:
+
+    /**
+     * @brief Marks a missing parent or link.
+     */
+    static const size_t npos;
+
+    /**
+     * @brief A section of the snapshot.
+     */
+    struct SectionNode {
+        std::string id;
+        std::string name;
+        std::string type;
+        boost::optional<std::string> definition;
+        boost::optional<std::string> repository;
+        /** @brief The parent section or npos for top level sections. */
+        size_t parent;
+        /** @brief The linked section or npos. */
+        size_t link;
+        /** @brief The number of sections above this one. */
+        size_t level;
+        std::vector<size_t> sections;
+        std::vector<size_t> properties;
+    };
+
+    /**
+     * @brief A property of the snapshot.
+     */
+    struct PropertyNode {
+        std::string id;
+        std::string name;
+        DataType dataType;
+        boost::optional<std::string> definition;
+        boost::optional<std::string> unit;
+        std::vector<Value> values;
+        /** @brief The section of the property. */
+        size_t section;
+    };
+
+    typedef std::function<bool(const SectionNode &)> SectionFilter;
+
+    /**
+     * @brief Load the metadata tree of a file.
+     */
+    explicit MetadataSnapshot(const File &file);
+
+    /**
+     * @brief The top level sections.
+     */
+    const std::vector<size_t> &sections() const {
+        return roots;
+    }
+
+    size_t sectionCount() const {
+        return section_nodes.size();
+    }
+
+    size_t propertyCount() const {
+        return property_nodes.size();
+    }
+
+    const SectionNode &section(size_t index) const {
+        return section_nodes.at(index);
+    }
+
+    const PropertyNode &property(size_t index) const {
+        return property_nodes.at(index);
+    }
+
+    /**
+     * @brief The section with the given id, if any.
+     */
+    boost::optional<size_t> sectionById(const std::string &id) const;
+
+    /**
+     * @brief The property with the given id, if any.
+     */
+    boost::optional<size_t> propertyById(const std::string &id) const;
+
+    /**
+     * @brief All sections with the given name.
+     */
+    const std::vector<size_t> &sectionsByName(const std::string &name) const;
+
+    /**
+     * @brief All sections with the given type.
+     */
+    const std::vector<size_t> &sectionsByType(const std::string &type) const;
+
+    /**
+     * @brief All sections that have a property with the given name.
+     */
+    std::vector<size_t> sectionsWithProperty(const std::string &name) const;
+
+    /**
+     * @brief All sections that have a property with the given name and
+     *        one value equal to value.
+     *
+     * Values are compared by type and data, not by uncertainty or the
+     * other fields of a Value.
+     */
+    std::vector<size_t> sectionsWithProperty(const std::string &name, const Value &value) const;
+
+    /**
+     * @brief The property with the given name of a section, if any.
+     */
+    boost::optional<size_t> propertyByName(size_t section, const std::string &name) const;
+
+    /**
+     * @brief The own properties of a section and the properties of its
+     *        linked section that it does not override.
+     */
+    std::vector<size_t> inheritedProperties(size_t section) const;
+
+    /**
+     * @brief Find sections in the tree below a section, including the section.
+     *
+     * Works like {@link Section::findSections}.
+     */
+    std::vector<size_t> findSections(size_t section, const SectionFilter &filter,
+                                     size_t max_depth = std::numeric_limits<size_t>::max()) const;
+
+    /**
+     * @brief Find sections in the whole tree.
+     */
+    std::vector<size_t> findSections(const SectionFilter &filter,
+                                     size_t max_depth = std::numeric_limits<size_t>::max()) const;
+
+    /**
+     * @brief Find sections related to a section.
+     *
+     * Works like {@link Section::findRelated}: searches below the section
+     * first, then above and then in the branches next to it.
+     */
+    std::vector<size_t> findRelated(size_t section, const SectionFilter &filter) const;
+
+private:
+
+    std::vector<size_t> findDownstream(size_t section, const SectionFilter &filter) const;
+
+    std::vector<size_t> findUpstream(size_t section, const SectionFilter &filter) const;
+
+    std::vector<size_t> findSideways(size_t section, const SectionFilter &filter, size_t caller) const;
+
+    size_t treeDepth(size_t section) const;
+
+    std::vector<SectionNode> section_nodes;
+    std::vector<PropertyNode> property_nodes;
+    std::vector<size_t> roots;
+
+    std::unordered_map<std::string, size_t> section_ids;
+    std::unordered_map<std::string, size_t> property_ids;
+    std::unordered_map<std::string, std::vector<size_t>> section_names;
+    std::unordered_map<std::string, std::vector<size_t>> section_types;
+    // property name -> properties, property name and value -> sections
+    std::unordered_map<std::string, std::vector<size_t>> property_names;
+    std::unordered_map<std::string, std::vector<size_t>> property_values;
+};
+
+} // namespace nix
+
+#endif
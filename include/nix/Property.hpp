@@ -12,11 +12,15 @@
 #include <nix/base/Entity.hpp>
 #include <nix/base/IProperty.hpp>
 #include <nix/Value.hpp>
+#include <nix/DataType.hpp>
+#include <nix/Exception.hpp>
 
 #include <nix/Platform.hpp>
 
 #include <ostream>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace nix {
 
@@ -237,6 +241,75 @@ public:
         return backend()->values();
     }
 
+    /**
+     * @brief Get a range of the values of the property.
+     *
+     * Only the requested values are read from the file.
+     *
+     * @param offset    The index of the first value.
+     * @param count     The number of values.
+     *
+     * @return The values of the range.
+     */
+    std::vector<Value> values(ndsize_t offset, ndsize_t count) const {
+        return backend()->values(offset, count);
+    }
+
+    /**
+     * @brief Read all values of the property into a typed vector.
+     *
+     * The values are read directly into the vector and converted to
+     * its element type; their uncertainties and other fields are not
+     * read. Boolean values can not be read into a std::vector<bool>.
+     *
+     * @param values    The vector, resized to the number of values.
+     */
+    template<typename T>
+    typename std::enable_if<!std::is_same<T, Value>::value>::type
+    values(std::vector<T> &values) const {
+        this->values(values, 0, valueCount());
+    }
+
+    /**
+     * @brief Read a range of the values of the property into a typed vector.
+     *
+     * @param values    The vector, resized to count.
+     * @param offset    The index of the first value.
+     * @param count     The number of values.
+     */
+    template<typename T>
+    typename std::enable_if<!std::is_same<T, Value>::value>::type
+    values(std::vector<T> &values, ndsize_t offset, ndsize_t count) const {
+        static_assert(to_data_type<T>::is_valid && !std::is_same<T, bool>::value,
+                      "Unsupported element type for property values");
+        values.resize(check::fits_in_size_t(count, "Cannot resize: too many values for memory"));
+        backend()->readValues(to_data_type<T>::value, values.data(), count, offset);
+    }
+
+    /**
+     * @brief Append values to the property.
+     *
+     * Only the new values are written to the file.
+     *
+     * @param values    The values to append.
+     */
+    void appendValues(const std::vector<Value> &values) {
+        backend()->appendValues(values);
+    }
+
+    /**
+     * @brief Append typed values to the property.
+     *
+     * @param values    The values to append.
+     */
+    template<typename T>
+    typename std::enable_if<!std::is_same<T, Value>::value>::type
+    appendValues(const std::vector<T> &values) {
+        static_assert(to_data_type<T>::is_valid && !std::is_same<T, bool>::value,
+                      "Unsupported element type for property values");
+        backend()->appendValues(to_data_type<T>::value, values.data(), values.size());
+    }
+
     /**
      * @brief Deletes all values from the property.
      */
@@ -419,6 +419,19 @@ public:
      */
     Property createProperty(const std::string &name, const std::vector<Value> &values);
 
+    /**
+     * @brief Add several new Properties with values to the Section at once.
+     *
+     * All names are validated and checked for uniqueness (against the existing
+     * properties and within the batch) before anything is written. This is
+     * considerably faster than calling {@link createProperty} in a loop.
+     *
+     * @param specs     Name and values of each property to create.
+     *
+     * @return The newly created properties, in the order of the specs.
+     */
+    std::vector<Property> createProperties(const std::vector<PropertySpec> &specs);
+
     /**
      * @brief Delete the Property identified by its name or id.
      *
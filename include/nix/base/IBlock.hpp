@@ -16,12 +16,36 @@
 #include <nix/base/IMultiTag.hpp>
 #include <nix/base/IGroup.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/DataType.hpp>
+#include <nix/Compression.hpp>
+#include <nix/CopyIds.hpp>
 
 #include <string>
 #include <vector>
 #include <memory>
 
 namespace nix {
+
+/**
+ * @brief The parameters of a single data array for {@link nix::Block::createDataArrays}.
+ */
+struct NIXAPI DataArraySpec {
+    std::string name;
+    std::string type;
+    DataType    data_type;
+    NDSize      shape;
+    Compression compression;
+};
+
+/**
+ * @brief The parameters of a single tag for {@link nix::Block::createTags}.
+ */
+struct NIXAPI TagSpec {
+    std::string         name;
+    std::string         type;
+    std::vector<double> position;
+};
+
 namespace base {
 
 /**
@@ -68,11 +92,24 @@ public:
 
 
     virtual std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
-                                                              nix::DataType data_type, const NDSize &shape) = 0;
+                                                              nix::DataType data_type, const NDSize &shape,
+                                                              Compression compression) = 0;
+
+
+    virtual std::vector<std::shared_ptr<base::IDataArray>> createDataArrays(const std::vector<DataArraySpec> &specs) = 0;
 
 
     virtual bool deleteDataArray(const std::string &name_or_id) = 0;
 
+
+    virtual std::shared_ptr<base::IDataArray> copyDataArray(const std::shared_ptr<base::IDataArray> &array,
+                                                            const std::string &name, CopyIds ids) = 0;
+
+
+    virtual std::shared_ptr<base::IDataArray> createVirtualDataArray(const std::string &name, const std::string &type,
+                                                                     const std::vector<std::shared_ptr<base::IDataArray>> &parts,
+                                                                     size_t axis) = 0;
+
     //--------------------------------------------------
     // Methods concerning tags.
     //--------------------------------------------------
@@ -93,6 +130,9 @@ public:
                                                               const std::vector<double> &position) = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::ITag>> createTags(const std::vector<TagSpec> &specs) = 0;
+
+
     virtual bool deleteTag(const std::string &name_or_id) = 0;
 
     //--------------------------------------------------
@@ -14,12 +14,18 @@
 #include <nix/DataType.hpp>
 #include <nix/NDSize.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace nix {
 namespace base {
 
+class ITag;
+class IMultiTag;
+class IFeature;
+class IGroup;
+
 /**
  * @brief Interface for implementations of the DataArray entity.
  *
@@ -145,6 +151,19 @@ public:
      */
     virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const = 0;
 
+    /**
+     * @brief Read data from the data array into a region of a larger buffer.
+     *
+     * @param dtype          The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer         Buffer of shape buffer_extent where the data is written.
+     * @param count          The size of the data to read.
+     * @param offset         The position where the reading should start.
+     * @param buffer_extent  The shape of the buffer.
+     * @param buffer_offset  The position in the buffer where the data is placed.
+     */
+    virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                      const NDSize &buffer_extent, const NDSize &buffer_offset) const = 0;
+
 
     virtual NDSize dataExtent(void) const = 0;
 
@@ -154,6 +173,83 @@ public:
 
     virtual DataType dataType(void) const = 0;
 
+    /**
+     * @brief The shape of the chunks the data is stored in, empty if the
+     *        storage is not chunked.
+     */
+    virtual NDSize dataChunking() const = 0;
+
+    //--------------------------------------------------
+    // Methods concerning the envelope.
+    //--------------------------------------------------
+
+    /**
+     * @brief The decimation factor of the stored envelope, 0 if the data
+     *        array has no envelope.
+     */
+    virtual ndsize_t envelopeFactor() const = 0;
+
+    /**
+     * @brief Create an empty envelope, replacing a stored one.
+     *
+     * @param factor    The number of buckets of a level that make up one
+     *                  bucket of the next level.
+     */
+    virtual void createEnvelope(ndsize_t factor) = 0;
+
+
+    virtual bool deleteEnvelope() = 0;
+
+    /**
+     * @brief The number of stored envelope levels.
+     */
+    virtual ndsize_t envelopeLevelCount() const = 0;
+
+    /**
+     * @brief The extent of an envelope level, {buckets, values per sample, 3}.
+     *
+     * @param level     The level, starting at 1.
+     */
+    virtual NDSize envelopeExtent(ndsize_t level) const = 0;
+
+    /**
+     * @brief Read buckets of an envelope level; each bucket holds minimum,
+     *        maximum and mean per value of a sample.
+     */
+    virtual void readEnvelope(ndsize_t level, double *buffer, const NDSize &count, const NDSize &offset) const = 0;
+
+    /**
+     * @brief Write buckets of an envelope level, creating or extending the
+     *        level as needed.
+     */
+    virtual void writeEnvelope(ndsize_t level, const double *buffer, const NDSize &count, const NDSize &offset) = 0;
+
+    //--------------------------------------------------
+    // Methods concerning referencing entities.
+    //--------------------------------------------------
+
+    /**
+     * @brief The tags of the block that reference the data array.
+     */
+    virtual std::vector<std::shared_ptr<base::ITag>> referencingTags() const = 0;
+
+    /**
+     * @brief The multi tags of the block that reference the data array or
+     *        use it as positions or extents.
+     */
+    virtual std::vector<std::shared_ptr<base::IMultiTag>> referencingMultiTags() const = 0;
+
+    /**
+     * @brief The features of the tags and multi tags of the block that
+     *        link to the data array.
+     */
+    virtual std::vector<std::shared_ptr<base::IFeature>> referencingFeatures() const = 0;
+
+    /**
+     * @brief The groups of the block that contain the data array.
+     */
+    virtual std::vector<std::shared_ptr<base::IGroup>> referencingGroups() const = 0;
+
     /**
      * @brief Destructor
      */
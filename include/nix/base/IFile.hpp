@@ -14,8 +14,10 @@
 #include <nix/Platform.hpp>
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <ctime>
+#include <cstdint>
 
 namespace nix {
 
@@ -29,6 +31,45 @@ NIXAPI enum class FileMode {
 };
 
 
+/**
+ * @brief Counters of the storage calls made on behalf of a file, see
+ *        {@link nix::File::ioStatistics}.
+ *
+ * Calls are counted at the level of the backend's storage wrappers; a
+ * call made from within another counted call is counted (and timed) as
+ * well.
+ */
+struct NIXAPI IOStatistics {
+
+    struct Calls {
+        uint64_t count  = 0;
+        uint64_t micros = 0;    // time spent in the calls
+    };
+
+    Calls data_read;
+    Calls data_write;
+    Calls group_open;
+    Calls has_object;
+    Calls object_name;
+    Calls attr_read;
+    Calls attr_write;
+
+    uint64_t bytes_read       = 0;
+    uint64_t bytes_written    = 0;
+    uint64_t data_sets_opened = 0;
+    uint64_t groups_opened    = 0;
+
+    /**
+     * @brief All call counters with their names, e.g. for exporting them.
+     */
+    std::vector<std::pair<std::string, Calls>> calls() const {
+        return {{"data_read", data_read}, {"data_write", data_write}, {"group_open", group_open},
+                {"has_object", has_object}, {"object_name", object_name},
+                {"attr_read", attr_read}, {"attr_write", attr_write}};
+    }
+};
+
+
 #define FILE_VERSION std::vector<int>{1, 0, 0}
 #define FILE_FORMAT  std::string("nix")
 
@@ -64,6 +105,10 @@ public:
 
     virtual bool deleteBlock(const std::string &name_or_id) = 0;
 
+
+    virtual std::shared_ptr<IBlock> copyBlock(const std::shared_ptr<IBlock> &block, const std::string &name,
+                                              CopyIds ids) = 0;
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -125,6 +170,36 @@ public:
     virtual FileMode fileMode() const = 0;
 
 
+    virtual void deferTimestamps(bool defer) = 0;
+
+
+    virtual bool deferTimestamps() const = 0;
+
+
+    virtual void compactProperties(bool compact) = 0;
+
+
+    virtual bool compactProperties() const = 0;
+
+
+    virtual void collectIOStatistics(bool collect) = 0;
+
+
+    virtual bool collectIOStatistics() const = 0;
+
+
+    virtual IOStatistics ioStatistics() const = 0;
+
+
+    virtual void resetIOStatistics() = 0;
+
+
+    virtual void filterThreads(size_t threads) = 0;
+
+
+    virtual size_t filterThreads() const = 0;
+
+
     virtual ~IFile() {}
 
 };
@@ -75,6 +75,18 @@ public:
     virtual std::vector<Value> values(void) const = 0;
 
 
+    virtual std::vector<Value> values(ndsize_t offset, ndsize_t count) const = 0;
+
+
+    virtual void readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const = 0;
+
+
+    virtual void appendValues(const std::vector<Value> &values) = 0;
+
+
+    virtual void appendValues(DataType dtype, const void *data, ndsize_t count) = 0;
+
+
     virtual void values(const boost::none_t t) = 0;
 
 
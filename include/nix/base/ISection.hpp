@@ -21,6 +21,15 @@
 #include <vector>
 
 namespace nix {
+
+/**
+ * @brief The parameters of a single property for {@link nix::Section::createProperties}.
+ */
+struct NIXAPI PropertySpec {
+    std::string        name;
+    std::vector<Value> values;
+};
+
 namespace base {
 
 class NIXAPI IFile;
@@ -115,6 +124,9 @@ public:
     virtual std::shared_ptr<IProperty> createProperty(const std::string &name, const std::vector<Value> &values) = 0;
 
 
+    virtual std::vector<std::shared_ptr<IProperty>> createProperties(const std::vector<PropertySpec> &specs) = 0;
+
+
     virtual bool deleteProperty(const std::string &name_or_id) = 0;
 
 
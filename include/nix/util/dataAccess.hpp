@@ -21,7 +21,11 @@
 #include <nix/MultiTag.hpp>
 #include <nix/Tag.hpp>
 
+#include <boost/optional.hpp>
+
 #include <ctime>
+#include <string>
+#include <vector>
 
 namespace nix {
 namespace util {
@@ -80,6 +84,48 @@ NIXAPI ndsize_t positionToIndex(double position, const std::string &unit, const
  */
 NIXAPI ndsize_t positionToIndex(double position, const std::string &unit, const RangeDimension &dimension);
 
+/**
+ * @brief Converts positions into indices of one dimension like {@link positionToIndex},
+ *        but reads the dimension descriptor only once.
+ *
+ * The scaling factor of the last unit used is cached.
+ */
+class NIXAPI PositionConverter {
+public:
+
+    explicit PositionConverter(const Dimension &dimension);
+
+    /**
+     * @brief The index of a position given in unit, which may be "none".
+     *
+     * Unlike positionToIndex the index is not checked against the bounds of
+     * the dimension and may be negative for a sampled dimension.
+     *
+     * @throws nix::IncompatibleDimensions If the unit does not fit the dimension.
+     */
+    ndssize_t index(double position, const std::string &unit) const;
+
+    /**
+     * @brief Whether an index lies within the dimension, as far as the
+     *        dimension descriptor tells.
+     */
+    bool inBounds(ndssize_t index) const;
+
+private:
+
+    double scaling(const std::string &unit) const;
+
+    DimensionType type;
+    boost::optional<std::string> unit;
+    double offset;
+    double sampling_interval;
+    std::vector<double> ticks;
+    size_t label_count;
+
+    mutable std::string cached_unit;
+    mutable double cached_scaling;
+};
+
 /**
  * @brief Returns the offsets and element counts associated with position and extent of a Tag and
  *        the referenced DataArray.
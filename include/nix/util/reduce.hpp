@@ -0,0 +1,123 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REDUCE_H
+#define NIX_REDUCE_H
+
+#include <nix/DataSet.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief Sum, sum of squared deviations from the mean, minimum and
+ *        maximum of a set of values.
+ *
+ * NaN values make the sums NaN and are ignored by minimum and maximum,
+ * which are infinity and minus infinity if there are no other values.
+ */
+struct NIXAPI Statistics {
+    ndsize_t count;
+    double sum;
+    double squaredDeviations;
+    double min;
+    double max;
+
+    double mean() const;
+
+    /**
+     * @brief The population variance.
+     */
+    double variance() const;
+};
+
+/**
+ * @brief The number of values in equally wide bins of [lower, upper).
+ *
+ * NaN values are not counted.
+ */
+struct NIXAPI Histogram {
+    double lower;
+    double upper;
+    std::vector<ndsize_t> bins;
+    /** @brief The number of values below lower. */
+    ndsize_t below;
+    /** @brief The number of values at or above upper. */
+    ndsize_t above;
+};
+
+/**
+ * @brief Called with the values of a tile, in row-major order, and the
+ *        count and offset of the tile in the data.
+ */
+typedef std::function<void(const double *values, const NDSize &count, const NDSize &offset)> TileKernel;
+
+/**
+ * @brief The number of rows along the first dimension of the tiles that
+ *        {@link forEachTile} reads.
+ *
+ * A tile holds about a million values and, for a DataArray stored in
+ * chunks, a multiple of the chunk rows, so that no chunk is read twice.
+ *
+ * @param data      The data.
+ * @param tile_rows The requested number of rows, 0 to choose it.
+ */
+NIXAPI ndsize_t tileRows(const DataSet &data, ndsize_t tile_rows = 0);
+
+/**
+ * @brief Read all data in tiles of whole rows along the first dimension
+ *        and pass each tile to a kernel.
+ *
+ * The values are read as doubles, so the calibration of a DataArray is
+ * applied. The next tile is read while the kernel processes the current
+ * one, and the kernel is called for the tiles in order.
+ *
+ * @param data      The data, e.g. a DataArray or a DataView.
+ * @param kernel    The function called for each tile.
+ * @param tile_rows The number of rows of a tile, 0 to choose it.
+ */
+NIXAPI void forEachTile(const DataSet &data, const TileKernel &kernel, ndsize_t tile_rows = 0);
+
+/**
+ * @brief The statistics of all values of the data.
+ *
+ * The result does not depend on the tile size: each value is added to
+ * one of several partial sums selected by its position in the data.
+ */
+NIXAPI Statistics statistics(const DataSet &data, ndsize_t tile_rows = 0);
+
+/**
+ * @brief The statistics of each index along an axis, e.g. of each
+ *        channel of a samples x channels array with axis 1.
+ */
+NIXAPI std::vector<Statistics> channelStatistics(const DataSet &data, size_t axis, ndsize_t tile_rows = 0);
+
+/**
+ * @brief The histogram of all values of the data.
+ *
+ * @throws std::invalid_argument If there are no bins or lower is not
+ *         below upper.
+ */
+NIXAPI Histogram histogram(const DataSet &data, double lower, double upper, size_t bins,
+                           ndsize_t tile_rows = 0);
+
+/**
+ * @brief The histogram of each index along an axis.
+ */
+NIXAPI std::vector<Histogram> channelHistograms(const DataSet &data, size_t axis, double lower,
+                                                double upper, size_t bins, ndsize_t tile_rows = 0);
+
+} // namespace util
+} // namespace nix
+
+#endif
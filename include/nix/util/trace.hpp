@@ -0,0 +1,123 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TRACE_H
+#define NIX_TRACE_H
+
+#include <nix/Platform.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief Start recording trace spans.
+ *
+ * Spans are kept in a fixed size ring buffer per thread; once a buffer
+ * is full the oldest spans of the thread are overwritten. Tracing can
+ * also be enabled by setting the environment variable NIX_TRACE to the
+ * path of the trace file before the library is loaded.
+ *
+ * @param path  The file the trace is written to whenever a File is
+ *              closed. If empty, the trace is only written by
+ *              {@link writeTrace}.
+ */
+NIXAPI void enableTracing(const std::string &path = "");
+
+/**
+ * @brief Stop recording trace spans. Recorded spans are kept.
+ */
+NIXAPI void disableTracing();
+
+/**
+ * @brief Write all recorded spans as Chrome trace-event JSON, which can
+ *        be opened with Perfetto or chrome://tracing.
+ *
+ * Spans recorded by other threads while the trace is written may be
+ * missing from it.
+ */
+NIXAPI void writeTrace(std::ostream &out);
+
+/**
+ * @brief Write all recorded spans to the file at path.
+ */
+NIXAPI void writeTrace(const std::string &path);
+
+/**
+ * @brief Write all recorded spans to the path given to {@link enableTracing},
+ *        if tracing is enabled and a path was given.
+ *
+ * Called whenever a File is closed; failing to write the trace is ignored.
+ */
+NIXAPI void flushTrace();
+
+/**
+ * @brief Discard all recorded spans. Must not be called while other
+ *        threads record spans.
+ */
+NIXAPI void clearTrace();
+
+namespace detail {
+
+NIXAPI extern std::atomic<bool> tracing;
+
+NIXAPI void recordSpan(const char *name, const char *category,
+                       std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end);
+
+} // namespace detail
+
+/**
+ * @brief Whether trace spans are recorded.
+ */
+inline bool tracingEnabled() {
+    return detail::tracing.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Records the time from its construction to its destruction as a
+ *        span of the trace, if tracing is enabled.
+ *
+ * Name and category are not copied and must be string literals. If
+ * tracing is disabled a span costs a single atomic load.
+ */
+class TraceSpan {
+public:
+    typedef std::chrono::steady_clock clock_t;
+
+    explicit TraceSpan(const char *name, const char *category = "nix")
+        : name(tracingEnabled() ? name : nullptr), category(category) {
+        if (this->name) {
+            start = clock_t::now();
+        }
+    }
+
+    TraceSpan(const TraceSpan &other) = delete;
+    TraceSpan &operator=(const TraceSpan &other) = delete;
+
+    ~TraceSpan() {
+        if (name) {
+            detail::recordSpan(name, category, start, clock_t::now());
+        }
+    }
+
+private:
+    const char *name;
+    const char *category;
+    clock_t::time_point start;
+};
+
+} // namespace util
+} // namespace nix
+
+#endif
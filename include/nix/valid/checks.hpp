@@ -22,6 +22,9 @@
 namespace nix {
 namespace valid {
 
+    class DimensionSnapshot;
+    class DataArraySnapshot;
+
     /**
      * @brief Check if later given not greater than initally defined value.
      * 
@@ -359,6 +362,7 @@ namespace valid {
         tagRefsHaveUnits(const std::vector<std::string> &units) : units(units) {}
         
         bool operator()(const std::vector<DataArray> &references) const;
+        bool operator()(const std::vector<DataArraySnapshot> &references) const;
     };
 
     /**
@@ -383,6 +387,7 @@ namespace valid {
         tagUnitsMatchRefsUnits(const std::vector<std::string> &units) : units(units) {}
         
         bool operator()(const std::vector<DataArray> &references) const;
+        bool operator()(const std::vector<DataArraySnapshot> &references) const;
     };
 
     /**
@@ -471,6 +476,48 @@ namespace valid {
         bool operator()(const std::vector<Dimension> &dims) const;
     };
 
+    /**
+     * @brief Check if the positions or extents match the snapshots of the referenced DataArrays
+     * 
+     * Snapshot variant of {@link extentsMatchRefs} and {@link positionsMatchRefs}:
+     * an NDSize is the data extent of a positions or extents DataArray, a
+     * vector the positions or extents of a Tag.
+     */
+    struct NIXAPI extentsMatchRefSnapshots {
+        std::vector<NDSize> ref_extents;
+
+        extentsMatchRefSnapshots(const std::vector<DataArraySnapshot> &refs);
+
+        bool operator()(const boost::optional<NDSize> &extents) const;
+        bool operator()(const std::vector<double> &extents) const;
+    };
+
+    /**
+     * @brief Check if range dimension ticks match the given data extent
+     * 
+     * Snapshot variant of {@link dimTicksMatchData}.
+     */
+    struct NIXAPI dimTicksMatchExtent {
+        NDSize extent;
+
+        dimTicksMatchExtent(const NDSize &extent) : extent(extent) {}
+
+        bool operator()(const std::vector<DimensionSnapshot> &dims) const;
+    };
+
+    /**
+     * @brief Check if set dimension labels match the given data extent
+     * 
+     * Snapshot variant of {@link dimLabelsMatchData}.
+     */
+    struct NIXAPI dimLabelsMatchExtent {
+        NDSize extent;
+
+        dimLabelsMatchExtent(const NDSize &extent) : extent(extent) {}
+
+        bool operator()(const std::vector<DimensionSnapshot> &dims) const;
+    };
+
 } // namespace valid
 } // namespace nix
 
@@ -0,0 +1,232 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SNAPSHOT_H
+#define NIX_SNAPSHOT_H
+
+#include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/DataType.hpp>
+#include <nix/base/IDimensions.hpp>
+#include <nix/base/IFeature.hpp>
+
+#include <nix/types.hpp>
+
+#include <boost/optional.hpp>
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace valid {
+
+/*
+ * Snapshots are immutable records of everything the validation rules look
+ * at. Each entity is read from the backend exactly once, when the snapshot
+ * is created; the getters then only return the stored values. A getter
+ * that failed while taking the snapshot throws when it is called, so the
+ * rules see the same errors as when querying the entity directly.
+ *
+ * Copying a snapshot is cheap, the data is shared.
+ */
+
+/**
+ * @brief Snapshot of a dimension of any type.
+ */
+class NIXAPI DimensionSnapshot {
+
+public:
+
+    explicit DimensionSnapshot(const Dimension &dim);
+    explicit DimensionSnapshot(const RangeDimension &dim);
+    explicit DimensionSnapshot(const SampledDimension &dim);
+    explicit DimensionSnapshot(const SetDimension &dim);
+
+    ndsize_t index() const;
+    DimensionType dimensionType() const;
+
+    std::vector<double> ticks() const;
+    std::vector<std::string> labels() const;
+    boost::optional<std::string> unit() const;
+    double samplingInterval() const;
+    boost::optional<double> offset() const;
+
+    struct Data;
+
+private:
+
+    std::shared_ptr<const Data> d;
+};
+
+
+/**
+ * @brief Snapshot of the attributes common to all entities: id, creation
+ *        time and, for named entities, name and type.
+ */
+class NIXAPI EntitySnapshot {
+
+public:
+
+    explicit EntitySnapshot(const Block &block);
+    explicit EntitySnapshot(const Section &section);
+    explicit EntitySnapshot(const Source &source);
+
+    std::string id() const;
+    time_t createdAt() const;
+    std::string name() const;
+    std::string type() const;
+
+    struct Data;
+
+protected:
+
+    explicit EntitySnapshot(const std::shared_ptr<const Data> &data) : d(data) {}
+
+    std::shared_ptr<const Data> d;
+};
+
+
+/**
+ * @brief Snapshot of a data array including its dimensions.
+ */
+class NIXAPI DataArraySnapshot : public EntitySnapshot {
+
+public:
+
+    explicit DataArraySnapshot(const DataArray &data_array);
+
+    DataType dataType() const;
+    NDSize dataExtent() const;
+    ndsize_t dimensionCount() const;
+    std::vector<DimensionSnapshot> dimensions() const;
+    boost::optional<std::string> unit() const;
+    std::vector<double> polynomCoefficients() const;
+    boost::optional<double> expansionOrigin() const;
+
+    /**
+     * @brief The unit of each dimension, empty for set dimensions or
+     *        dimensions without unit (see {@link getDimensionsUnits}).
+     */
+    std::vector<std::string> dimensionsUnits() const;
+
+    struct Data;
+
+private:
+
+    const Data &data() const;
+};
+
+
+/**
+ * @brief Map from data array id to snapshot, used to snapshot each
+ *        referenced data array only once.
+ */
+typedef std::unordered_map<std::string, DataArraySnapshot> DataArraySnapshots;
+
+
+/**
+ * @brief Snapshot of a tag and its referenced data arrays.
+ */
+class NIXAPI TagSnapshot : public EntitySnapshot {
+
+public:
+
+    /**
+     * @param tag       The tag to snapshot.
+     * @param known     Snapshots of data arrays that were already taken; referenced
+     *                  data arrays found in it are not read again.
+     */
+    explicit TagSnapshot(const Tag &tag, const DataArraySnapshots &known = DataArraySnapshots());
+
+    std::vector<double> position() const;
+    std::vector<double> extent() const;
+    std::vector<std::string> units() const;
+    std::vector<DataArraySnapshot> references() const;
+
+    struct Data;
+
+private:
+
+    const Data &data() const;
+};
+
+
+/**
+ * @brief Snapshot of a multi tag and its referenced data arrays. Of the
+ *        positions and extents only the data extent is recorded.
+ */
+class NIXAPI MultiTagSnapshot : public EntitySnapshot {
+
+public:
+
+    /**
+     * @param multi_tag The multi tag to snapshot.
+     * @param known     Snapshots of data arrays that were already taken; referenced
+     *                  data arrays found in it are not read again.
+     */
+    explicit MultiTagSnapshot(const MultiTag &multi_tag, const DataArraySnapshots &known = DataArraySnapshots());
+
+    boost::optional<NDSize> positionsExtent() const;
+    boost::optional<NDSize> extentsExtent() const;
+    std::vector<std::string> units() const;
+    std::vector<DataArraySnapshot> references() const;
+
+    struct Data;
+
+private:
+
+    const Data &data() const;
+};
+
+
+/**
+ * @brief Snapshot of a feature.
+ */
+class NIXAPI FeatureSnapshot : public EntitySnapshot {
+
+public:
+
+    explicit FeatureSnapshot(const Feature &feature);
+
+    bool hasData() const;
+    LinkType linkType() const;
+
+    struct Data;
+
+private:
+
+    const Data &data() const;
+};
+
+
+/**
+ * @brief Snapshot of a property (without its values).
+ */
+class NIXAPI PropertySnapshot : public EntitySnapshot {
+
+public:
+
+    explicit PropertySnapshot(const Property &property);
+
+    ndsize_t valueCount() const;
+    boost::optional<std::string> unit() const;
+
+    struct Data;
+
+private:
+
+    const Data &data() const;
+};
+
+} // namespace valid
+} // namespace nix
+
+#endif // NIX_SNAPSHOT_H
@@ -160,6 +160,30 @@ NIXAPI Result validate(const Section &section);
   */
 NIXAPI Result validate(const Source &source);
 
+/**
+  * @brief Block validator including all contained entities
+  *
+  * Validates the block, its data arrays and their dimensions, its multi tags
+  * and tags with their features and all sources in the block. Every entity
+  * is read only once; data arrays referenced by tags are not read again.
+  *
+  * @param block Block entity
+  *
+  * @returns The validation results as {@link Result} object
+  */
+NIXAPI Result validateAll(const Block &block);
+
+/**
+  * @brief Section validator including its properties
+  *
+  * Validates the section and its properties, but not its subsections.
+  *
+  * @param section Section entity
+  *
+  * @returns The validation results as {@link Result} object
+  */
+NIXAPI Result validateAll(const Section &section);
+
 /**
   * @brief File entity validator
   * 
@@ -9,8 +9,118 @@
 #include <nix/Block.hpp>
 #include <nix/util/util.hpp>
 
+#include <cmath>
+#include <unordered_set>
+
 namespace nix {
 
+namespace {
+
+// a dimension of a virtual data array, composed before the array is created
+struct DimensionSpec {
+    DimensionType type;
+    boost::optional<std::string> label;
+    boost::optional<std::string> unit;
+    double interval;
+    boost::optional<double> offset;
+    std::vector<double> ticks;
+    std::vector<std::string> labels;
+    bool alias;
+};
+
+
+DimensionSpec describeDimension(const Dimension &dim) {
+    DimensionSpec spec{dim.dimensionType(), boost::none, boost::none, 0.0, boost::none, {}, {}, false};
+    if (spec.type == DimensionType::Sample) {
+        SampledDimension sampled = dim.asSampledDimension();
+        spec.label = sampled.label();
+        spec.unit = sampled.unit();
+        spec.interval = sampled.samplingInterval();
+        spec.offset = sampled.offset();
+    } else if (spec.type == DimensionType::Range) {
+        RangeDimension range = dim.asRangeDimension();
+        spec.label = range.label();
+        spec.unit = range.unit();
+        spec.alias = range.alias();
+        if (!spec.alias) {
+            spec.ticks = range.ticks();
+        }
+    } else {
+        spec.labels = dim.asSetDimension().labels();
+    }
+    return spec;
+}
+
+
+// extend the dimension of the axis by that of the next part, which starts at index start
+void composeDimension(DimensionSpec &spec, const DimensionSpec &next, ndsize_t start) {
+    const std::string caller = "Block::createVirtualDataArray";
+    if (spec.type == DimensionType::Sample) {
+        if (next.interval != spec.interval || next.unit != spec.unit) {
+            throw IncompatibleDimensions("sampled dimensions of the parts differ in interval or unit", caller);
+        }
+        const double expected = spec.offset.get_value_or(0.0) + start * spec.interval;
+        if (std::fabs(next.offset.get_value_or(0.0) - expected) > spec.interval / 2) {
+            throw IncompatibleDimensions("parts have a gap or overlap along the axis", caller);
+        }
+    } else if (spec.type == DimensionType::Range) {
+        if (next.alias != spec.alias) {
+            throw IncompatibleDimensions("only some of the parts are their own ticks", caller);
+        }
+        if (!spec.alias) {
+            if (!next.ticks.empty() && !spec.ticks.empty() && next.ticks.front() <= spec.ticks.back()) {
+                throw UnsortedTicks(caller);
+            }
+            spec.ticks.insert(spec.ticks.end(), next.ticks.begin(), next.ticks.end());
+        }
+    } else {
+        spec.labels.insert(spec.labels.end(), next.labels.begin(), next.labels.end());
+    }
+}
+
+
+void appendDimension(DataArray &array, const DimensionSpec &spec) {
+    if (spec.type == DimensionType::Sample) {
+        SampledDimension sampled = array.appendSampledDimension(spec.interval);
+        if (spec.label) {
+            sampled.label(*spec.label);
+        }
+        if (spec.unit) {
+            sampled.unit(*spec.unit);
+        }
+        if (spec.offset) {
+            sampled.offset(*spec.offset);
+        }
+    } else if (spec.type == DimensionType::Range) {
+        RangeDimension range = spec.alias ? array.appendAliasRangeDimension()
+                                          : array.appendRangeDimension(spec.ticks);
+        if (spec.label) {
+            range.label(*spec.label);
+        }
+        if (spec.unit) {
+            range.unit(*spec.unit);
+        }
+    } else {
+        SetDimension set = array.appendSetDimension();
+        if (!spec.labels.empty()) {
+            set.labels(spec.labels);
+        }
+    }
+}
+
+} // anonymous namespace
+
+template<typename Spec>
+static void checkBatchNames(const std::vector<Spec> &specs, const std::string &caller) {
+    std::unordered_set<std::string> names;
+    for (const auto &spec : specs) {
+        util::checkEntityNameAndType(spec.name, spec.type);
+        if (!names.insert(spec.name).second) {
+            throw DuplicateName(caller);
+        }
+    }
+}
+
 Source Block::createSource(const std::string &name, const std::string &type){
     util::checkEntityNameAndType(name, type);
     if (backend()->hasSource(name)) {
@@ -60,12 +170,114 @@ bool Block::deleteSource(const Source &source) {
 }
 
 DataArray Block::createDataArray(const std::string &name, const std::string &type, nix::DataType data_type,
-                                 const NDSize &shape) {
+                                 const NDSize &shape, Compression compression) {
     util::checkEntityNameAndType(name, type);
     if (backend()->hasDataArray(name)){
         throw DuplicateName("create DataArray");
     }
-    return backend()->createDataArray(name, type, data_type, shape);
+    return backend()->createDataArray(name, type, data_type, shape, compression);
+}
+
+DataArray Block::copyDataArray(const DataArray &data_array, const std::string &name, CopyIds ids) {
+    if (!util::checkEntityInput(data_array)) {
+        throw UninitializedEntity();
+    }
+    const std::string copy_name = name.empty() ? data_array.name() : name;
+    util::checkEntityName(copy_name);
+    if (backend()->hasDataArray(copy_name)) {
+        throw DuplicateName("copyDataArray");
+    }
+    return backend()->copyDataArray(data_array.impl(), copy_name, ids);
+}
+
+DataArray Block::createVirtualDataArray(const std::string &name, const std::string &type,
+                                        const std::vector<DataArray> &parts, size_t axis) {
+    const std::string caller = "Block::createVirtualDataArray";
+    util::checkEntityNameAndType(name, type);
+    if (backend()->hasDataArray(name)) {
+        throw DuplicateName("createVirtualDataArray");
+    }
+    if (parts.empty()) {
+        throw std::invalid_argument("createVirtualDataArray: no parts given");
+    }
+    for (const DataArray &part : parts) {
+        if (!util::checkEntityInput(part)) {
+            throw UninitializedEntity();
+        }
+    }
+
+    const DataArray &first = parts.front();
+    const NDSize extent = first.dataExtent();
+    if (axis >= extent.size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+    const ndsize_t dim_count = first.dimensionCount();
+    std::vector<DimensionSpec> dims;
+    for (ndsize_t i = 1; i <= dim_count; i++) {
+        dims.push_back(describeDimension(first.getDimension(i)));
+    }
+
+    ndsize_t start = extent[axis];
+    for (size_t k = 1; k < parts.size(); k++) {
+        const DataArray &part = parts[k];
+        NDSize part_extent = part.dataExtent();
+        if (part_extent.size() != extent.size()) {
+            throw IncompatibleDimensions("parts differ in rank", caller);
+        }
+        for (size_t i = 0; i < extent.size(); i++) {
+            if (i != axis && part_extent[i] != extent[i]) {
+                throw IncompatibleDimensions("parts differ in extent along another axis", caller);
+            }
+        }
+        if (part.dataType() != first.dataType() || part.unit() != first.unit() ||
+            part.polynomCoefficients() != first.polynomCoefficients() ||
+            part.expansionOrigin() != first.expansionOrigin()) {
+            throw IncompatibleDimensions("parts differ in data type, unit or calibration", caller);
+        }
+        if (part.dimensionCount() != dim_count) {
+            throw IncompatibleDimensions("parts differ in their number of dimensions", caller);
+        }
+        for (ndsize_t i = 1; i <= dim_count; i++) {
+            DimensionSpec next = describeDimension(part.getDimension(i));
+            if (next.type != dims[i - 1].type) {
+                throw IncompatibleDimensions("parts differ in the types of their dimensions", caller);
+            }
+            if (i - 1 == axis) {
+                composeDimension(dims[i - 1], next, start);
+            }
+        }
+        start += part_extent[axis];
+    }
+
+    std::vector<std::shared_ptr<base::IDataArray>> impls;
+    for (const DataArray &part : parts) {
+        impls.push_back(part.impl());
+    }
+    DataArray array = backend()->createVirtualDataArray(name, type, impls, axis);
+
+    if (first.label()) {
+        array.label(*first.label());
+    }
+    if (first.unit()) {
+        array.unit(*first.unit());
+    }
+    if (first.expansionOrigin()) {
+        array.expansionOrigin(*first.expansionOrigin());
+    }
+    std::vector<double> polynom = first.polynomCoefficients();
+    if (!polynom.empty()) {
+        array.polynomCoefficients(polynom);
+    }
+    for (const DimensionSpec &spec : dims) {
+        appendDimension(array, spec);
+    }
+    return array;
+}
+
+std::vector<DataArray> Block::createDataArrays(const std::vector<DataArraySpec> &specs) {
+    checkBatchNames(specs, "createDataArrays");
+    std::vector<std::shared_ptr<base::IDataArray>> arrays = backend()->createDataArrays(specs);
+    return std::vector<DataArray>(arrays.begin(), arrays.end());
 }
 
 bool Block::hasDataArray(const DataArray &data_array) const {
@@ -95,6 +307,12 @@ Tag Block::createTag(const std::string &name, const std::string &type, const std
     return backend()->createTag(name, type, position);
 }
 
+std::vector<Tag> Block::createTags(const std::vector<TagSpec> &specs) {
+    checkBatchNames(specs, "createTags");
+    std::vector<std::shared_ptr<base::ITag>> tags = backend()->createTags(specs);
+    return std::vector<Tag>(tags.begin(), tags.end());
+}
+
 bool Block::hasTag(const Tag &tag) const {
     if (!util::checkEntityInput(tag, false)) {
         return false;
@@ -0,0 +1,98 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataAppender.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace nix {
+
+namespace {
+
+// the rows appended at once to data that is not stored in chunks
+const ndsize_t default_block_rows = 1024;
+
+} // anonymous namespace
+
+
+DataAppender::DataAppender(const DataArray &array, DataType dtype)
+    : array(array), dtype(dtype), row_bytes(0), block_rows(default_block_rows) {
+    if (dtype == DataType::String) {
+        throw std::invalid_argument("DataAppender: strings cannot be appended in blocks");
+    }
+
+    row_shape = array.dataExtent();
+    if (row_shape.size() == 0) {
+        throw InvalidRank("DataAppender: data array has no dimensions");
+    }
+    row_shape[0] = 1;
+    row_bytes = check::fits_in_size_t(row_shape.nelms() * data_type_to_size(dtype),
+                                      "DataAppender: rows exceed memory");
+
+    NDSize chunk = array.dataChunking();
+    if (chunk.size() > 0 && chunk[0] > 0) {
+        block_rows = chunk[0];
+    }
+}
+
+
+void DataAppender::append(const void *data, ndsize_t rows) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+    // top up the collected rows to a block first
+    if (!buffer.empty()) {
+        ndsize_t take = std::min(rows, block_rows - pending());
+        size_t n = static_cast<size_t>(take) * row_bytes;
+        buffer.insert(buffer.end(), bytes, bytes + n);
+        bytes += n;
+        rows -= take;
+        if (pending() < block_rows) {
+            return;
+        }
+        write(buffer.data(), block_rows);
+        buffer.clear();
+    }
+
+    // whole blocks are appended straight from the caller's data
+    ndsize_t whole = rows / block_rows * block_rows;
+    if (whole > 0) {
+        write(bytes, whole);
+        bytes += static_cast<size_t>(whole) * row_bytes;
+        rows -= whole;
+    }
+    buffer.insert(buffer.end(), bytes, bytes + static_cast<size_t>(rows) * row_bytes);
+}
+
+
+void DataAppender::flush() {
+    if (!buffer.empty()) {
+        write(buffer.data(), pending());
+        buffer.clear();
+    }
+}
+
+
+void DataAppender::write(const unsigned char *data, ndsize_t rows) {
+    NDSize count = row_shape;
+    count[0] = rows;
+    array.appendData(dtype, data, count, 0);
+}
+
+
+DataAppender::~DataAppender() {
+    try {
+        flush();
+    } catch (...) {
+        // destructors must not throw; call flush to see errors
+    }
+}
+
+} // namespace nix
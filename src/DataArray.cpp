@@ -7,10 +7,16 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/DataArray.hpp>
+#include <nix/Tag.hpp>
+#include <nix/MultiTag.hpp>
+#include <nix/Feature.hpp>
+#include <nix/Group.hpp>
 
 #include <nix/util/util.hpp>
+#include <nix/util/dataAccess.hpp>
 #include "hdf5/h5x/H5DataType.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace nix;
@@ -26,6 +32,7 @@ static void convertData(DataType source, DataType destination, void *data, size_
 
 
 void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    util::TraceSpan span("DataArray::getData");
     const std::vector<double> poly = polynomCoefficients();
     boost::optional<double> opt_origin = expansionOrigin();
 
@@ -60,9 +67,45 @@ void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const ND
 }
 
 void DataArray::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    util::TraceSpan span("DataArray::setData");
     setDataDirect(dtype, data, count, offset);
 }
 
+
+void DataArray::setDataDirect(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    backend()->write(dtype, data, count, offset);
+    if (count.size() > 0 && backend()->envelopeFactor() > 0) {
+        updateEnvelope(offset[0], offset[0] + count[0]);
+    }
+}
+
+
+void DataArray::dataExtent(const NDSize &extent) {
+    const ndsize_t k = backend()->envelopeFactor();
+    if (k == 0) {
+        backend()->dataExtent(extent);
+        return;
+    }
+
+    const NDSize old = dataExtent();
+    backend()->dataExtent(extent);
+    if (extent.size() == 0) {
+        return;
+    }
+
+    bool same_shape = old.size() == extent.size() && extent[0] >= old[0];
+    for (size_t i = 1; same_shape && i < extent.size(); i++) {
+        same_shape = old[i] == extent[i];
+    }
+    if (!same_shape) {
+        // buckets of removed samples or of samples of another shape
+        backend()->createEnvelope(k);
+        updateEnvelope(0, extent[0]);
+    } else if (extent[0] > old[0]) {
+        updateEnvelope(old[0], extent[0]);
+    }
+}
+
 void DataArray::appendData(DataType dtype, const void *data, const NDSize &count, size_t axis) {
 
     //first some sanity checks
@@ -91,13 +134,312 @@ void DataArray::appendData(DataType dtype, const void *data, const NDSize &count
     offset[axis] = extent[axis];
     extent[axis] += count[axis];
 
-    //enlarge the DataArray to fit the new data
-    dataExtent(extent);
+    //enlarge the DataArray to fit the new data, setData updates the envelope
+    backend()->dataExtent(extent);
+    if (axis > 0 && backend()->envelopeFactor() > 0) {
+        // the samples changed shape: all buckets are rebuilt
+        backend()->createEnvelope(backend()->envelopeFactor());
+    }
 
     setData(dtype, data, count, offset);
+}
+
+void DataArray::rangeToOffsetAndCount(const std::vector<double> &start,
+                                      const std::vector<double> &stop,
+                                      const std::vector<std::string> &units,
+                                      NDSize &offset,
+                                      NDSize &count) const {
+    NDSize extent = dataExtent();
+    if (start.size() != extent.size() || stop.size() != extent.size()) {
+        throw IncompatibleDimensions("Number of positions does not match dimensionality of data",
+                                     "DataArray::rangeToOffsetAndCount");
+    }
+
+    NDSize range_offset(extent.size(), 0);
+    NDSize range_count(extent.size(), 1);
+    for (size_t i = 0; i < extent.size(); i++) {
+        // each dimension descriptor is read once for both ends of the range
+        util::PositionConverter converter(getDimension(i + 1));
+        const std::string unit = i < units.size() ? units[i] : "none";
+
+        ndssize_t first = converter.index(start[i], unit);
+        ndssize_t last = converter.index(stop[i], unit);
+        if (!converter.inBounds(first)) {
+            throw OutOfBounds("Start of the range is out of bounds of the dimension", i);
+        }
+        range_offset[i] = static_cast<ndsize_t>(first);
+        range_count[i] = static_cast<ndsize_t>(std::max(last - first, ndssize_t(1)));
+    }
+
+    if (!util::positionAndExtentInData(*this, range_offset, range_count)) {
+        throw OutOfBounds("Range is out of bounds of the data");
+    }
+    offset = range_offset;
+    count = range_count;
+}
+
+
+void DataArray::getDataInRange(DataType dtype,
+                               void *data,
+                               const std::vector<double> &start,
+                               const std::vector<double> &stop,
+                               const std::vector<std::string> &units) const {
+    NDSize offset, count;
+    rangeToOffsetAndCount(start, stop, units, offset, count);
+    getData(dtype, data, count, offset);
+}
+
+
+void DataArray::getDataInRange(DataType dtype,
+                               void *data,
+                               const NDSize &buffer_extent,
+                               const NDSize &buffer_offset,
+                               const std::vector<double> &start,
+                               const std::vector<double> &stop,
+                               const std::vector<std::string> &units) const {
+    NDSize offset, count;
+    rangeToOffsetAndCount(start, stop, units, offset, count);
+    if (buffer_extent.size() != count.size() || buffer_offset.size() != count.size()) {
+        throw IncompatibleDimensions("Buffer and data must have the same dimensionality",
+                                     "DataArray::getDataInRange");
+    }
+    if (buffer_offset + count > buffer_extent) {
+        throw OutOfBounds("Range does not fit into the buffer at the given offset");
+    }
+
+    util::TraceSpan span("DataArray::getData");
+    if (polynomCoefficients().empty() && !expansionOrigin()) {
+        backend()->read(dtype, data, count, offset, buffer_extent, buffer_offset);
+        return;
+    }
+
+    // calibrated data is read into a contiguous buffer and then placed row by row
+    const size_t esize = data_type_to_size(dtype);
+    const size_t nelms = check::fits_in_size_t(count.nelms(), "Range exceeds memory");
+    std::vector<char> tmp(nelms * esize);
+    ioRead(dtype, tmp.data(), count, offset);
+
+    const size_t rank = count.size();
+    const size_t row = check::fits_in_size_t(count[rank - 1], "Range exceeds memory") * esize;
+    NDSize index(rank, 0);
+    for (size_t n = 0; n < nelms; n += count[rank - 1]) {
+        NDSize target = buffer_offset + index;
+        size_t pos = 0;
+        for (size_t i = 0; i < rank; i++) {
+            pos = pos * static_cast<size_t>(buffer_extent[i]) + static_cast<size_t>(target[i]);
+        }
+        memcpy(static_cast<char *>(data) + pos * esize, tmp.data() + n * esize, row);
+
+        // next row: increment the index over all but the last dimension
+        for (size_t i = rank - 1; i-- > 0;) {
+            if (++index[i] < count[i]) {
+                break;
+            }
+            index[i] = 0;
+        }
+    }
+}
+
+
+namespace {
+
+// the number of samples read at once when reducing data
+const size_t reduce_block = 1 << 20;
+
+// reduce the samples [begin, end) along the first dimension to buckets of
+// span samples starting at begin, as triples of minimum, maximum and mean
+std::vector<double> reduceSamples(const DataArray &array, const NDSize &extent, size_t values,
+                                  ndsize_t begin, ndsize_t end, ndsize_t span) {
+    const size_t buckets = static_cast<size_t>((end - begin + span - 1) / span);
+    std::vector<double> result(buckets * values * 3);
+    std::vector<double> samples;
+
+    NDSize count = extent, offset(extent.size(), 0);
+    const ndsize_t step = std::max(ndsize_t(reduce_block / values / span), ndsize_t(1)) * span;
+    for (ndsize_t first = begin; first < end; first += step) {
+        count[0] = std::min(step, end - first);
+        offset[0] = first;
+        samples.resize(check::fits_in_size_t(count.nelms(), "DataArray::readEnvelope: range exceeds memory"));
+        array.getData(DataType::Double, samples.data(), count, offset);
+
+        for (size_t i = 0; i < count[0]; i += span) {
+            const size_t n = static_cast<size_t>(std::min(span, count[0] - i));
+            double *bucket = &result[((first - begin + i) / span) * values * 3];
+            for (size_t v = 0; v < values; v++) {
+                const double *sample = &samples[i * values + v];
+                double lo = *sample, hi = *sample, sum = 0;
+                for (size_t j = 0; j < n; j++, sample += values) {
+                    lo = std::min(lo, *sample);
+                    hi = std::max(hi, *sample);
+                    sum += *sample;
+                }
+                bucket[v * 3] = lo;
+                bucket[v * 3 + 1] = hi;
+                bucket[v * 3 + 2] = sum / n;
+            }
+        }
+    }
+    return result;
+}
+
+
+// the count and offset of buckets of an envelope level
+NDSize bucketCount(ndsize_t buckets, ndsize_t values) {
+    return NDSize({buckets, values, ndsize_t(3)});
+}
+
+
+NDSize bucketOffset(ndsize_t bucket) {
+    return NDSize({bucket, ndsize_t(0), ndsize_t(0)});
+}
 
+
+Envelope unpackEnvelope(const std::vector<double> &triples, ndsize_t offset, ndsize_t span, ndsize_t values) {
+    Envelope envelope{offset, span, triples.size() / 3 / values, values, {}, {}, {}};
+    const size_t n = triples.size() / 3;
+    envelope.min.resize(n);
+    envelope.max.resize(n);
+    envelope.mean.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        envelope.min[i] = triples[i * 3];
+        envelope.max[i] = triples[i * 3 + 1];
+        envelope.mean[i] = triples[i * 3 + 2];
+    }
+    return envelope;
 }
 
+} // anonymous namespace
+
+
+void DataArray::buildEnvelope(ndsize_t factor) {
+    if (dimensionCount() < 1 || getDimension(1).dimensionType() != DimensionType::Sample) {
+        throw IncompatibleDimensions("An envelope needs a sampled first dimension",
+                                     "DataArray::buildEnvelope");
+    }
+    backend()->createEnvelope(factor);
+    const NDSize extent = dataExtent();
+    if (extent.size() > 0) {
+        updateEnvelope(0, extent[0]);
+    }
+}
+
+
+void DataArray::updateEnvelope(ndsize_t from, ndsize_t to) {
+    const ndsize_t k = backend()->envelopeFactor();
+    const NDSize extent = dataExtent();
+    if (k == 0 || extent.size() == 0 || extent.nelms() == 0 || from >= to) {
+        return;
+    }
+    const ndsize_t n = extent[0];
+    const ndsize_t values = extent.nelms() / n;
+    const ndsize_t stored = backend()->envelopeLevelCount();
+
+    // level 1 from the data, in blocks of whole buckets; levels not
+    // stored yet are computed completely
+    ndsize_t buckets = (n + k - 1) / k;
+    ndsize_t first = stored > 0 ? from / k : 0;
+    ndsize_t last = stored > 0 ? std::min((to + k - 1) / k, buckets) : buckets;
+    const ndsize_t step = std::max(ndsize_t(reduce_block / values / k), ndsize_t(1));
+    for (ndsize_t b = first; b < last; b += step) {
+        ndsize_t end = std::min(b + step, last);
+        std::vector<double> triples = reduceSamples(*this, extent, values, b * k, std::min(end * k, n), k);
+        backend()->writeEnvelope(1, triples.data(), bucketCount(end - b, values), bucketOffset(b));
+    }
+
+    // each further level from the one below, weighting means by sample count
+    std::vector<double> lower, upper;
+    ndsize_t span = k;
+    for (ndsize_t level = 2; buckets > 1; level++) {
+        const ndsize_t lower_buckets = buckets;
+        buckets = (lower_buckets + k - 1) / k;
+        first = level <= stored ? first / k : 0;
+        last = level <= stored ? (last + k - 1) / k : buckets;
+
+        for (ndsize_t b = first; b < last; b += step) {
+            const ndsize_t end = std::min(b + step, last);
+            const ndsize_t lb = b * k, le = std::min(end * k, lower_buckets);
+            lower.resize(static_cast<size_t>((le - lb) * values * 3));
+            backend()->readEnvelope(level - 1, lower.data(), bucketCount(le - lb, values), bucketOffset(lb));
+            upper.assign(static_cast<size_t>((end - b) * values * 3), 0);
+
+            for (ndsize_t r = lb; r < le; r++) {
+                const double *src = &lower[static_cast<size_t>((r - lb) * values * 3)];
+                double *dst = &upper[static_cast<size_t>(((r - lb) / k) * values * 3)];
+                const bool head = (r - lb) % k == 0;
+                const double weight = static_cast<double>(std::min((r + 1) * span, n) - r * span);
+                for (size_t v = 0; v < values; v++) {
+                    dst[v * 3] = head ? src[v * 3] : std::min(dst[v * 3], src[v * 3]);
+                    dst[v * 3 + 1] = head ? src[v * 3 + 1] : std::max(dst[v * 3 + 1], src[v * 3 + 1]);
+                    dst[v * 3 + 2] += src[v * 3 + 2] * weight;
+                }
+            }
+            for (ndsize_t c = b; c < end; c++) {
+                const double samples = static_cast<double>(std::min((c + 1) * span * k, n) - c * span * k);
+                double *dst = &upper[static_cast<size_t>((c - b) * values * 3)];
+                for (size_t v = 0; v < values; v++) {
+                    dst[v * 3 + 2] /= samples;
+                }
+            }
+            backend()->writeEnvelope(level, upper.data(), bucketCount(end - b, values), bucketOffset(b));
+        }
+        span *= k;
+    }
+}
+
+
+Envelope DataArray::readEnvelopeIndices(ndsize_t begin, ndsize_t end, size_t target_points) const {
+    const NDSize extent = dataExtent();
+    if (extent.size() == 0) {
+        throw IncompatibleDimensions("DataArray has no dimensions", "DataArray::readEnvelopeIndices");
+    }
+    const ndsize_t n = extent[0];
+    const ndsize_t values = n > 0 ? extent.nelms() / n : 0;
+    end = std::min(end, n);
+    if (begin >= end || values == 0) {
+        return Envelope{begin, 1, 0, values, {}, {}, {}};
+    }
+    const ndsize_t target = std::max(target_points, size_t(1));
+
+    // the coarsest stored level with at least target buckets in the range
+    const ndsize_t k = backend()->envelopeFactor();
+    ndsize_t level = 0, span = 1;
+    if (k > 0) {
+        const ndsize_t levels = backend()->envelopeLevelCount();
+        while (level < levels && (end - begin) / (span * k) >= target) {
+            level++;
+            span *= k;
+        }
+    }
+
+    if (level > 0) {
+        const ndsize_t b0 = begin / span, b1 = (end + span - 1) / span;
+        // a level that does not match the data was not updated with it
+        if (backend()->envelopeExtent(level) == bucketCount((n + span - 1) / span, values)) {
+            std::vector<double> triples(check::fits_in_size_t((b1 - b0) * values * 3,
+                                                              "DataArray::readEnvelope: range exceeds memory"));
+            backend()->readEnvelope(level, triples.data(), bucketCount(b1 - b0, values), bucketOffset(b0));
+            return unpackEnvelope(triples, b0 * span, span, values);
+        }
+    }
+
+    span = std::max((end - begin) / target, ndsize_t(1));
+    return unpackEnvelope(reduceSamples(*this, extent, values, begin, end, span), begin, span, values);
+}
+
+
+Envelope DataArray::readEnvelope(double start, double end, size_t target_points, const std::string &unit) const {
+    if (dimensionCount() < 1) {
+        throw IncompatibleDimensions("DataArray has no dimensions", "DataArray::readEnvelope");
+    }
+    util::PositionConverter converter(getDimension(1));
+    ndssize_t first = converter.index(start, unit);
+    ndssize_t last = first + std::max(converter.index(end, unit) - first, ndssize_t(1));
+    first = std::max(first, ndssize_t(0));
+    last = std::max(last, first);
+    return readEnvelopeIndices(static_cast<ndsize_t>(first), static_cast<ndsize_t>(last), target_points);
+}
+
+
 void DataArray::unit(const std::string &unit) {
     util::checkEmptyString(unit, "unit");
     if (!unit.empty() && !(util::isSIUnit(unit) || util::isCompoundSIUnit(unit))) {
@@ -115,6 +457,36 @@ std::vector<Dimension> DataArray::dimensions(const util::Filter<Dimension>::type
 }
 
 
+namespace {
+
+template<typename T, typename B>
+std::vector<T> wrapAll(const std::vector<std::shared_ptr<B>> &impls) {
+    return std::vector<T>(impls.begin(), impls.end());
+}
+
+} // anonymous namespace
+
+
+std::vector<Tag> DataArray::referencingTags() const {
+    return wrapAll<Tag>(backend()->referencingTags());
+}
+
+
+std::vector<MultiTag> DataArray::referencingMultiTags() const {
+    return wrapAll<MultiTag>(backend()->referencingMultiTags());
+}
+
+
+std::vector<Feature> DataArray::referencingFeatures() const {
+    return wrapAll<Feature>(backend()->referencingFeatures());
+}
+
+
+std::vector<Group> DataArray::referencingGroups() const {
+    return wrapAll<Group>(backend()->referencingGroups());
+}
+
+
 std::ostream& nix::operator<<(std::ostream &out, const DataArray &ent) {
     out << "DataArray: {name = " << ent.name();
     out << ", type = " << ent.type();
@@ -8,6 +8,7 @@
 
 #include <nix/File.hpp>
 #include <nix/util/util.hpp>
+#include <nix/util/trace.hpp>
 #include "hdf5/FileHDF5.hpp"
 
 #ifdef ENABLE_FS_BACKEND
@@ -17,12 +18,18 @@
 #include <nix/valid/validate.hpp>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
 namespace bfs = boost::filesystem;
 
 namespace nix {
 
 File File::open(const std::string &name, FileMode mode, const std::string &impl) {
-    if (mode == nix::FileMode::ReadOnly && !bfs::exists({name})) {
+    util::TraceSpan span("File::open");
+    if (mode == nix::FileMode::ReadOnly && !bfs::exists(bfs::path(name))) {
         throw std::runtime_error("Cannot open non-existent file in ReadOnly mode!");
     }
     if (impl == "hdf5") {
@@ -53,6 +60,19 @@ Block File::createBlock(const std::string &name, const std::string &type) {
 }
 
 
+Block File::copyBlock(const Block &block, const std::string &name, CopyIds ids) {
+    if (!util::checkEntityInput(block)) {
+        throw UninitializedEntity();
+    }
+    const std::string copy_name = name.empty() ? block.name() : name;
+    util::checkEntityName(copy_name);
+    if (backend()->hasBlock(copy_name)) {
+        throw DuplicateName("copyBlock");
+    }
+    return backend()->copyBlock(block.impl(), copy_name, ids);
+}
+
+
 bool File::hasBlock(const Block &block) const {
     if(!util::checkEntityInput(block, false)) {
         return false;
@@ -120,72 +140,55 @@ std::vector<Section> File::findSections(const util::Filter<Section>::type &filte
 
 
 valid::Result File::validate() const {
-    valid::Result result;
+    return validate(1);
+}
+
+
+valid::Result File::validate(size_t threads) const {
+    util::TraceSpan span("File::validate");
     // now get all entities from the file: use the multi-getter for each type of entity
     // (the multi-getters use size_t-getter which in the end use H5Lget_name_by_idx
     // to get each file objects name - the count is determined by H5::Group::getNumObjs
     // so that in the end really all file objects are retrieved)
-
-    // Blocks
-    auto blcks = blocks();
-    for (auto &block : blcks) {
-        result.concat(valid::validate(block));
-        // DataArrays
-        auto data_arrays = block.dataArrays();
-        for (auto &data_array : data_arrays) {
-            result.concat(valid::validate(data_array));
-            // Dimensions
-            auto dims = data_array.dimensions();
-            for (auto &dim : dims) {
-                if (dim.dimensionType() == DimensionType::Range) {
-                    auto d = dim.asRangeDimension();
-                    result.concat(valid::validate(d));
+    std::vector<Block> blcks = blocks();
+    std::vector<Section> sections = findSections();
+
+    // one result per block and per section, concatenated in order at the end
+    size_t total = blcks.size() + sections.size();
+    std::vector<valid::Result> results(total);
+    std::vector<std::exception_ptr> errors(total);
+    std::atomic<size_t> next(0);
+
+    auto work = [&] {
+        for (size_t i = next++; i < total; i = next++) {
+            try {
+                if (i < blcks.size()) {
+                    results[i] = valid::validateAll(blcks[i]);
+                } else {
+                    results[i] = valid::validateAll(sections[i - blcks.size()]);
                 }
-                if (dim.dimensionType() == DimensionType::Set) {
-                    auto d = dim.asSetDimension();
-                    result.concat(valid::validate(d));
-                }
-                if (dim.dimensionType() == DimensionType::Sample) {
-                    auto d = dim.asSampledDimension();
-                    result.concat(valid::validate(d));
-                }
-            }
-        }
-        // MultiTags
-        auto multi_tags = block.multiTags();
-        for (auto &multi_tag : multi_tags) {
-            result.concat(valid::validate(multi_tag));
-            // Features
-            auto features = multi_tag.features();
-            for (auto &feature : features) {
-                result.concat(valid::validate(feature));
-            }
-        }
-        // Tags
-        auto tags = block.tags();
-        for (auto &tag : tags) {
-            result.concat(valid::validate(tag));
-            // Features
-            auto features = tag.features();
-            for (auto &feature : features) {
-                result.concat(valid::validate(feature));
+            } catch (...) {
+                errors[i] = std::current_exception();
             }
         }
-        // Sources
-        auto sources = block.findSources();
-        for (auto &source : sources) {
-            result.concat(valid::validate(source));
-        }
+    };
+
+    threads = std::min(threads, total);
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; i++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &t : pool) {
+        t.join();
     }
-    // Sections
-    auto sections = findSections();
-    for (auto &section : sections) {
-        result.concat(valid::validate(section));
-        // Properties
-        auto props = section.properties();
-        for (auto &prop : props) {
-            result.concat(valid::validate(prop));
+
+    valid::Result result;
+    for (size_t i = 0; i < total; i++) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
         }
+        result.concat(results[i]);
     }
 
     return result;
@@ -196,6 +199,7 @@ void File::close() {
     if (!isNone()) {
         backend()->close();
         nullify();
+        util::flushTrace();
     }
 }
 
@@ -0,0 +1,210 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/IntervalIndex.hpp>
+
+#include <nix/Tag.hpp>
+#include <nix/MultiTag.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace nix {
+
+namespace {
+
+const size_t no_node = numeric_limits<size_t>::max();
+
+string unitOf(const vector<string> &units, size_t dimension) {
+    return dimension < units.size() ? units[dimension] : "none";
+}
+
+
+Dimension checkedDimension(const DataArray &array, ndsize_t dimension) {
+    if (dimension < 1 || dimension > array.dimensionCount()) {
+        throw OutOfBounds("IntervalIndex: invalid dimension", 0);
+    }
+    return array.getDimension(dimension);
+}
+
+} // anonymous namespace
+
+
+IntervalIndex::IntervalIndex(const DataArray &array, ndsize_t dimension)
+    : root(no_node), converter(checkedDimension(array, dimension)) {
+    const size_t axis = static_cast<size_t>(dimension - 1);
+
+    // a region like util::getOffsetAndCount computes it, unless it starts out of bounds
+    auto add = [&](double position, const double *extent, const string &unit,
+                   const string &tag, bool multi_tag, ndsize_t index) {
+        ndssize_t begin = converter.index(position, unit);
+        if (!converter.inBounds(begin)) {
+            return;
+        }
+        ndssize_t count = 1;
+        if (extent) {
+            count = max(converter.index(position + *extent, unit) - begin, ndssize_t(1));
+        }
+        intervals.push_back(Interval{static_cast<ndsize_t>(begin), static_cast<ndsize_t>(begin + count),
+                                     tag, multi_tag, index});
+    };
+
+    for (const Tag &tag : array.referencingTags()) {
+        vector<double> position = tag.position();
+        vector<double> extent = tag.extent();
+        if (axis >= position.size()) {
+            continue;
+        }
+        add(position[axis], axis < extent.size() ? &extent[axis] : nullptr,
+            unitOf(tag.units(), axis), tag.id(), false, 0);
+    }
+
+    for (const MultiTag &tag : array.referencingMultiTags()) {
+        // multi tags that only use the array as positions or extents do not mark it
+        if (!tag.hasReference(array.id()) || !tag.hasPositions()) {
+            continue;
+        }
+        DataArray positions = tag.positions();
+        NDSize shape = positions.dataExtent();
+        if (shape.size() == 0 || shape.size() > 2) {
+            continue;
+        }
+        size_t count = check::fits_in_size_t(shape[0], "IntervalIndex: too many positions");
+        size_t width = shape.size() > 1 ? static_cast<size_t>(shape[1]) : 1;
+        if (axis >= width) {
+            continue;
+        }
+
+        // the positions and extents are read once, not row by row
+        vector<double> starts(count * width);
+        positions.getData(DataType::Double, starts.data(), shape, NDSize(shape.size(), 0));
+
+        vector<double> extents;
+        DataArray extents_array = tag.extents();
+        if (extents_array && extents_array.dataExtent() == shape) {
+            extents.resize(starts.size());
+            extents_array.getData(DataType::Double, extents.data(), shape, NDSize(shape.size(), 0));
+        }
+
+        string unit = unitOf(tag.units(), axis);
+        for (size_t i = 0; i < count; i++) {
+            size_t k = i * width + axis;
+            add(starts[k], extents.empty() ? nullptr : &extents[k], unit, tag.id(), true, i);
+        }
+    }
+
+    vector<size_t> members(intervals.size());
+    for (size_t i = 0; i < members.size(); i++) {
+        members[i] = i;
+    }
+    root = build(members);
+}
+
+
+size_t IntervalIndex::build(vector<size_t> &members) {
+    if (members.empty()) {
+        return no_node;
+    }
+
+    // the median of all endpoints splits the intervals about evenly; the
+    // interval the median belongs to contains it, so every node holds one
+    vector<ndsize_t> points;
+    points.reserve(members.size() * 2);
+    for (size_t m : members) {
+        points.push_back(intervals[m].begin);
+        points.push_back(intervals[m].end - 1);
+    }
+    auto mid = points.begin() + points.size() / 2;
+    nth_element(points.begin(), mid, points.end());
+    const ndsize_t center = *mid;
+
+    Node node;
+    node.center = center;
+    vector<size_t> left, right;
+    for (size_t m : members) {
+        if (intervals[m].end <= center) {
+            left.push_back(m);
+        } else if (intervals[m].begin > center) {
+            right.push_back(m);
+        } else {
+            node.by_begin.push_back(m);
+        }
+    }
+    members.clear();
+    members.shrink_to_fit();
+
+    node.by_end = node.by_begin;
+    sort(node.by_begin.begin(), node.by_begin.end(), [this](size_t a, size_t b) {
+        return intervals[a].begin < intervals[b].begin;
+    });
+    sort(node.by_end.begin(), node.by_end.end(), [this](size_t a, size_t b) {
+        return intervals[a].end > intervals[b].end;
+    });
+
+    node.left = build(left);
+    node.right = build(right);
+    nodes.push_back(std::move(node));
+    return nodes.size() - 1;
+}
+
+
+void IntervalIndex::query(size_t index, ndsize_t begin, ndsize_t end, vector<Interval> &result) const {
+    while (index != no_node) {
+        const Node &node = nodes[index];
+
+        if (end <= node.center) {
+            // the range is left of the center: intervals here end behind it
+            for (size_t m : node.by_begin) {
+                if (intervals[m].begin >= end) {
+                    break;
+                }
+                result.push_back(intervals[m]);
+            }
+            index = node.left;
+        } else if (begin > node.center) {
+            // the range is right of the center: intervals here start before it
+            for (size_t m : node.by_end) {
+                if (intervals[m].end <= begin) {
+                    break;
+                }
+                result.push_back(intervals[m]);
+            }
+            index = node.right;
+        } else {
+            for (size_t m : node.by_begin) {
+                result.push_back(intervals[m]);
+            }
+            query(node.left, begin, end, result);
+            index = node.right;
+        }
+    }
+}
+
+
+vector<IntervalIndex::Interval> IntervalIndex::overlappingIndices(ndsize_t begin, ndsize_t end) const {
+    vector<Interval> result;
+    if (begin < end) {
+        query(root, begin, end, result);
+    }
+    return result;
+}
+
+
+vector<IntervalIndex::Interval> IntervalIndex::overlapping(double start, double end, const string &unit) const {
+    ndssize_t first = converter.index(start, unit);
+    ndssize_t last = first + max(converter.index(end, unit) - first, ndssize_t(1));
+    if (last <= 0) {
+        return vector<Interval>();
+    }
+    return overlappingIndices(static_cast<ndsize_t>(max(first, ndssize_t(0))), static_cast<ndsize_t>(last));
+}
+
+} // namespace nix
@@ -0,0 +1,315 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MetadataSnapshot.hpp>
+
+#include <nix/Section.hpp>
+#include <nix/Property.hpp>
+#include <nix/Exception.hpp>
+#include <nix/util/trace.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+
+namespace nix {
+
+namespace {
+
+// property name, value type and value data
+std::string valueKey(const std::string &name, const Value &value) {
+    std::ostringstream key;
+    key << name << '\0' << static_cast<int>(value.type()) << '\0';
+
+    switch (value.type()) {
+        case DataType::Bool:   key << value.get<bool>(); break;
+        case DataType::String: key << value.get<std::string>(); break;
+        case DataType::Int32:  key << value.get<int32_t>(); break;
+        case DataType::UInt32: key << value.get<uint32_t>(); break;
+        case DataType::Int64:  key << value.get<int64_t>(); break;
+        case DataType::UInt64: key << value.get<uint64_t>(); break;
+        case DataType::Double: key << std::setprecision(17) << value.get<double>(); break;
+        default: break;
+    }
+    return key.str();
+}
+
+const std::vector<size_t> &find_indexed(const std::unordered_map<std::string, std::vector<size_t>> &index,
+                                        const std::string &key) {
+    static const std::vector<size_t> empty;
+    auto it = index.find(key);
+    return it == index.end() ? empty : it->second;
+}
+
+void erase_index(std::vector<size_t> &sections, size_t index) {
+    sections.erase(std::remove(sections.begin(), sections.end(), index), sections.end());
+}
+
+} // anonymous namespace
+
+
+const size_t MetadataSnapshot::npos = std::numeric_limits<size_t>::max();
+
+
+MetadataSnapshot::MetadataSnapshot(const File &file) {
+    util::TraceSpan span("MetadataSnapshot::load");
+
+    // depth first, every section is opened exactly once
+    std::vector<std::pair<Section, size_t>> todo;
+    std::vector<std::pair<size_t, std::string>> links;
+
+    std::vector<Section> top = file.sections();
+    for (auto it = top.rbegin(); it != top.rend(); ++it) {
+        todo.emplace_back(*it, npos);
+    }
+
+    while (!todo.empty()) {
+        Section current = todo.back().first;
+        size_t parent = todo.back().second;
+        todo.pop_back();
+
+        size_t index = section_nodes.size();
+        SectionNode node;
+        node.id = current.id();
+        node.name = current.name();
+        node.type = current.type();
+        node.definition = current.definition();
+        node.repository = current.repository();
+        node.parent = parent;
+        node.link = npos;
+        node.level = parent == npos ? 0 : section_nodes[parent].level + 1;
+
+        Section link = current.link();
+        if (!link.isNone()) {
+            links.emplace_back(index, link.id());
+        }
+
+        for (const Property &prop : current.properties()) {
+            size_t pindex = property_nodes.size();
+            PropertyNode pnode;
+            pnode.id = prop.id();
+            pnode.name = prop.name();
+            pnode.dataType = prop.dataType();
+            pnode.definition = prop.definition();
+            pnode.unit = prop.unit();
+            pnode.values = prop.values();
+            pnode.section = index;
+
+            property_ids.emplace(pnode.id, pindex);
+            property_names[pnode.name].push_back(pindex);
+            std::unordered_set<std::string> keys;
+            for (const Value &value : pnode.values) {
+                std::string key = valueKey(pnode.name, value);
+                if (keys.insert(key).second) {
+                    property_values[key].push_back(index);
+                }
+            }
+
+            node.properties.push_back(pindex);
+            property_nodes.push_back(std::move(pnode));
+        }
+
+        section_ids.emplace(node.id, index);
+        section_names[node.name].push_back(index);
+        section_types[node.type].push_back(index);
+
+        if (parent == npos) {
+            roots.push_back(index);
+        } else {
+            section_nodes[parent].sections.push_back(index);
+        }
+
+        std::vector<Section> children = current.sections();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            todo.emplace_back(*it, index);
+        }
+        section_nodes.push_back(std::move(node));
+    }
+
+    for (const auto &link : links) {
+        boost::optional<size_t> target = sectionById(link.second);
+        if (target) {
+            section_nodes[link.first].link = *target;
+        }
+    }
+}
+
+
+boost::optional<size_t> MetadataSnapshot::sectionById(const std::string &id) const {
+    auto it = section_ids.find(id);
+    return it == section_ids.end() ? boost::optional<size_t>() : it->second;
+}
+
+
+boost::optional<size_t> MetadataSnapshot::propertyById(const std::string &id) const {
+    auto it = property_ids.find(id);
+    return it == property_ids.end() ? boost::optional<size_t>() : it->second;
+}
+
+
+const std::vector<size_t> &MetadataSnapshot::sectionsByName(const std::string &name) const {
+    return find_indexed(section_names, name);
+}
+
+
+const std::vector<size_t> &MetadataSnapshot::sectionsByType(const std::string &type) const {
+    return find_indexed(section_types, type);
+}
+
+
+std::vector<size_t> MetadataSnapshot::sectionsWithProperty(const std::string &name) const {
+    std::vector<size_t> sections;
+    for (size_t prop : find_indexed(property_names, name)) {
+        sections.push_back(property_nodes[prop].section);
+    }
+    return sections;
+}
+
+
+std::vector<size_t> MetadataSnapshot::sectionsWithProperty(const std::string &name, const Value &value) const {
+    return find_indexed(property_values, valueKey(name, value));
+}
+
+
+boost::optional<size_t> MetadataSnapshot::propertyByName(size_t section, const std::string &name) const {
+    for (size_t prop : section_nodes.at(section).properties) {
+        if (property_nodes[prop].name == name) {
+            return prop;
+        }
+    }
+    return boost::none;
+}
+
+
+std::vector<size_t> MetadataSnapshot::inheritedProperties(size_t section) const {
+    const SectionNode &node = section_nodes.at(section);
+    std::vector<size_t> props = node.properties;
+    if (node.link == npos) {
+        return props;
+    }
+
+    std::unordered_set<std::string> own;
+    for (size_t prop : props) {
+        own.insert(property_nodes[prop].name);
+    }
+    for (size_t prop : section_nodes[node.link].properties) {
+        if (own.count(property_nodes[prop].name) == 0) {
+            props.push_back(prop);
+        }
+    }
+    return props;
+}
+
+
+std::vector<size_t> MetadataSnapshot::findSections(size_t section, const SectionFilter &filter,
+                                                   size_t max_depth) const {
+    std::vector<size_t> results;
+    std::deque<std::pair<size_t, size_t>> todo;
+    if (section >= section_nodes.size()) {
+        throw OutOfBounds("MetadataSnapshot::findSections(): no such section", section);
+    }
+    todo.emplace_back(section, 0);
+
+    while (!todo.empty()) {
+        size_t current = todo.front().first;
+        size_t depth = todo.front().second;
+        todo.pop_front();
+
+        if (filter(section_nodes[current])) {
+            results.push_back(current);
+        }
+
+        if (depth < max_depth) {
+            for (size_t child : section_nodes[current].sections) {
+                todo.emplace_back(child, depth + 1);
+            }
+        }
+    }
+
+    return results;
+}
+
+
+std::vector<size_t> MetadataSnapshot::findSections(const SectionFilter &filter, size_t max_depth) const {
+    std::vector<size_t> results;
+    for (size_t root : roots) {
+        std::vector<size_t> found = findSections(root, filter, max_depth);
+        results.insert(results.end(), found.begin(), found.end());
+    }
+    return results;
+}
+
+
+std::vector<size_t> MetadataSnapshot::findRelated(size_t section, const SectionFilter &filter) const {
+    std::vector<size_t> results = findDownstream(section, filter);
+    erase_index(results, section);
+
+    if (results.empty()) {
+        results = findUpstream(section, filter);
+    }
+    erase_index(results, section);
+
+    if (results.empty()) {
+        results = findSideways(section, filter, section);
+    }
+    return results;
+}
+
+
+std::vector<size_t> MetadataSnapshot::findDownstream(size_t section, const SectionFilter &filter) const {
+    std::vector<size_t> results;
+    size_t max_depth = treeDepth(section);
+    for (size_t depth = 1; results.empty() && depth <= max_depth; depth++) {
+        results = findSections(section, filter, depth);
+    }
+    return results;
+}
+
+
+std::vector<size_t> MetadataSnapshot::findUpstream(size_t section, const SectionFilter &filter) const {
+    for (size_t p = section_nodes.at(section).parent; p != npos; p = section_nodes[p].parent) {
+        std::vector<size_t> results = findSections(p, filter, 1);
+        if (!results.empty()) {
+            return results;
+        }
+    }
+    return std::vector<size_t>();
+}
+
+
+std::vector<size_t> MetadataSnapshot::findSideways(size_t section, const SectionFilter &filter, size_t caller) const {
+    for (size_t p = section_nodes.at(section).parent; p != npos; p = section_nodes[p].parent) {
+        std::vector<size_t> results = findSections(p, filter, 1);
+        if (!results.empty()) {
+            erase_index(results, caller);
+            return results;
+        }
+    }
+    return std::vector<size_t>();
+}
+
+
+size_t MetadataSnapshot::treeDepth(size_t section) const {
+    // iterative, the depth of deep trees must not exhaust the stack
+    size_t depth = 0;
+    std::vector<std::pair<size_t, size_t>> todo{{section, 0}};
+    while (!todo.empty()) {
+        auto current = todo.back();
+        todo.pop_back();
+        depth = std::max(depth, current.second);
+        for (size_t child : section_nodes[current.first].sections) {
+            todo.emplace_back(child, current.second + 1);
+        }
+    }
+    return depth;
+}
+
+} // namespace nix
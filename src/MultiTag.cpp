@@ -100,6 +100,7 @@ std::vector<DataArray> MultiTag::references(const util::Filter<DataArray>::type
 
 
 DataView MultiTag::retrieveData(size_t position_index, size_t reference_index) const {
+    util::TraceSpan span("MultiTag::retrieveData");
     return util::retrieveData(*this, position_index, reference_index);
 }
 
@@ -127,6 +128,7 @@ bool MultiTag::deleteFeature(const Feature &feature) {
 
 
 DataView MultiTag::retrieveFeatureData(size_t position_index, size_t feature_index) const {
+    util::TraceSpan span("MultiTag::retrieveFeatureData");
     return util::retrieveFeatureData(*this, position_index, feature_index);
 }
 
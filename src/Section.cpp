@@ -11,6 +11,7 @@
 #include <list>
 #include <algorithm>
 #include <iterator>
+#include <unordered_set>
 #include <nix/Block.hpp>
 #include <nix/File.hpp>
 #include <nix/DataArray.hpp>
@@ -329,6 +330,21 @@ Property Section::createProperty(const std::string &name, const Value &value) {
     return backend()->createProperty(name, value);
 }
 
+std::vector<Property> Section::createProperties(const std::vector<PropertySpec> &specs) {
+    std::unordered_set<std::string> names;
+    for (const auto &spec : specs) {
+        if (spec.values.size() < 1)
+            throw std::runtime_error("Trying to create a property without a value!");
+        util::checkEntityName(spec.name);
+        if (!names.insert(spec.name).second) {
+            throw DuplicateName("createProperties");
+        }
+    }
+
+    std::vector<std::shared_ptr<base::IProperty>> props = backend()->createProperties(specs);
+    return std::vector<Property>(props.begin(), props.end());
+}
+
 Section Section::getSection(ndsize_t index) const {
     if (index >= backend()->sectionCount()) {
         throw OutOfBounds("Section::getSection: index is out of bounds!");
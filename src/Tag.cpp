@@ -118,11 +118,13 @@ bool Tag::deleteFeature(const Feature &feature) {
 
 
 DataView Tag::retrieveData(size_t reference_index) const {
+    util::TraceSpan span("Tag::retrieveData");
     return util::retrieveData(*this, reference_index);
 }
 
 
 DataView Tag::retrieveFeatureData(size_t feature_index) const {
+    util::TraceSpan span("Tag::retrieveFeatureData");
     return util::retrieveFeatureData(*this, feature_index);
 }
 
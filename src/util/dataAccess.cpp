@@ -9,6 +9,7 @@
 #include <nix/util/dataAccess.hpp>
 
 #include <nix/util/util.hpp>
+#include <nix/util/trace.hpp>
 
 #include <string>
 #include <cstdlib>
@@ -24,6 +25,7 @@ namespace util {
 
 
 ndsize_t positionToIndex(double position, const string &unit, const Dimension &dimension) {
+    TraceSpan span("positionToIndex");
     ndsize_t pos;
     if (dimension.dimensionType() == nix::DimensionType::Sample) {
         SampledDimension dim;
@@ -92,6 +94,79 @@ ndsize_t positionToIndex(double position, const string &unit, const RangeDimensi
 }
 
 
+PositionConverter::PositionConverter(const Dimension &dimension)
+    : type(dimension.dimensionType()), offset(0.0), sampling_interval(1.0), label_count(0),
+      cached_scaling(1.0) {
+    if (type == DimensionType::Sample) {
+        SampledDimension dim = dimension.asSampledDimension();
+        unit = dim.unit();
+        offset = dim.offset() ? *dim.offset() : 0.0;
+        sampling_interval = dim.samplingInterval();
+    } else if (type == DimensionType::Range) {
+        RangeDimension dim = dimension.asRangeDimension();
+        unit = dim.unit();
+        ticks = dim.ticks();
+    } else {
+        label_count = dimension.asSetDimension().labels().size();
+    }
+}
+
+
+double PositionConverter::scaling(const string &position_unit) const {
+    if (!unit || position_unit == "none") {
+        return 1.0;
+    }
+    if (position_unit != cached_unit) {
+        try {
+            cached_scaling = util::getSIScaling(position_unit, *unit);
+        } catch (...) {
+            throw nix::IncompatibleDimensions("Provided units are not scalable!", "nix::util::PositionConverter");
+        }
+        cached_unit = position_unit;
+    }
+    return cached_scaling;
+}
+
+
+ndssize_t PositionConverter::index(double position, const string &position_unit) const {
+    const bool has_unit = !position_unit.empty() && position_unit != "none";
+
+    if (type == DimensionType::Set) {
+        if (has_unit) {
+            throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension",
+                                              "nix::util::PositionConverter");
+        }
+        return static_cast<ndssize_t>(round(position));
+    }
+
+    if (type == DimensionType::Sample) {
+        if (!unit && has_unit) {
+            throw nix::IncompatibleDimensions("Units of position and SampledDimension must both be given!",
+                                              "nix::util::PositionConverter");
+        }
+        return static_cast<ndssize_t>(round((position * scaling(position_unit) - offset) / sampling_interval));
+    }
+
+    // range dimension, clamped to the ticks like RangeDimension::indexOf
+    position *= scaling(position_unit);
+    if (ticks.empty() || position < ticks.front()) {
+        return 0;
+    } else if (position > ticks.back()) {
+        return static_cast<ndssize_t>(ticks.size() - 1);
+    }
+    return lower_bound(ticks.begin(), ticks.end(), position) - ticks.begin();
+}
+
+
+bool PositionConverter::inBounds(ndssize_t index) const {
+    if (index < 0) {
+        return false;
+    }
+    // like positionToIndex, a set dimension accepts the index one past its labels
+    return type != DimensionType::Set || label_count == 0 || static_cast<size_t>(index) <= label_count;
+}
+
+
 void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, NDSize &count) {
     vector<double> position = tag.position();
     vector<double> extent = tag.extent();
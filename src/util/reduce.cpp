@@ -0,0 +1,339 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/reduce.hpp>
+
+#include <nix/DataArray.hpp>
+#include <nix/Exception.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <stdexcept>
+
+namespace nix {
+namespace util {
+
+namespace {
+
+// the number of values of a tile chosen by tileRows
+const ndsize_t tile_values = 1 << 20;
+
+// the number of partial sums; values at positions p and p + lanes share one
+const size_t lanes = 4;
+
+
+// the running count, mean and sum of squared deviations from the mean
+// (Welford), which unlike a sum of squares does not lose the variance
+// of values far from zero to cancellation
+struct Moments {
+    double count;
+    double mean;
+    double m2;
+
+    void add(double x) {
+        count += 1;
+        const double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    }
+
+    // combine with the moments of other values (Chan et al.)
+    void merge(const Moments &other) {
+        if (other.count == 0) {
+            return;
+        }
+        const double total = count + other.count;
+        const double delta = other.mean - mean;
+        mean += delta * (other.count / total);
+        m2 += other.m2 + delta * delta * (count * other.count / total);
+        count = total;
+    }
+};
+
+
+inline void addValue(double &sum, Moments &moments, double x) {
+    sum += x;
+    moments.add(x);
+}
+
+
+class Accumulator {
+public:
+
+    Accumulator()
+        : count(0), lo(std::numeric_limits<double>::infinity()),
+          hi(-std::numeric_limits<double>::infinity()) {
+        std::fill(sums, sums + lanes, 0.0);
+        std::fill(moments, moments + lanes, Moments{0.0, 0.0, 0.0});
+    }
+
+    // add n values, the first of which is at position in the data
+    void add(const double *values, size_t n, ndsize_t position) {
+        size_t i = 0;
+        for (; i < n && (position + i) % lanes != 0; i++) {
+            size_t lane = static_cast<size_t>((position + i) % lanes);
+            addValue(sums[lane], moments[lane], values[i]);
+        }
+        for (; i + lanes <= n; i += lanes) {
+            for (size_t lane = 0; lane < lanes; lane++) {
+                addValue(sums[lane], moments[lane], values[i + lane]);
+            }
+        }
+        for (; i < n; i++) {
+            size_t lane = static_cast<size_t>((position + i) % lanes);
+            addValue(sums[lane], moments[lane], values[i]);
+        }
+
+        for (i = 0; i < n; i++) {
+            lo = values[i] < lo ? values[i] : lo;
+            hi = values[i] > hi ? values[i] : hi;
+        }
+        count += n;
+    }
+
+    Statistics result() const {
+        Moments low = moments[0], high = moments[2];
+        low.merge(moments[1]);
+        high.merge(moments[3]);
+        low.merge(high);
+        return Statistics{count, (sums[0] + sums[1]) + (sums[2] + sums[3]), low.m2, lo, hi};
+    }
+
+private:
+
+    ndsize_t count;
+    double sums[lanes];
+    Moments moments[lanes];
+    double lo;
+    double hi;
+};
+
+
+class HistogramAccumulator {
+public:
+
+    HistogramAccumulator(double lower, double upper, size_t bins)
+        : histogram{lower, upper, std::vector<ndsize_t>(bins, 0), 0, 0},
+          scale(bins / (upper - lower)) {
+    }
+
+    void add(const double *values, size_t n) {
+        const size_t last = histogram.bins.size() - 1;
+        for (size_t i = 0; i < n; i++) {
+            const double x = values[i];
+            if (x < histogram.lower) {
+                histogram.below++;
+            } else if (x >= histogram.upper) {
+                histogram.above++;
+            } else if (x == x) {
+                // rounding may put values just below upper past the last bin
+                histogram.bins[std::min(static_cast<size_t>((x - histogram.lower) * scale), last)]++;
+            }
+        }
+    }
+
+    Histogram histogram;
+
+private:
+
+    double scale;
+};
+
+
+void checkHistogram(double lower, double upper, size_t bins) {
+    if (bins == 0) {
+        throw std::invalid_argument("histogram: bins must not be 0");
+    }
+    if (!(lower < upper)) {
+        throw std::invalid_argument("histogram: lower must be below upper");
+    }
+}
+
+
+// the number of values along and behind an axis
+void axisShape(const DataSet &data, size_t axis, size_t &channels, ndsize_t &inner) {
+    NDSize extent = data.dataExtent();
+    if (axis >= extent.size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+    channels = check::fits_in_size_t(extent[axis], "too many channels");
+    inner = 1;
+    for (size_t i = axis + 1; i < extent.size(); i++) {
+        inner *= extent[i];
+    }
+}
+
+
+// call f(channel, values, n, position) for the runs of a tile that belong to one channel
+template<typename F>
+void forEachRun(const double *values, const NDSize &count, const NDSize &offset,
+                size_t channels, ndsize_t inner, F f) {
+    const ndsize_t row = count.nelms() / count[0];
+    const ndsize_t first = offset[0] * row;
+    const size_t n = static_cast<size_t>(count.nelms());
+    for (size_t i = 0; i < n;) {
+        const ndsize_t position = first + i;
+        const size_t run = static_cast<size_t>(std::min(ndsize_t(n - i), inner - position % inner));
+        f(static_cast<size_t>((position / inner) % channels), values + i, run, position);
+        i += run;
+    }
+}
+
+} // anonymous namespace
+
+
+double Statistics::mean() const {
+    return sum / count;
+}
+
+
+double Statistics::variance() const {
+    return squaredDeviations / count;
+}
+
+
+ndsize_t tileRows(const DataSet &data, ndsize_t tile_rows) {
+    NDSize extent = data.dataExtent();
+    if (extent.size() == 0 || extent[0] == 0) {
+        return 0;
+    }
+    if (tile_rows > 0) {
+        return std::min(tile_rows, extent[0]);
+    }
+
+    const ndsize_t row = std::max(extent.nelms() / extent[0], ndsize_t(1));
+    ndsize_t rows = std::max(tile_values / row, ndsize_t(1));
+
+    const DataArray *array = dynamic_cast<const DataArray *>(&data);
+    if (array) {
+        NDSize chunk = array->dataChunking();
+        if (chunk.size() > 0 && chunk[0] > 0) {
+            rows = std::max(rows / chunk[0], ndsize_t(1)) * chunk[0];
+        }
+    }
+    return std::min(rows, extent[0]);
+}
+
+
+void forEachTile(const DataSet &data, const TileKernel &kernel, ndsize_t tile_rows) {
+    const NDSize extent = data.dataExtent();
+    if (extent.size() == 0 || extent.nelms() == 0) {
+        return;
+    }
+    const ndsize_t rows = tileRows(data, tile_rows);
+
+    auto tile = [&](ndsize_t first, NDSize &count, NDSize &offset) {
+        count = extent;
+        count[0] = std::min(rows, extent[0] - first);
+        offset = NDSize(extent.size(), 0);
+        offset[0] = first;
+    };
+    auto read = [&](ndsize_t first, std::vector<double> *buffer) {
+        NDSize count, offset;
+        tile(first, count, offset);
+        buffer->resize(check::fits_in_size_t(count.nelms(), "forEachTile: tile exceeds memory"));
+        data.getData(DataType::Double, buffer->data(), count, offset);
+    };
+
+    // double buffering: the next tile is read while the kernel runs
+    std::vector<double> buffers[2];
+    read(0, &buffers[0]);
+    size_t current = 0;
+    for (ndsize_t first = 0; first < extent[0]; first += rows, current ^= 1) {
+        std::future<void> next;
+        if (first + rows < extent[0]) {
+            next = std::async(std::launch::async, read, first + rows, &buffers[current ^ 1]);
+        }
+
+        NDSize count, offset;
+        tile(first, count, offset);
+        try {
+            kernel(buffers[current].data(), count, offset);
+        } catch (...) {
+            if (next.valid()) {
+                next.wait();
+            }
+            throw;
+        }
+
+        if (next.valid()) {
+            next.get();
+        }
+    }
+}
+
+
+Statistics statistics(const DataSet &data, ndsize_t tile_rows) {
+    Accumulator accumulator;
+    forEachTile(data, [&](const double *values, const NDSize &count, const NDSize &offset) {
+        const ndsize_t row = count.nelms() / count[0];
+        accumulator.add(values, static_cast<size_t>(count.nelms()), offset[0] * row);
+    }, tile_rows);
+    return accumulator.result();
+}
+
+
+std::vector<Statistics> channelStatistics(const DataSet &data, size_t axis, ndsize_t tile_rows) {
+    size_t channels;
+    ndsize_t inner;
+    axisShape(data, axis, channels, inner);
+
+    std::vector<Accumulator> accumulators(channels);
+    forEachTile(data, [&](const double *values, const NDSize &count, const NDSize &offset) {
+        forEachRun(values, count, offset, channels, inner,
+                   [&](size_t channel, const double *run, size_t n, ndsize_t position) {
+            accumulators[channel].add(run, n, position);
+        });
+    }, tile_rows);
+
+    std::vector<Statistics> result;
+    result.reserve(channels);
+    for (const Accumulator &accumulator : accumulators) {
+        result.push_back(accumulator.result());
+    }
+    return result;
+}
+
+
+Histogram histogram(const DataSet &data, double lower, double upper, size_t bins, ndsize_t tile_rows) {
+    checkHistogram(lower, upper, bins);
+    HistogramAccumulator accumulator(lower, upper, bins);
+    forEachTile(data, [&](const double *values, const NDSize &count, const NDSize &) {
+        accumulator.add(values, static_cast<size_t>(count.nelms()));
+    }, tile_rows);
+    return accumulator.histogram;
+}
+
+
+std::vector<Histogram> channelHistograms(const DataSet &data, size_t axis, double lower,
+                                         double upper, size_t bins, ndsize_t tile_rows) {
+    checkHistogram(lower, upper, bins);
+    size_t channels;
+    ndsize_t inner;
+    axisShape(data, axis, channels, inner);
+
+    std::vector<HistogramAccumulator> accumulators(channels, HistogramAccumulator(lower, upper, bins));
+    forEachTile(data, [&](const double *values, const NDSize &count, const NDSize &offset) {
+        forEachRun(values, count, offset, channels, inner,
+                   [&](size_t channel, const double *run, size_t n, ndsize_t) {
+            accumulators[channel].add(run, n);
+        });
+    }, tile_rows);
+
+    std::vector<Histogram> result;
+    result.reserve(channels);
+    for (const HistogramAccumulator &accumulator : accumulators) {
+        result.push_back(accumulator.histogram);
+    }
+    return result;
+}
+
+} // namespace util
+} // namespace nix
@@ -0,0 +1,205 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/trace.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define NIX_GETPID _getpid
+#else
+#include <unistd.h>
+#define NIX_GETPID getpid
+#endif
+
+namespace nix {
+namespace util {
+
+namespace detail {
+
+std::atomic<bool> tracing(false);
+
+} // namespace detail
+
+namespace {
+
+typedef std::chrono::steady_clock trace_clock;
+
+struct Span {
+    const char *name;
+    const char *category;
+    trace_clock::time_point start;
+    trace_clock::time_point end;
+};
+
+const size_t ring_size = 1 << 16;
+
+/*
+ * The spans of one thread. Only the owning thread writes; head is
+ * published with release order so that a reader sees complete spans
+ * up to head, except for those the owner overwrites meanwhile.
+ */
+struct Ring {
+    explicit Ring(size_t tid) : tid(tid), spans(ring_size), head(0) {}
+
+    size_t tid;
+    std::vector<Span> spans;
+    std::atomic<uint64_t> head;
+};
+
+// rings are never freed, so spans of finished threads are kept and
+// spans recorded during static destruction stay valid
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::string path;
+    trace_clock::time_point epoch = trace_clock::now();
+};
+
+Registry &registry() {
+    static Registry *reg = new Registry;
+    return *reg;
+}
+
+Ring *threadRing() {
+    thread_local Ring *ring = nullptr;
+    if (ring == nullptr) {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.rings.emplace_back(new Ring(reg.rings.size() + 1));
+        ring = reg.rings.back().get();
+    }
+    return ring;
+}
+
+void writeString(std::ostream &out, const char *str) {
+    out << '"';
+    for (const char *c = str; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+double micros(trace_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / 1000.0;
+}
+
+// NIX_TRACE=<file> enables tracing when the library is loaded
+struct EnvironmentSetup {
+    EnvironmentSetup() {
+        const char *path = std::getenv("NIX_TRACE");
+        if (path != nullptr && *path != '\0') {
+            enableTracing(path);
+        }
+    }
+} environment_setup;
+
+} // anonymous namespace
+
+
+void detail::recordSpan(const char *name, const char *category,
+                        trace_clock::time_point start, trace_clock::time_point end) {
+    Ring *ring = threadRing();
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    ring->spans[head % ring_size] = Span{name, category, start, end};
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+
+void enableTracing(const std::string &path) {
+    Registry &reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.path = path;
+    }
+    detail::tracing = true;
+}
+
+
+void disableTracing() {
+    detail::tracing = false;
+}
+
+
+void writeTrace(std::ostream &out) {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const int pid = static_cast<int>(NIX_GETPID());
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    out << std::fixed << std::setprecision(3);
+    for (const auto &ring : reg.rings) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << ring->tid
+            << ",\"args\":{\"name\":\"thread " << ring->tid << "\"}}";
+
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = head > ring_size ? head - ring_size : 0;
+        for (uint64_t i = begin; i < head; i++) {
+            const Span &span = ring->spans[i % ring_size];
+            out << ",\n{\"name\":";
+            writeString(out, span.name);
+            out << ",\"cat\":";
+            writeString(out, span.category);
+            out << ",\"ph\":\"X\",\"ts\":" << micros(span.start - reg.epoch)
+                << ",\"dur\":" << micros(span.end - span.start)
+                << ",\"pid\":" << pid << ",\"tid\":" << ring->tid << "}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+
+void writeTrace(const std::string &path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot open trace file: " + path);
+    }
+    writeTrace(out);
+}
+
+
+void flushTrace() {
+    std::string path;
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        path = reg.path;
+    }
+    // called from File::close, which must not fail because of the trace
+    if (tracingEnabled() && !path.empty()) {
+        std::ofstream out(path);
+        if (out) {
+            writeTrace(out);
+        }
+    }
+}
+
+
+void clearTrace() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto &ring : reg.rings) {
+        ring->head = 0;
+    }
+}
+
+} // namespace util
+} // namespace nix
@@ -11,17 +11,18 @@
 #include <nix/base/IDimensions.hpp>
 
 #include <string>
+#include <algorithm>
 #include <cstdlib>
 #include <mutex>
 #include <random>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <functional>
 #include <math.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/regex.hpp>
-#include <boost/random.hpp>
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/uuid_io.hpp>
 
 
 using namespace std;
@@ -41,23 +42,153 @@ const map<string, double> PREFIX_FACTORS = {{"y", 1.0e-24}, {"z", 1.0e-21}, {"a"
     {"k", 1.0e3}, {"M",1.0e6}, {"G", 1.0e9}, {"T", 1.0e12}, {"P", 1.0e15}, {"E",1.0e18}, {"Z", 1.0e21}, {"Y", 1.0e24}};
 
 
+// Every thread owns its generator, so no locking is needed. The seed is
+// drawn from std::random_device (getrandom/urandom) mixed with the thread
+// id and the clock, so that neither threads nor processes started at the
+// same time share a sequence.
+static std::mt19937_64 &idGenerator() {
+    thread_local std::mt19937_64 gen([] {
+        std::random_device rd;
+        uint64_t tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+        uint64_t now = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        std::seed_seq seq{rd(), rd(), rd(), rd(), rd(), rd(), rd(), rd(),
+                          static_cast<uint32_t>(tid), static_cast<uint32_t>(tid >> 32),
+                          static_cast<uint32_t>(now), static_cast<uint32_t>(now >> 32)};
+        return std::mt19937_64(seq);
+    }());
+    return gen;
+}
+
+
 string createId() {
-    typedef boost::mt19937::result_type seed_type;
-    static boost::mt19937 ran(static_cast<seed_type>(std::time(0)));
-    static boost::uuids::basic_random_generator<boost::mt19937> gen(&ran);
-    boost::uuids::uuid u = gen();
-    return boost::uuids::to_string(u);
+    static const char hex[] = "0123456789abcdef";
+    std::mt19937_64 &gen = idGenerator();
+
+    // random (version 4) uuid: 8-4-4-4-12 hex digits
+    uint64_t hi = gen();
+    uint64_t lo = gen();
+    hi = (hi & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+    lo = (lo & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+
+    char buf[36];
+    int pos = 0;
+    for (int i = 0; i < 32; i++) {
+        if (i == 8 || i == 12 || i == 16 || i == 20) {
+            buf[pos++] = '-';
+        }
+        uint64_t word = i < 16 ? hi : lo;
+        int shift = 60 - 4 * (i % 16);
+        buf[pos++] = hex[(word >> shift) & 0xF];
+    }
+
+    return string(buf, sizeof(buf));
+}
+
+
+// Days since 1970-01-01 for a proleptic Gregorian date and vice versa;
+// see H. Hinnant, "chrono-Compatible Low-Level Date Algorithms".
+static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+
+static void civilFromDays(int64_t z, int64_t &y, unsigned &m, unsigned &d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+
+static bool parseDigits(const char *str, size_t n, unsigned &value) {
+    value = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (str[i] < '0' || str[i] > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<unsigned>(str[i] - '0');
+    }
+    return true;
 }
 
 
 string timeToStr(time_t time) {
-    using namespace boost::posix_time;
-    ptime timetmp = from_time_t(time);
-    return to_iso_string(timetmp);
+    // ISO 8601 basic format as written by boost::posix_time::to_iso_string,
+    // e.g. "20150101T120000"
+    int64_t t = static_cast<int64_t>(time);
+    int64_t days = (t >= 0 ? t : t - 86399) / 86400;
+    int64_t secs = t - days * 86400;
+
+    int64_t y;
+    unsigned m, d;
+    civilFromDays(days, y, m, d);
+
+    if (y < 0 || y > 9999) {
+        using namespace boost::posix_time;
+        return to_iso_string(from_time_t(time));
+    }
+
+    char buf[16];
+    unsigned year = static_cast<unsigned>(y);
+    unsigned hms[3] = {static_cast<unsigned>(secs / 3600),
+                       static_cast<unsigned>((secs % 3600) / 60),
+                       static_cast<unsigned>(secs % 60)};
+    buf[0] = static_cast<char>('0' + year / 1000);
+    buf[1] = static_cast<char>('0' + (year / 100) % 10);
+    buf[2] = static_cast<char>('0' + (year / 10) % 10);
+    buf[3] = static_cast<char>('0' + year % 10);
+    buf[4] = static_cast<char>('0' + m / 10);
+    buf[5] = static_cast<char>('0' + m % 10);
+    buf[6] = static_cast<char>('0' + d / 10);
+    buf[7] = static_cast<char>('0' + d % 10);
+    buf[8] = 'T';
+    for (size_t i = 0; i < 3; i++) {
+        buf[9 + 2 * i] = static_cast<char>('0' + hms[i] / 10);
+        buf[10 + 2 * i] = static_cast<char>('0' + hms[i] % 10);
+    }
+    return string(buf, 15);
 }
 
 
 time_t strToTime(const string &time) {
+    // fast path for the ISO 8601 basic format "YYYYMMDDTHHMMSS[.fff]" that
+    // timeToStr produces; everything else is handed over to boost
+    const char *str = time.c_str();
+    unsigned year, month, day, hour, min, sec;
+
+    // the fractional seconds, if any, must be digits only
+    bool fraction = time.size() == 15;
+    if (time.size() > 16 && (str[15] == '.' || str[15] == ',')) {
+        fraction = std::all_of(time.begin() + 16, time.end(), [](char c) { return c >= '0' && c <= '9'; });
+    }
+
+    bool basic = time.size() >= 15 && str[8] == 'T' && fraction &&
+                 parseDigits(str, 4, year) && parseDigits(str + 4, 2, month) &&
+                 parseDigits(str + 6, 2, day) && parseDigits(str + 9, 2, hour) &&
+                 parseDigits(str + 11, 2, min) && parseDigits(str + 13, 2, sec);
+
+    if (basic && month >= 1 && month <= 12 && day >= 1 && day <= 31 &&
+        hour < 24 && min < 60 && sec < 60) {
+        int64_t days = daysFromCivil(year, month, day);
+        int64_t y;
+        unsigned m, d;
+        civilFromDays(days, y, m, d);
+        // reject dates like Feb 30th, boost will raise the proper error
+        if (m == month && d == day) {
+            return static_cast<time_t>(days * 86400 + hour * 3600 + min * 60 + sec);
+        }
+    }
+
     using namespace boost::posix_time;
     ptime timetmp(from_iso_string(time));
     ptime epoch(boost::gregorian::date(1970, 1, 1));
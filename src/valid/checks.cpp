@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/valid/checks.hpp>
+#include <nix/valid/snapshot.hpp>
 
 #include <functional>
 #include <vector>
@@ -38,6 +39,17 @@ bool tagRefsHaveUnits::operator()(const std::vector<DataArray> &references) cons
 }
 
 
+bool tagRefsHaveUnits::operator()(const std::vector<DataArraySnapshot> &references) const {
+    for (auto &ref : references) {
+        if (!util::isScalable(units, ref.dimensionsUnits())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 bool tagUnitsMatchRefsUnits::operator()(const std::vector<DataArray> &references) const {
     bool match = true;
     std::vector<std::string> dims_units;
@@ -54,6 +66,17 @@ bool tagUnitsMatchRefsUnits::operator()(const std::vector<DataArray> &references
 }
 
 
+bool tagUnitsMatchRefsUnits::operator()(const std::vector<DataArraySnapshot> &references) const {
+    for (auto &ref : references) {
+        if (!util::isScalable(units, ref.dimensionsUnits())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 bool extentsMatchPositions::operator()(const DataArray &positions) const {
     // check that positions.dataExtent()[0] == extents.dataExtent()[0]
     // and that   positions.dataExtent()[1] == extents.dataExtent()[1]
@@ -151,5 +174,72 @@ bool dimLabelsMatchData::operator()(const std::vector<Dimension> &dims) const {
     return !mismatch;
 }
 
+
+extentsMatchRefSnapshots::extentsMatchRefSnapshots(const std::vector<DataArraySnapshot> &refs) {
+    for (auto &ref : refs) {
+        ref_extents.push_back(ref.dataExtent());
+    }
+}
+
+
+bool extentsMatchRefSnapshots::operator()(const boost::optional<NDSize> &extents) const {
+    // same rules as extentsMatchRefs::operator()(const DataArray &)
+    NDSize extExtent = extents ? *extents : NDSize();
+    for (auto &arrayExtent : ref_extents) {
+        if ((arrayExtent.size() > 1 && extExtent.size() == 1) ||
+            (extExtent.size() == 2 && extExtent[1] != arrayExtent.size())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool extentsMatchRefSnapshots::operator()(const std::vector<double> &extents) const {
+    for (auto &arrayExtent : ref_extents) {
+        if (extents.size() != arrayExtent.size()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool dimTicksMatchExtent::operator()(const std::vector<DimensionSnapshot> &dims) const {
+    for (auto &dim : dims) {
+        if (dim.dimensionType() == DimensionType::Range) {
+            ndsize_t dimIndex = dim.index() - 1;
+            if (dimIndex >= extent.size()) {
+                break;
+            }
+            size_t idx = check::fits_in_size_t(dimIndex, "Cannot check ticks: dimension bigger than size_t.");
+            if (dim.ticks().size() != extent[idx]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+bool dimLabelsMatchExtent::operator()(const std::vector<DimensionSnapshot> &dims) const {
+    for (auto &dim : dims) {
+        if (dim.dimensionType() == DimensionType::Set) {
+            ndsize_t dimIndex = dim.index() - 1;
+            if (dimIndex >= extent.size()) {
+                break;
+            }
+            size_t idx = check::fits_in_size_t(dimIndex, "Cannot check labels: dimension bigger than size_t.");
+            std::vector<std::string> labels = dim.labels();
+            if (labels.size() > 0 && labels.size() != extent[idx]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 } // namespace valid
 } // namespace nix
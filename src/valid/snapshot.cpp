@@ -0,0 +1,514 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/valid/snapshot.hpp>
+
+#include <nix.hpp>
+
+#include <stdexcept>
+
+namespace nix {
+namespace valid {
+
+/**
+ * A value read from an entity, or the information that reading it failed.
+ */
+template<typename T>
+class Snapped {
+public:
+
+    Snapped() : value(), ok(false) {}
+
+    template<typename F>
+    void take(F getter) {
+        try {
+            value = getter();
+            ok = true;
+        } catch (std::exception &e) {
+            ok = false;
+        }
+    }
+
+    T get() const {
+        if (!ok) {
+            throw std::runtime_error("value could not be read when the snapshot was taken");
+        }
+        return value;
+    }
+
+private:
+    T value;
+    bool ok;
+};
+
+// ---------------------------------------------------------------------
+// Data of the snapshots
+// ---------------------------------------------------------------------
+
+struct DimensionSnapshot::Data {
+    Snapped<ndsize_t> index;
+    Snapped<DimensionType> dimension_type;
+    Snapped<std::vector<double>> ticks;
+    Snapped<std::vector<std::string>> labels;
+    Snapped<boost::optional<std::string>> unit;
+    Snapped<double> sampling_interval;
+    Snapped<boost::optional<double>> offset;
+};
+
+struct EntitySnapshot::Data {
+    Snapped<std::string> id;
+    Snapped<time_t> created_at;
+    Snapped<std::string> name;
+    Snapped<std::string> type;
+
+    virtual ~Data() {}
+};
+
+struct DataArraySnapshot::Data : public EntitySnapshot::Data {
+    Snapped<DataType> data_type;
+    Snapped<NDSize> extent;
+    Snapped<ndsize_t> dimension_count;
+    Snapped<std::vector<DimensionSnapshot>> dimensions;
+    Snapped<boost::optional<std::string>> unit;
+    Snapped<std::vector<double>> polynom_coefficients;
+    Snapped<boost::optional<double>> expansion_origin;
+};
+
+struct TagSnapshot::Data : public EntitySnapshot::Data {
+    Snapped<std::vector<double>> position;
+    Snapped<std::vector<double>> extent;
+    Snapped<std::vector<std::string>> units;
+    Snapped<std::vector<DataArraySnapshot>> references;
+};
+
+struct MultiTagSnapshot::Data : public EntitySnapshot::Data {
+    Snapped<boost::optional<NDSize>> positions_extent;
+    Snapped<boost::optional<NDSize>> extents_extent;
+    Snapped<std::vector<std::string>> units;
+    Snapped<std::vector<DataArraySnapshot>> references;
+};
+
+struct FeatureSnapshot::Data : public EntitySnapshot::Data {
+    Snapped<bool> has_data;
+    Snapped<LinkType> link_type;
+};
+
+struct PropertySnapshot::Data : public EntitySnapshot::Data {
+    Snapped<ndsize_t> value_count;
+    Snapped<boost::optional<std::string>> unit;
+};
+
+// ---------------------------------------------------------------------
+// Helpers to fill in the data
+// ---------------------------------------------------------------------
+
+template<typename T>
+static void takeEntity(EntitySnapshot::Data &data, const T &entity) {
+    data.id.take([&entity] { return entity.id(); });
+    data.created_at.take([&entity] { return entity.createdAt(); });
+}
+
+template<typename T>
+static void takeNamedEntity(EntitySnapshot::Data &data, const T &entity) {
+    takeEntity(data, entity);
+    data.name.take([&entity] { return entity.name(); });
+    data.type.take([&entity] { return entity.type(); });
+}
+
+static std::vector<DataArraySnapshot> takeReferences(const std::vector<DataArray> &refs,
+                                                     const DataArraySnapshots &known) {
+    std::vector<DataArraySnapshot> snapshots;
+    snapshots.reserve(refs.size());
+
+    for (const auto &ref : refs) {
+        auto it = known.find(ref.id());
+        if (it != known.end()) {
+            snapshots.push_back(it->second);
+        } else {
+            snapshots.emplace_back(ref);
+        }
+    }
+
+    return snapshots;
+}
+
+static boost::optional<NDSize> extentOf(const DataArray &array) {
+    boost::optional<NDSize> extent;
+    if (array) {
+        extent = array.dataExtent();
+    }
+    return extent;
+}
+
+// ---------------------------------------------------------------------
+// DimensionSnapshot
+// ---------------------------------------------------------------------
+
+DimensionSnapshot::DimensionSnapshot(const Dimension &dim) {
+    auto data = std::make_shared<Data>();
+    data->index.take([&dim] { return dim.index(); });
+    data->dimension_type.take([&dim] { return dim.dimensionType(); });
+    d = data;
+}
+
+
+DimensionSnapshot::DimensionSnapshot(const RangeDimension &dim) {
+    auto data = std::make_shared<Data>();
+    data->index.take([&dim] { return dim.index(); });
+    data->dimension_type.take([&dim] { return dim.dimensionType(); });
+    data->ticks.take([&dim] { return dim.ticks(); });
+    data->unit.take([&dim] { return dim.unit(); });
+    d = data;
+}
+
+
+DimensionSnapshot::DimensionSnapshot(const SampledDimension &dim) {
+    auto data = std::make_shared<Data>();
+    data->index.take([&dim] { return dim.index(); });
+    data->dimension_type.take([&dim] { return dim.dimensionType(); });
+    data->unit.take([&dim] { return dim.unit(); });
+    data->sampling_interval.take([&dim] { return dim.samplingInterval(); });
+    data->offset.take([&dim] { return dim.offset(); });
+    d = data;
+}
+
+
+DimensionSnapshot::DimensionSnapshot(const SetDimension &dim) {
+    auto data = std::make_shared<Data>();
+    data->index.take([&dim] { return dim.index(); });
+    data->dimension_type.take([&dim] { return dim.dimensionType(); });
+    data->labels.take([&dim] { return dim.labels(); });
+    d = data;
+}
+
+
+ndsize_t DimensionSnapshot::index() const {
+    return d->index.get();
+}
+
+
+DimensionType DimensionSnapshot::dimensionType() const {
+    return d->dimension_type.get();
+}
+
+
+std::vector<double> DimensionSnapshot::ticks() const {
+    return d->ticks.get();
+}
+
+
+std::vector<std::string> DimensionSnapshot::labels() const {
+    return d->labels.get();
+}
+
+
+boost::optional<std::string> DimensionSnapshot::unit() const {
+    return d->unit.get();
+}
+
+
+double DimensionSnapshot::samplingInterval() const {
+    return d->sampling_interval.get();
+}
+
+
+boost::optional<double> DimensionSnapshot::offset() const {
+    return d->offset.get();
+}
+
+// ---------------------------------------------------------------------
+// EntitySnapshot
+// ---------------------------------------------------------------------
+
+template<typename T>
+static std::shared_ptr<const EntitySnapshot::Data> namedEntityData(const T &entity) {
+    auto data = std::make_shared<EntitySnapshot::Data>();
+    takeNamedEntity(*data, entity);
+    return data;
+}
+
+
+EntitySnapshot::EntitySnapshot(const Block &block)
+    : d(namedEntityData(block)) {
+}
+
+
+EntitySnapshot::EntitySnapshot(const Section &section)
+    : d(namedEntityData(section)) {
+}
+
+
+EntitySnapshot::EntitySnapshot(const Source &source)
+    : d(namedEntityData(source)) {
+}
+
+
+std::string EntitySnapshot::id() const {
+    return d->id.get();
+}
+
+
+time_t EntitySnapshot::createdAt() const {
+    return d->created_at.get();
+}
+
+
+std::string EntitySnapshot::name() const {
+    return d->name.get();
+}
+
+
+std::string EntitySnapshot::type() const {
+    return d->type.get();
+}
+
+// ---------------------------------------------------------------------
+// DataArraySnapshot
+// ---------------------------------------------------------------------
+
+static std::vector<DimensionSnapshot> takeDimensions(const DataArray &data_array) {
+    std::vector<DimensionSnapshot> dims;
+
+    for (const auto &dim : data_array.dimensions()) {
+        switch (dim.dimensionType()) {
+            case DimensionType::Range:  dims.emplace_back(dim.asRangeDimension()); break;
+            case DimensionType::Sample: dims.emplace_back(dim.asSampledDimension()); break;
+            case DimensionType::Set:    dims.emplace_back(dim.asSetDimension()); break;
+            default:                    dims.emplace_back(dim); break;
+        }
+    }
+
+    return dims;
+}
+
+
+static std::shared_ptr<const EntitySnapshot::Data> dataArrayData(const DataArray &data_array) {
+    auto data = std::make_shared<DataArraySnapshot::Data>();
+    takeNamedEntity(*data, data_array);
+    data->data_type.take([&data_array] { return data_array.dataType(); });
+    data->extent.take([&data_array] { return data_array.dataExtent(); });
+    data->dimension_count.take([&data_array] { return data_array.dimensionCount(); });
+    data->dimensions.take([&data_array] { return takeDimensions(data_array); });
+    data->unit.take([&data_array] { return data_array.unit(); });
+    data->polynom_coefficients.take([&data_array] { return data_array.polynomCoefficients(); });
+    data->expansion_origin.take([&data_array] { return data_array.expansionOrigin(); });
+    return data;
+}
+
+
+DataArraySnapshot::DataArraySnapshot(const DataArray &data_array)
+    : EntitySnapshot(dataArrayData(data_array)) {
+}
+
+
+const DataArraySnapshot::Data &DataArraySnapshot::data() const {
+    return static_cast<const Data &>(*d);
+}
+
+
+DataType DataArraySnapshot::dataType() const {
+    return data().data_type.get();
+}
+
+
+NDSize DataArraySnapshot::dataExtent() const {
+    return data().extent.get();
+}
+
+
+ndsize_t DataArraySnapshot::dimensionCount() const {
+    return data().dimension_count.get();
+}
+
+
+std::vector<DimensionSnapshot> DataArraySnapshot::dimensions() const {
+    return data().dimensions.get();
+}
+
+
+boost::optional<std::string> DataArraySnapshot::unit() const {
+    return data().unit.get();
+}
+
+
+std::vector<double> DataArraySnapshot::polynomCoefficients() const {
+    return data().polynom_coefficients.get();
+}
+
+
+boost::optional<double> DataArraySnapshot::expansionOrigin() const {
+    return data().expansion_origin.get();
+}
+
+
+std::vector<std::string> DataArraySnapshot::dimensionsUnits() const {
+    std::vector<std::string> units;
+
+    for (const auto &dim : dimensions()) {
+        DimensionType type = dim.dimensionType();
+        if (type == DimensionType::Range || type == DimensionType::Sample) {
+            boost::optional<std::string> unit = dim.unit();
+            units.push_back(unit ? *unit : std::string());
+        } else if (type == DimensionType::Set) {
+            units.push_back(std::string());
+        }
+    }
+
+    return units;
+}
+
+// ---------------------------------------------------------------------
+// TagSnapshot & MultiTagSnapshot
+// ---------------------------------------------------------------------
+
+static std::shared_ptr<const EntitySnapshot::Data> tagData(const Tag &tag, const DataArraySnapshots &known) {
+    auto data = std::make_shared<TagSnapshot::Data>();
+    takeNamedEntity(*data, tag);
+    data->position.take([&tag] { return tag.position(); });
+    data->extent.take([&tag] { return tag.extent(); });
+    data->units.take([&tag] { return tag.units(); });
+    data->references.take([&tag, &known] { return takeReferences(tag.references(), known); });
+    return data;
+}
+
+
+TagSnapshot::TagSnapshot(const Tag &tag, const DataArraySnapshots &known)
+    : EntitySnapshot(tagData(tag, known)) {
+}
+
+
+const TagSnapshot::Data &TagSnapshot::data() const {
+    return static_cast<const Data &>(*d);
+}
+
+
+std::vector<double> TagSnapshot::position() const {
+    return data().position.get();
+}
+
+
+std::vector<double> TagSnapshot::extent() const {
+    return data().extent.get();
+}
+
+
+std::vector<std::string> TagSnapshot::units() const {
+    return data().units.get();
+}
+
+
+std::vector<DataArraySnapshot> TagSnapshot::references() const {
+    return data().references.get();
+}
+
+
+static std::shared_ptr<const EntitySnapshot::Data> multiTagData(const MultiTag &multi_tag,
+                                                                const DataArraySnapshots &known) {
+    auto data = std::make_shared<MultiTagSnapshot::Data>();
+    takeNamedEntity(*data, multi_tag);
+    data->positions_extent.take([&multi_tag] { return extentOf(multi_tag.positions()); });
+    data->extents_extent.take([&multi_tag] { return extentOf(multi_tag.extents()); });
+    data->units.take([&multi_tag] { return multi_tag.units(); });
+    data->references.take([&multi_tag, &known] { return takeReferences(multi_tag.references(), known); });
+    return data;
+}
+
+
+MultiTagSnapshot::MultiTagSnapshot(const MultiTag &multi_tag, const DataArraySnapshots &known)
+    : EntitySnapshot(multiTagData(multi_tag, known)) {
+}
+
+
+const MultiTagSnapshot::Data &MultiTagSnapshot::data() const {
+    return static_cast<const Data &>(*d);
+}
+
+
+boost::optional<NDSize> MultiTagSnapshot::positionsExtent() const {
+    return data().positions_extent.get();
+}
+
+
+boost::optional<NDSize> MultiTagSnapshot::extentsExtent() const {
+    return data().extents_extent.get();
+}
+
+
+std::vector<std::string> MultiTagSnapshot::units() const {
+    return data().units.get();
+}
+
+
+std::vector<DataArraySnapshot> MultiTagSnapshot::references() const {
+    return data().references.get();
+}
+
+// ---------------------------------------------------------------------
+// FeatureSnapshot & PropertySnapshot
+// ---------------------------------------------------------------------
+
+static std::shared_ptr<const EntitySnapshot::Data> featureData(const Feature &feature) {
+    auto data = std::make_shared<FeatureSnapshot::Data>();
+    takeEntity(*data, feature);
+    data->has_data.take([&feature] { return static_cast<bool>(feature.data()); });
+    data->link_type.take([&feature] { return feature.linkType(); });
+    return data;
+}
+
+
+FeatureSnapshot::FeatureSnapshot(const Feature &feature)
+    : EntitySnapshot(featureData(feature)) {
+}
+
+
+const FeatureSnapshot::Data &FeatureSnapshot::data() const {
+    return static_cast<const Data &>(*d);
+}
+
+
+bool FeatureSnapshot::hasData() const {
+    return data().has_data.get();
+}
+
+
+LinkType FeatureSnapshot::linkType() const {
+    return data().link_type.get();
+}
+
+
+static std::shared_ptr<const EntitySnapshot::Data> propertyData(const Property &property) {
+    auto data = std::make_shared<PropertySnapshot::Data>();
+    takeEntity(*data, property);
+    data->name.take([&property] { return property.name(); });
+    data->value_count.take([&property] { return property.valueCount(); });
+    data->unit.take([&property] { return property.unit(); });
+    return data;
+}
+
+
+PropertySnapshot::PropertySnapshot(const Property &property)
+    : EntitySnapshot(propertyData(property)) {
+}
+
+
+const PropertySnapshot::Data &PropertySnapshot::data() const {
+    return static_cast<const Data &>(*d);
+}
+
+
+ndsize_t PropertySnapshot::valueCount() const {
+    return data().value_count.get();
+}
+
+
+boost::optional<std::string> PropertySnapshot::unit() const {
+    return data().unit.get();
+}
+
+} // namespace valid
+} // namespace nix
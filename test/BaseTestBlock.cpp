@@ -9,6 +9,7 @@
 #include "BaseTestBlock.hpp"
 
 #include <iterator>
+#include <numeric>
 #include <boost/math/constants/constants.hpp>
 
 #include <nix/hydra/multiArray.hpp>
@@ -170,6 +171,45 @@ void BaseTestBlock::testDataArrayAccess() {
 }
 
 
+void BaseTestBlock::testBulkCreation() {
+    std::vector<DataArraySpec> da_specs = {{"bulk_a", "channel", DataType::Double, {10}},
+                                           {"bulk_b", "channel", DataType::Int32, {2, 3}},
+                                           {"bulk_c", "event", DataType::String, {0}}};
+
+    std::vector<DataArray> arrays = block.createDataArrays(da_specs);
+    CPPUNIT_ASSERT_EQUAL(da_specs.size(), arrays.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(da_specs.size()), block.dataArrayCount());
+    for (size_t i = 0; i < da_specs.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(da_specs[i].name, arrays[i].name());
+        CPPUNIT_ASSERT_EQUAL(da_specs[i].type, arrays[i].type());
+        CPPUNIT_ASSERT_EQUAL(da_specs[i].data_type, arrays[i].dataType());
+        CPPUNIT_ASSERT_EQUAL(da_specs[i].shape, arrays[i].dataExtent());
+        CPPUNIT_ASSERT(block.getDataArray(arrays[i].id()));
+    }
+
+    // duplicates with existing arrays or within the batch create nothing
+    CPPUNIT_ASSERT_THROW(block.createDataArrays({{"bulk_d", "channel", DataType::Double, {1}},
+                                                 {"bulk_a", "channel", DataType::Double, {1}}}), DuplicateName);
+    CPPUNIT_ASSERT_THROW(block.createDataArrays({{"bulk_d", "channel", DataType::Double, {1}},
+                                                 {"bulk_d", "channel", DataType::Double, {1}}}), DuplicateName);
+    CPPUNIT_ASSERT_THROW(block.createDataArrays({{"bulk_d", "", DataType::Double, {1}}}), EmptyString);
+    CPPUNIT_ASSERT(!block.hasDataArray("bulk_d"));
+    CPPUNIT_ASSERT(block.createDataArrays({}).empty());
+
+    std::vector<TagSpec> tag_specs = {{"tag_a", "event", {1.0}}, {"tag_b", "event", {2.0, 3.0}}};
+    std::vector<Tag> tags = block.createTags(tag_specs);
+    CPPUNIT_ASSERT_EQUAL(tag_specs.size(), tags.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(tag_specs.size()), block.tagCount());
+    for (size_t i = 0; i < tag_specs.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(tag_specs[i].name, tags[i].name());
+        CPPUNIT_ASSERT(tag_specs[i].position == tags[i].position());
+    }
+
+    CPPUNIT_ASSERT_THROW(block.createTags({{"tag_c", "event", {1.0}}, {"tag_a", "event", {1.0}}}), DuplicateName);
+    CPPUNIT_ASSERT(!block.hasTag("tag_c"));
+}
+
+
 void BaseTestBlock::testTagAccess() {
     std::vector<std::string> names = { "tag_a", "tag_b", "tag_c", "tag_d", "tag_e" };
     std::vector<std::string> array_names = { "data_array_a", "data_array_b", "data_array_c",
@@ -303,6 +343,142 @@ void BaseTestBlock::testGroupAccess() {
 }
 
 
+void BaseTestBlock::testCopyDataArray() {
+    Source animal = block.createSource("animal", "nix.subject");
+    Source neuron = animal.createSource("neuron", "nix.cell");
+    std::vector<int32_t> values(5000);
+    std::iota(values.begin(), values.end(), -2500);
+
+    DataArray spikes = block.createDataArray("spikes", "nix.events", DataType::Int32,
+                                             NDSize({values.size()}), Compression::DeflateNormal);
+    spikes.setData(DataType::Int32, values.data(), NDSize({values.size()}), NDSize({0}));
+    spikes.addSource(neuron);
+    spikes.metadata(section);
+
+    // the copy brings the source tree of its source along, with new ids in the same file
+    DataArray copy = block_other.copyDataArray(spikes);
+    CPPUNIT_ASSERT(copy.id() != spikes.id());
+    CPPUNIT_ASSERT(spikes.dataChunking() == copy.dataChunking());
+    std::vector<int32_t> read(values.size());
+    copy.getData(DataType::Int32, read.data(), NDSize({values.size()}), NDSize({0}));
+    CPPUNIT_ASSERT(values == read);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), block_other.sourceCount());
+    Source copied = block_other.getSource("animal").getSource("neuron");
+    CPPUNIT_ASSERT(copied.id() != neuron.id());
+    CPPUNIT_ASSERT(block_other.getSource("animal").id() != animal.id());
+    CPPUNIT_ASSERT_EQUAL(copied.id(), copy.sources()[0].id());
+    CPPUNIT_ASSERT_EQUAL(neuron.id(), spikes.sources()[0].id());
+    CPPUNIT_ASSERT_EQUAL(section.id(), copy.metadata().id());
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), file.sectionCount());
+
+    // sources the block already has are linked, not copied again
+    DataArray rates = block.createDataArray("rates", "nix.rates", DataType::Double, NDSize({10}));
+    rates.addSource(animal);
+    DataArray rates_copy = block.copyDataArray(rates, "rates_copy");
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), block.sourceCount());
+    CPPUNIT_ASSERT_EQUAL(animal.id(), rates_copy.sources()[0].id());
+
+    DataArray renewed = block.copyDataArray(spikes, "spikes_copy", CopyIds::Keep);
+    CPPUNIT_ASSERT(renewed.id() != spikes.id());
+    CPPUNIT_ASSERT_EQUAL(std::string("spikes_copy"), renewed.name());
+    CPPUNIT_ASSERT_EQUAL(neuron.id(), renewed.sources()[0].id());
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), block.sourceCount());
+
+    CPPUNIT_ASSERT_THROW(block_other.copyDataArray(spikes), DuplicateName);
+
+    // a source of another id in the way of the source tree leaves nothing behind
+    Block third = file.createBlock("block_three", "dataset");
+    third.createSource("animal", "nix.subject");
+    CPPUNIT_ASSERT_THROW(third.copyDataArray(spikes), DuplicateName);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(0), third.dataArrayCount());
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), third.sourceCount());
+}
+
+void BaseTestBlock::testVirtualDataArray() {
+    // rows of three channels, recorded in pieces: two in files of their own, one in this file
+    const ndsize_t counts[] = {4, 6, 5};
+    const std::string names[] = {"test_virtual_part0.nix", "test_virtual_part1.nix"};
+    std::vector<File> files;
+    std::vector<DataArray> parts;
+    int32_t value = 0;
+    ndsize_t first = 0;
+    for (size_t k = 0; k < 3; k++) {
+        Block target = block;
+        if (k < 2) {
+            files.push_back(File::open(names[k], FileMode::Overwrite));
+            target = files.back().createBlock("recording", "nix.session");
+        }
+        std::vector<int32_t> values(counts[k] * 3);
+        for (int32_t &v : values) {
+            v = value++;
+        }
+        DataArray part = target.createDataArray("piece" + nix::util::numToStr(k), "nix.regular_sampled",
+                                                DataType::Int32, NDSize({counts[k], ndsize_t(3)}));
+        part.setData(DataType::Int32, values.data(), NDSize({counts[k], ndsize_t(3)}), NDSize({0, 0}));
+        part.unit("mV");
+        SampledDimension time = part.appendSampledDimension(0.5);
+        time.unit("ms");
+        time.offset(10.0 + 0.5 * first);
+        part.appendSetDimension().labels({"a", "b", "c"});
+        parts.push_back(part);
+        first += counts[k];
+    }
+
+    DataArray joined = block.createVirtualDataArray("joined", "nix.regular_sampled", parts);
+    CPPUNIT_ASSERT(joined.dataExtent() == NDSize({15, 3}));
+    CPPUNIT_ASSERT_EQUAL(DataType::Int32, joined.dataType());
+    CPPUNIT_ASSERT_EQUAL(std::string("mV"), *joined.unit());
+    std::vector<int32_t> read(6);
+    joined.getData(DataType::Int32, read.data(), NDSize({2, 3}), NDSize({3, 0}));
+    for (size_t i = 0; i < read.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32_t>(9 + i), read[i]);
+    }
+    std::vector<int32_t> all(45);
+    joined.getData(DataType::Int32, all.data(), NDSize({15, 3}), NDSize({0, 0}));
+    for (size_t i = 0; i < all.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32_t>(i), all[i]);
+    }
+    SampledDimension time = joined.getDimension(1).asSampledDimension();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, time.samplingInterval(), 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, *time.offset(), 1e-12);
+    CPPUNIT_ASSERT_EQUAL(std::string("ms"), *time.unit());
+    CPPUNIT_ASSERT_EQUAL(size_t(3), joined.getDimension(2).asSetDimension().labels().size());
+
+    // along the channels, the set labels are concatenated
+    DataArray wide = block.createVirtualDataArray("wide", "nix.regular_sampled", {parts[0], parts[0]}, 1);
+    CPPUNIT_ASSERT(wide.dataExtent() == NDSize({4, 6}));
+    CPPUNIT_ASSERT_EQUAL(size_t(6), wide.getDimension(2).asSetDimension().labels().size());
+
+    // ticks of range dimensions are concatenated
+    DataArray early = block.createDataArray("early", "nix.events", DataType::Double, NDSize({3}));
+    early.appendRangeDimension({0.1, 0.4, 0.5});
+    DataArray late = files[0].getBlock("recording").createDataArray("late", "nix.events", DataType::Double,
+                                                                    NDSize({2}));
+    late.appendRangeDimension({0.9, 1.7});
+    DataArray events = block.createVirtualDataArray("events", "nix.events", {early, late});
+    CPPUNIT_ASSERT(events.dataExtent() == NDSize({5}));
+    std::vector<double> joined_ticks = events.getDimension(1).asRangeDimension().ticks();
+    CPPUNIT_ASSERT_EQUAL(size_t(5), joined_ticks.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.7, joined_ticks.back(), 1e-12);
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("unsorted", "nix.events", {late, early}), UnsortedTicks);
+
+    // gaps, overlaps, mismatched shapes and taken names are refused and leave nothing behind
+    const ndsize_t arrays = block.dataArrayCount();
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("gap", "nix.regular_sampled", {parts[0], parts[2]}),
+                         IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("overlap", "nix.regular_sampled", {parts[0], parts[0]}),
+                         IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("shape", "nix.regular_sampled", {parts[0], early}),
+                         IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("rank", "nix.regular_sampled", parts, 2), InvalidRank);
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("joined", "nix.regular_sampled", parts), DuplicateName);
+    CPPUNIT_ASSERT_EQUAL(arrays, block.dataArrayCount());
+
+    for (File &f : files) {
+        f.close();
+    }
+}
+
 void BaseTestBlock::testOperators() {
     CPPUNIT_ASSERT(block_null == false);
     CPPUNIT_ASSERT(block_null == none);
@@ -33,8 +33,11 @@ public:
     void testSourceAccess();
     void testDataArrayAccess();
     void testTagAccess();
+    void testBulkCreation();
     void testMultiTagAccess();
     void testGroupAccess();
+    void testCopyDataArray();
+    void testVirtualDataArray();
 
     void testOperators();
     void testUpdatedAt();
@@ -13,6 +13,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <type_traits>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/tools/rational.hpp>
@@ -500,3 +501,348 @@ void BaseTestDataArray::testOperator() {
     CPPUNIT_ASSERT(array1 == false);
     CPPUNIT_ASSERT(array1 == none);
 }
+
+
+void BaseTestDataArray::testReferencingEntities() {
+    Tag tag = block.createTag("tag", "test", {0.0});
+    tag.addReference(array1);
+
+    // the first query sees links made before it
+    std::vector<Tag> tags = array1.referencingTags();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), tags.size());
+    CPPUNIT_ASSERT_EQUAL(tag.id(), tags[0].id());
+    CPPUNIT_ASSERT(array2.referencingTags().empty());
+
+    Tag other = block.createTag("other tag", "test", {1.0});
+    other.addReference(array1);
+    other.addReference(array2);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), array1.referencingTags().size());
+    tag.removeReference(array1);
+    tags = array1.referencingTags();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), tags.size());
+    CPPUNIT_ASSERT_EQUAL(other.id(), tags[0].id());
+
+    Feature feature = tag.createFeature(array2, LinkType::Tagged);
+    std::vector<Feature> features = array2.referencingFeatures();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), features.size());
+    CPPUNIT_ASSERT_EQUAL(feature.id(), features[0].id());
+    feature.data(array1);
+    CPPUNIT_ASSERT(array2.referencingFeatures().empty());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), array1.referencingFeatures().size());
+
+    // positions and a reference to the same array count once
+    MultiTag mtag = block.createMultiTag("mtag", "test", array2);
+    mtag.addReference(array2);
+    std::vector<MultiTag> mtags = array2.referencingMultiTags();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), mtags.size());
+    CPPUNIT_ASSERT_EQUAL(mtag.id(), mtags[0].id());
+    mtag.positions(array3);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), array2.referencingMultiTags().size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), array3.referencingMultiTags().size());
+    mtag.removeReference(array2);
+    CPPUNIT_ASSERT(array2.referencingMultiTags().empty());
+
+    Group group = block.createGroup("group", "test");
+    group.addDataArray(array1);
+    std::vector<Group> groups = array1.referencingGroups();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), groups.size());
+    CPPUNIT_ASSERT_EQUAL(group.id(), groups[0].id());
+    group.removeDataArray(array1);
+    CPPUNIT_ASSERT(array1.referencingGroups().empty());
+    group.addDataArray(array1);
+    block.deleteGroup(group);
+    CPPUNIT_ASSERT(array1.referencingGroups().empty());
+
+    // deleting a tag removes the links of its features
+    block.deleteTag(tag);
+    CPPUNIT_ASSERT(array1.referencingFeatures().empty());
+    block.deleteMultiTag(mtag);
+    CPPUNIT_ASSERT(array3.referencingMultiTags().empty());
+
+    block.deleteDataArray(array2);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), array1.referencingTags().size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), other.referenceCount());
+}
+
+
+void BaseTestDataArray::testDataInRange() {
+    // 2 s at 1 kHz x 8 channels, value = sample * 10 + channel
+    DataArray traces = block.createDataArray("traces", "voltage", DataType::Int16, NDSize({2000, 8}));
+    std::vector<int16_t> samples(2000 * 8);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = static_cast<int16_t>((i / 8) * 10 % 30000 + i % 8);
+    }
+    traces.setData(DataType::Int16, samples.data(), NDSize({2000, 8}), NDSize({0, 0}));
+    SampledDimension time = traces.appendSampledDimension(1.0);
+    time.unit("ms");
+    traces.appendSetDimension();
+
+    NDSize offset, count;
+    traces.rangeToOffsetAndCount({1.25, 7}, {1.3, 7}, {"s"}, offset, count);
+    CPPUNIT_ASSERT_EQUAL(NDSize({1250, 7}), offset);
+    CPPUNIT_ASSERT_EQUAL(NDSize({50, 1}), count);
+
+    std::vector<int16_t> window;
+    traces.getDataInRange(window, {1250.0, 7}, {1300.0, 7}, {"ms", "none"});
+    CPPUNIT_ASSERT_EQUAL(size_t(50), window.size());
+    for (size_t i = 0; i < window.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(samples[(1250 + i) * 8 + 7], window[i]);
+    }
+
+    // two channels into the columns 1 and 2 of a 10 x 4 buffer
+    std::vector<int16_t> buffer(40, -1);
+    traces.getDataInRange(DataType::Int16, buffer.data(), NDSize({10, 4}), NDSize({0, 1}),
+                          {0.5, 2}, {0.51, 4}, {"s", "none"});
+    for (size_t r = 0; r < 10; r++) {
+        CPPUNIT_ASSERT_EQUAL(int16_t(-1), buffer[r * 4]);
+        CPPUNIT_ASSERT_EQUAL(samples[(500 + r) * 8 + 2], buffer[r * 4 + 1]);
+        CPPUNIT_ASSERT_EQUAL(samples[(500 + r) * 8 + 3], buffer[r * 4 + 2]);
+        CPPUNIT_ASSERT_EQUAL(int16_t(-1), buffer[r * 4 + 3]);
+    }
+
+    // calibration is applied in the same read, also into a region of a buffer
+    traces.polynomCoefficients({0.0, 0.5});
+    std::vector<double> scaled(40, -1.0);
+    traces.getDataInRange(DataType::Double, scaled.data(), NDSize({10, 4}), NDSize({0, 1}),
+                          {0.5, 2}, {0.51, 4}, {"s", "none"});
+    for (size_t r = 0; r < 10; r++) {
+        CPPUNIT_ASSERT_EQUAL(-1.0, scaled[r * 4]);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(samples[(500 + r) * 8 + 2] * 0.5, scaled[r * 4 + 1], 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(samples[(500 + r) * 8 + 3] * 0.5, scaled[r * 4 + 2], 1e-9);
+    }
+    std::vector<double> calibrated;
+    traces.getDataInRange(calibrated, {1.25, 7}, {1.3, 7}, {"s"});
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(window[3] * 0.5, calibrated[3], 1e-9);
+
+    CPPUNIT_ASSERT_THROW(traces.getDataInRange(window, {1.9, 0}, {2.1, 1}, {"s"}), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(traces.getDataInRange(window, {-0.1, 0}, {0.1, 1}, {"s"}), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(traces.getDataInRange(window, {0.1}, {0.2}, {"s"}), IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(traces.getDataInRange(window, {0.1, 0}, {0.2, 1}, {"V"}), IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(traces.getDataInRange(DataType::Int16, buffer.data(), NDSize({10, 4}), NDSize({1, 1}),
+                                               {0.5, 2}, {0.51, 4}, {"s"}), OutOfBounds);
+}
+
+
+void BaseTestDataArray::testEnvelope() {
+    // 1000 samples x 2 channels at 1 kHz
+    const ndsize_t n = 1000;
+    std::vector<double> samples(n * 2);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = static_cast<double>((i * 37) % 101) - static_cast<double>(i % 2) * 50;
+    }
+    auto brute = [&](ndsize_t begin, ndsize_t end, size_t v, double &lo, double &hi, double &mean) {
+        lo = hi = samples[begin * 2 + v];
+        double sum = 0;
+        for (ndsize_t i = begin; i < end; i++) {
+            lo = std::min(lo, samples[i * 2 + v]);
+            hi = std::max(hi, samples[i * 2 + v]);
+            sum += samples[i * 2 + v];
+        }
+        mean = sum / (end - begin);
+    };
+    ndsize_t total = n;
+    auto check = [&](const Envelope &envelope) {
+        for (ndsize_t b = 0; b < envelope.buckets; b++) {
+            ndsize_t begin = envelope.offset + b * envelope.bucketSize;
+            ndsize_t end = std::min(begin + envelope.bucketSize, total);
+            for (size_t v = 0; v < 2; v++) {
+                double lo, hi, mean;
+                brute(begin, end, v, lo, hi, mean);
+                CPPUNIT_ASSERT_EQUAL(lo, envelope.min[b * 2 + v]);
+                CPPUNIT_ASSERT_EQUAL(hi, envelope.max[b * 2 + v]);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(mean, envelope.mean[b * 2 + v], 1e-9);
+            }
+        }
+    };
+
+    DataArray traces = block.createDataArray("envelope", "voltage", DataType::Double, NDSize({n, ndsize_t(2)}));
+    traces.setData(DataType::Double, samples.data(), NDSize({n, ndsize_t(2)}), NDSize({0, 0}));
+    traces.appendSampledDimension(1.0).unit("ms");
+    traces.appendSetDimension();
+
+    // without an envelope the data is reduced
+    CPPUNIT_ASSERT(!traces.hasEnvelope());
+    Envelope raw = traces.readEnvelopeIndices(10, 110, 10);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(10), raw.offset);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(10), raw.bucketSize);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(10), raw.buckets);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(2), raw.values);
+    check(raw);
+
+    // levels of 250, 63, 16, 4 and 1 buckets
+    traces.buildEnvelope(4);
+    CPPUNIT_ASSERT(traces.hasEnvelope());
+    Envelope level2 = traces.readEnvelopeIndices(0, n, 60);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(16), level2.bucketSize);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(63), level2.buckets);
+    check(level2);
+    Envelope top = traces.readEnvelopeIndices(0, n, 1);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(256), top.bucketSize);
+    check(top);
+    Envelope fine = traces.readEnvelopeIndices(0, 20, 10);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(2), fine.bucketSize);
+    check(fine);
+
+    // buckets of a stored level are aligned and may start before the range
+    Envelope window = traces.readEnvelope(0.1, 0.5, 10, "s");
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(96), window.offset);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(16), window.bucketSize);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(26), window.buckets);
+    check(window);
+
+    // appending updates the envelope to what a rebuild gives
+    DataArray growing = block.createDataArray("growing", "voltage", DataType::Double, NDSize({600, 2}));
+    growing.setData(DataType::Double, samples.data(), NDSize({600, 2}), NDSize({0, 0}));
+    growing.appendSampledDimension(1.0);
+    growing.appendSetDimension();
+    growing.buildEnvelope(4);
+    growing.appendData(DataType::Double, samples.data() + 1200, NDSize({150, 2}), 0);
+    growing.appendData(DataType::Double, samples.data() + 1500, NDSize({250, 2}), 0);
+    for (size_t target : {1, 4, 16, 60, 250}) {
+        Envelope a = traces.readEnvelopeIndices(0, n, target);
+        Envelope b = growing.readEnvelopeIndices(0, n, target);
+        CPPUNIT_ASSERT_EQUAL(a.bucketSize, b.bucketSize);
+        CPPUNIT_ASSERT(a.min == b.min);
+        CPPUNIT_ASSERT(a.max == b.max);
+        check(b);
+    }
+
+    // other writes and resizes keep the envelope in sync with the data
+    std::fill(samples.begin() + 300 * 2, samples.begin() + 340 * 2, 500.0);
+    growing.setData(DataType::Double, samples.data() + 300 * 2, NDSize({40, 2}), NDSize({300, 0}));
+    check(growing.readEnvelopeIndices(0, n, 1));
+    check(growing.readEnvelopeIndices(0, n, 60));
+
+    growing.dataExtent(NDSize({900, 2}));
+    total = 900;
+    Envelope shrunk = growing.readEnvelopeIndices(0, total, 1);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(256), shrunk.bucketSize);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(4), shrunk.buckets);
+    check(shrunk);
+
+    growing.dataExtent(NDSize({1000, 2}));
+    std::fill(samples.begin() + 900 * 2, samples.end(), 0.0);
+    total = n;
+    check(growing.readEnvelopeIndices(0, n, 4));
+    check(growing.readEnvelopeIndices(0, n, 250));
+
+    // the envelope of another handle to the array goes with it
+    DataArray other = block.getDataArray("growing");
+    CPPUNIT_ASSERT(other.hasEnvelope());
+    CPPUNIT_ASSERT(growing.deleteEnvelope());
+    CPPUNIT_ASSERT(!other.hasEnvelope());
+
+    CPPUNIT_ASSERT(traces.deleteEnvelope());
+    CPPUNIT_ASSERT(!traces.hasEnvelope());
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(0), traces.readEnvelopeIndices(n, n + 10, 10).buckets);
+
+    DataArray labels = block.createDataArray("labels", "voltage", DataType::Double, NDSize({10}));
+    labels.appendSetDimension();
+    CPPUNIT_ASSERT_THROW(labels.buildEnvelope(4), IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(traces.buildEnvelope(1), std::invalid_argument);
+}
+
+
+void BaseTestDataArray::testCompressedRead() {
+    const NDSize size = {512, 256};
+    std::vector<double> values(size.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<double>(i % 97) * 0.5;
+    }
+
+    // the rows from 384 on are never written and read as the fill value
+    DataArray packed = block.createDataArray("packed", "signal", DataType::Double, size, Compression::DeflateNormal);
+    packed.setData(DataType::Double, values.data(), NDSize({384, 256}), NDSize({0, 0}));
+    NDSize chunk = packed.dataChunking();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), chunk.size());
+    CPPUNIT_ASSERT(chunk[0] < 512);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), file.filterThreads());
+    std::vector<double> serial(values.size());
+    packed.getData(DataType::Double, serial.data(), size, NDSize({0, 0}));
+
+    file.filterThreads(4);
+    CPPUNIT_ASSERT_EQUAL(size_t(4), file.filterThreads());
+    std::vector<double> parallel(values.size(), -1.0);
+    packed.getData(DataType::Double, parallel.data(), size, NDSize({0, 0}));
+    CPPUNIT_ASSERT(serial == parallel);
+    CPPUNIT_ASSERT_EQUAL(values[383 * 256 + 255], parallel[383 * 256 + 255]);
+    CPPUNIT_ASSERT_EQUAL(0.0, parallel[384 * 256]);
+    CPPUNIT_ASSERT_THROW(packed.getData(DataType::Double, parallel.data(), size, NDSize({64, 0})), OutOfBounds);
+
+    std::vector<double> window(350 * 170);
+    packed.getData(DataType::Double, window.data(), NDSize({350, 170}), NDSize({100, 30}));
+    for (size_t r = 0; r < 350; r += 7) {
+        for (size_t c = 0; c < 170; c++) {
+            CPPUNIT_ASSERT_EQUAL(serial[(100 + r) * 256 + 30 + c], window[r * 170 + c]);
+        }
+    }
+
+    // a conversion is left to the storage library
+    std::vector<float> converted(values.size());
+    packed.getData(DataType::Float, converted.data(), size, NDSize({0, 0}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<float>(values[1000]), converted[1000]);
+
+    std::vector<DataArraySpec> specs = {{"packed_spec", "signal", DataType::Int16, {1000}, Compression::DeflateNormal}};
+    DataArray bulk = block.createDataArrays(specs)[0];
+    std::vector<int16_t> ramp(1000);
+    std::iota(ramp.begin(), ramp.end(), 0);
+    bulk.setData(ramp);
+    std::vector<int16_t> ramp_read;
+    bulk.getData(ramp_read);
+    CPPUNIT_ASSERT(ramp == ramp_read);
+
+    file.filterThreads(0);
+    CPPUNIT_ASSERT(file.filterThreads() >= 1);
+    file.filterThreads(1);
+}
+
+
+void BaseTestDataArray::testCompressedWrite() {
+    DataArray packed = block.createDataArray("packed", "signal", DataType::Int32, NDSize({0, 64}),
+                                             Compression::DeflateNormal);
+    NDSize chunk = packed.dataChunking();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), chunk.size());
+
+    const size_t rows = static_cast<size_t>(chunk[0]) * 5 + 3;
+    std::vector<int32_t> values(rows * 64);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i % 101) - 50;
+    }
+
+    // odd sized pieces are collected into whole chunk rows
+    file.filterThreads(4);
+    {
+        DataAppender appender(packed, DataType::Int32);
+        CPPUNIT_ASSERT_EQUAL(chunk[0], appender.blockRows());
+        size_t done = 0;
+        for (size_t piece = 7; done < rows; piece += 11) {
+            size_t n = std::min(piece, rows - done);
+            appender.append(&values[done * 64], n);
+            done += n;
+            CPPUNIT_ASSERT_EQUAL(ndsize_t(0), packed.dataExtent()[0] % chunk[0]);
+        }
+        CPPUNIT_ASSERT_EQUAL(ndsize_t(3), appender.pending());
+    }
+    CPPUNIT_ASSERT_EQUAL(NDSize({ndsize_t(rows), ndsize_t(64)}), packed.dataExtent());
+
+    file.filterThreads(1);
+    std::vector<int32_t> serial(values.size(), 0);
+    packed.getData(DataType::Int32, serial.data(), packed.dataExtent(), NDSize({0, 0}));
+    CPPUNIT_ASSERT(values == serial);
+
+    // a write inside of the data also takes whole chunks
+    file.filterThreads(2);
+    std::vector<int32_t> ones(chunk.nelms() * 2, 1);
+    NDSize count = chunk;
+    count[0] *= 2;
+    packed.setData(DataType::Int32, ones.data(), count, chunk);
+    file.filterThreads(1);
+    std::vector<int32_t> value(1);
+    packed.getData(DataType::Int32, value.data(), NDSize({1, 1}), chunk);
+    CPPUNIT_ASSERT_EQUAL(1, value[0]);
+
+    CPPUNIT_ASSERT_THROW(DataAppender(packed, DataType::String), std::invalid_argument);
+    static_assert(!std::is_copy_constructible<DataAppender>::value && !std::is_copy_assignable<DataAppender>::value,
+                  "the rows an appender collected must be appended once");
+}
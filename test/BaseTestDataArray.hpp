@@ -38,6 +38,11 @@ public:
     void testAliasRangeDimension();
     void testOperator();
     void testValidate();
+    void testReferencingEntities();
+    void testDataInRange();
+    void testEnvelope();
+    void testCompressedRead();
+    void testCompressedWrite();
 };
 
 #endif // NIX_BASETESTDATAARRAY_HPP
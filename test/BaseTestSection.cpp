@@ -293,6 +293,27 @@ void BaseTestSection::testFindRelated() {
 }
 
 
+void BaseTestSection::testBulkPropertyCreation() {
+    std::vector<PropertySpec> specs = {{"prop_a", {Value(1.0), Value(2.0)}},
+                                       {"prop_b", {Value("foo")}},
+                                       {"prop_c", {Value(10), Value(20), Value(30)}}};
+
+    std::vector<Property> props = section.createProperties(specs);
+    CPPUNIT_ASSERT_EQUAL(specs.size(), props.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(specs.size()), section.propertyCount());
+    for (size_t i = 0; i < specs.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(specs[i].name, props[i].name());
+        CPPUNIT_ASSERT(specs[i].values == props[i].values());
+        CPPUNIT_ASSERT(section.getProperty(props[i].id()));
+    }
+
+    CPPUNIT_ASSERT_THROW(section.createProperties({{"prop_d", {Value(1)}}, {"prop_a", {Value(1)}}}), DuplicateName);
+    CPPUNIT_ASSERT_THROW(section.createProperties({{"prop_d", {Value(1)}}, {"prop_d", {Value(1)}}}), DuplicateName);
+    CPPUNIT_ASSERT_THROW(section.createProperties({{"prop_d", {}}}), std::runtime_error);
+    CPPUNIT_ASSERT(!section.hasProperty("prop_d"));
+}
+
+
 void BaseTestSection::testPropertyAccess() {
     std::vector<std::string> names = { "property_a", "property_b", "property_c", "property_d", "property_e" };
 
@@ -36,6 +36,7 @@ public:
     void testFindSection();
     void testFindRelated();
     void testPropertyAccess();
+    void testBulkPropertyCreation();
     void testReferringData();
     void testReferringTags();
     void testReferringMultiTags();
@@ -10,9 +10,18 @@
 
 #include <nix.hpp>
 #include <nix/NDArray.hpp>
+#include <modules/Dump.hpp>
 
 #include <cstdio>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <sstream>
 #include <queue>
+#include <algorithm>
 #include <random>
 #include <type_traits>
 #include <iostream>
@@ -24,6 +33,7 @@
 #include <string>
 #include <cstdint>
 #include <utility>
+#include <functional>
 
 /* ************************************ */
 namespace nix {
@@ -533,6 +543,1205 @@ public:
 
 /* ************************************ */
 
+class EntityBenchmark {
+public:
+    EntityBenchmark(size_t count) : count(count), millis(0) { }
+
+    virtual ~EntityBenchmark() { }
+
+    double speed_in_nps() const {
+        return count * (1000.0/millis);
+    }
+
+    size_t entity_count() const { return count; }
+
+    virtual void run() = 0;
+    virtual std::string id() = 0;
+    virtual std::string kind() = 0;
+
+protected:
+    size_t count;
+    double millis;
+};
+
+
+class TagCreationBenchmark : public EntityBenchmark {
+public:
+    TagCreationBenchmark(size_t count, bool deferred)
+            : EntityBenchmark(count), deferred(deferred) {
+    };
+
+    void run() override {
+        Stopwatch sw;
+
+        nix::File fd = nix::File::open("entities.h5", nix::FileMode::Overwrite);
+        fd.deferTimestamps(deferred);
+        nix::Block block = fd.createBlock("tags", "nix.test");
+
+        for (size_t i = 0; i < count; i++) {
+            nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.test", {static_cast<double>(i)});
+            tag.units({"ms"});
+            tag.extent({1.0});
+        }
+
+        fd.close();
+        millis = sw.ms();
+    }
+
+    std::string id() override {
+        return deferred ? "CD" : "C";
+    }
+
+    std::string kind() override {
+        return "Tag";
+    }
+
+private:
+    bool deferred;
+};
+
+
+class DataArrayCreationBenchmark : public EntityBenchmark {
+public:
+    DataArrayCreationBenchmark(size_t count, bool bulk)
+            : EntityBenchmark(count), bulk(bulk) {
+    };
+
+    void run() override {
+        Stopwatch sw;
+
+        nix::File fd = nix::File::open("entities.h5", nix::FileMode::Overwrite);
+        nix::Block block = fd.createBlock("arrays", "nix.test");
+
+        if (bulk) {
+            std::vector<nix::DataArraySpec> specs;
+            specs.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                specs.push_back({"array_" + std::to_string(i), "nix.test", nix::DataType::Double, {128}});
+            }
+            block.createDataArrays(specs);
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                block.createDataArray("array_" + std::to_string(i), "nix.test", nix::DataType::Double, {128});
+            }
+        }
+
+        fd.close();
+        millis = sw.ms();
+    }
+
+    std::string id() override {
+        return bulk ? "CB" : "C";
+    }
+
+    std::string kind() override {
+        return "DataArray";
+    }
+
+private:
+    bool bulk;
+};
+
+
+class ConcurrentReadBenchmark {
+public:
+    ConcurrentReadBenchmark(size_t threads, size_t arrays, size_t elements)
+            : threads(threads), arrays(arrays), elements(elements), millis(0) {
+    };
+
+    static void prepare(const std::string &path, size_t arrays, size_t elements) {
+        nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+        nix::Block block = fd.createBlock("concurrent", "nix.test");
+        std::vector<double> data(elements);
+        RndGen<double> rnd;
+        std::generate(data.begin(), data.end(), std::ref(rnd));
+
+        for (size_t i = 0; i < arrays; i++) {
+            block.createDataArray("array_" + std::to_string(i), "nix.test", data);
+        }
+
+        fd.close();
+    }
+
+    void run(const std::string &path) {
+        nix::File fd = nix::File::open(path, nix::FileMode::ReadOnly);
+        nix::Block block = fd.getBlock("concurrent");
+        std::vector<std::thread> workers;
+
+        Stopwatch sw;
+        // every thread reads its share of the arrays in full
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([this, t, &block] {
+                std::vector<double> buffer(elements);
+                for (size_t i = t; i < arrays; i += threads) {
+                    nix::DataArray da = block.getDataArray("array_" + std::to_string(i));
+                    da.getData(nix::DataType::Double, buffer.data(), {elements}, {0});
+                }
+            });
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        millis = sw.ms();
+        fd.close();
+    }
+
+    double speed_in_mbs() const {
+        return (arrays * elements * sizeof(double)) * (1000.0 / millis) / (1024 * 1024);
+    }
+
+    size_t thread_count() const { return threads; }
+
+private:
+    size_t threads;
+    size_t arrays;
+    size_t elements;
+    double millis;
+};
+
+/*
+ * Reads one deflate compressed array in full, with the chunks inflated
+ * on the given number of threads (File::filterThreads).
+ */
+// a noisy sine, which deflate shrinks to about half
+static std::vector<int16_t> noisy_sine(size_t elements) {
+    std::vector<int16_t> data(elements);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> noise(-64, 64);
+    for (size_t i = 0; i < elements; i++) {
+        data[i] = static_cast<int16_t>(8000 * std::sin(i * 0.001) + noise(gen));
+    }
+    return data;
+}
+
+class DecompressBenchmark {
+public:
+    DecompressBenchmark(size_t threads, size_t elements)
+            : threads(threads), elements(elements), millis(0) {
+    };
+
+    static void prepare(const std::string &path, size_t elements) {
+        nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+        nix::Block block = fd.createBlock("compressed", "nix.test");
+
+        std::vector<int16_t> data = noisy_sine(elements);
+        block.createDataArray("signal", "nix.test", data, nix::DataType::Int16, nix::Compression::DeflateNormal);
+        fd.close();
+    }
+
+    void run(const std::string &path) {
+        nix::File fd = nix::File::open(path, nix::FileMode::ReadOnly);
+        fd.filterThreads(threads);
+        nix::DataArray da = fd.getBlock("compressed").getDataArray("signal");
+        std::vector<int16_t> buffer(elements);
+
+        Stopwatch sw;
+        da.getData(nix::DataType::Int16, buffer.data(), {elements}, {0});
+        millis = std::max<double>(sw.ms(), 1);
+        fd.close();
+    }
+
+    double speed_in_mbs() const {
+        return (elements * sizeof(int16_t)) * (1000.0 / millis) / (1024 * 1024);
+    }
+
+    size_t thread_count() const { return threads; }
+
+private:
+    size_t threads;
+    size_t elements;
+    double millis;
+};
+
+class CompressBenchmark {
+public:
+    CompressBenchmark(size_t threads, size_t elements, size_t piece)
+            : threads(threads), elements(elements), piece(piece), millis(0) {
+    };
+
+    // appends the data in pieces, like an acquisition, and includes closing the file
+    void run(const std::string &path) {
+        std::vector<int16_t> data = noisy_sine(elements);
+
+        Stopwatch sw;
+        nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+        fd.filterThreads(threads);
+        nix::Block block = fd.createBlock("compressed", "nix.test");
+        nix::DataArray da = block.createDataArray("signal", "nix.test", nix::DataType::Int16, {0},
+                                                  nix::Compression::DeflateNormal);
+        {
+            nix::DataAppender appender(da, nix::DataType::Int16);
+            for (size_t done = 0; done < elements; done += piece) {
+                appender.append(&data[done], std::min(piece, elements - done));
+            }
+        }
+        fd.close();
+        millis = std::max<double>(sw.ms(), 1);
+    }
+
+    double speed_in_mbs() const {
+        return (elements * sizeof(int16_t)) * (1000.0 / millis) / (1024 * 1024);
+    }
+
+    size_t thread_count() const { return threads; }
+
+private:
+    size_t threads;
+    size_t elements;
+    size_t piece;
+    double millis;
+};
+
+class ValidateBenchmark {
+public:
+    ValidateBenchmark(size_t threads)
+            : threads(threads), millis(0), errors(0), warnings(0) {
+    };
+
+    static void prepare(const std::string &path, size_t blocks, size_t arrays) {
+        nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+        std::vector<double> data(64, 1.0);
+
+        for (size_t b = 0; b < blocks; b++) {
+            nix::Block block = fd.createBlock("block_" + std::to_string(b), "nix.test");
+            std::vector<nix::DataArray> refs;
+            for (size_t i = 0; i < arrays; i++) {
+                nix::DataArray da = block.createDataArray("array_" + std::to_string(i), "nix.test", data);
+                da.appendSampledDimension(0.1).unit("ms");
+                refs.push_back(da);
+            }
+            // every tag references a few arrays, every array is referenced by a few tags
+            for (size_t i = 0; i < arrays; i++) {
+                nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.test", {1.0});
+                tag.units({"ms"});
+                for (size_t k = 0; k < 4; k++) {
+                    tag.addReference(refs[(i + k) % arrays]);
+                }
+            }
+        }
+
+        fd.close();
+    }
+
+    void run(const std::string &path) {
+        nix::File fd = nix::File::open(path, nix::FileMode::ReadOnly);
+
+        Stopwatch sw;
+        nix::valid::Result result = fd.validate(threads);
+        millis = sw.ms();
+
+        errors = result.getErrors().size();
+        warnings = result.getWarnings().size();
+        fd.close();
+    }
+
+    double ms() const { return millis; }
+    size_t thread_count() const { return threads; }
+    size_t error_count() const { return errors; }
+    size_t warning_count() const { return warnings; }
+
+private:
+    size_t threads;
+    double millis;
+    size_t errors;
+    size_t warnings;
+};
+
+/* ************************************ */
+
+/*
+ * Result of one benchmark: latency percentiles over all timed samples
+ * and throughput. Results are written as text, JSON or CSV and two runs
+ * can be compared with "nix-bench compare".
+ */
+struct Result {
+    std::string name;
+    std::string backend;
+    size_t samples = 0;
+    double mean_us = 0;
+    double p50_us = 0;
+    double p90_us = 0;
+    double p99_us = 0;
+    double min_us = 0;
+    double max_us = 0;
+    double ops_per_s = 0;
+    double mb_per_s = 0;
+    double io_calls = 0;    // storage calls per sample, with --io-stats
+    double file_bytes = 0;  // size of the file of an api benchmark afterwards
+    std::string error;
+};
+
+static const std::vector<std::string> result_fields = {
+    "name", "backend", "samples", "mean_us", "p50_us", "p90_us", "p99_us",
+    "min_us", "max_us", "ops_per_s", "mb_per_s", "io_calls", "file_bytes", "error"
+};
+
+class Samples {
+public:
+    typedef std::chrono::steady_clock clock_t;
+
+    template<typename F>
+    void time(F func) {
+        clock_t::time_point start = clock_t::now();
+        func();
+        add(std::chrono::duration<double, std::micro>(clock_t::now() - start).count());
+    }
+
+    void add(double us) {
+        values.push_back(us);
+    }
+
+    void bytes(double count) {
+        byte_count += count;
+    }
+
+    Result summarize(const std::string &name, const std::string &backend) const {
+        Result r;
+        r.name = name;
+        r.backend = backend;
+        r.samples = values.size();
+        if (values.empty()) {
+            return r;
+        }
+
+        std::vector<double> sorted(values);
+        std::sort(sorted.begin(), sorted.end());
+        double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+        r.mean_us = total / sorted.size();
+        r.p50_us = percentile(sorted, 50);
+        r.p90_us = percentile(sorted, 90);
+        r.p99_us = percentile(sorted, 99);
+        r.min_us = sorted.front();
+        r.max_us = sorted.back();
+        r.ops_per_s = total > 0 ? sorted.size() * 1e6 / total : 0;
+        r.mb_per_s = total > 0 ? byte_count * 1e6 / total / (1024 * 1024) : 0;
+        return r;
+    }
+
+private:
+    // nearest rank
+    static double percentile(const std::vector<double> &sorted, double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::max<size_t>(rank, 1) - 1];
+    }
+
+    std::vector<double> values;
+    double byte_count = 0;
+};
+
+/*
+ * A benchmark of the entity API. prepare() builds the content it needs
+ * in a fresh file (not timed), run() times single operations on it.
+ * Every suite benchmark runs on all selected backends.
+ */
+class SuiteBenchmark {
+public:
+    SuiteBenchmark(const std::string &name) : my_name(name) { }
+
+    virtual ~SuiteBenchmark() { }
+
+    const std::string & name() const { return my_name; }
+
+    virtual void prepare(nix::File &fd) { }
+    virtual void run(nix::File &fd, Samples &samples) = 0;
+
+protected:
+    std::string my_name;
+};
+
+
+class CreateTagBenchmark : public SuiteBenchmark {
+public:
+    CreateTagBenchmark(size_t count)
+            : SuiteBenchmark("create.tag"), count(count) { }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Block block = fd.createBlock("create", "nix.bench");
+        for (size_t i = 0; i < count; i++) {
+            samples.time([&block, i] {
+                block.createTag("tag_" + std::to_string(i), "nix.bench", {static_cast<double>(i)});
+            });
+        }
+    }
+
+private:
+    size_t count;
+};
+
+
+class CreateDataArrayBenchmark : public SuiteBenchmark {
+public:
+    CreateDataArrayBenchmark(size_t count)
+            : SuiteBenchmark("create.data_array"), count(count) { }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Block block = fd.createBlock("create", "nix.bench");
+        std::vector<double> data(128, 1.0);
+        for (size_t i = 0; i < count; i++) {
+            samples.time([&block, &data, i] {
+                block.createDataArray("array_" + std::to_string(i), "nix.bench", data);
+            });
+            samples.bytes(data.size() * sizeof(double));
+        }
+    }
+
+private:
+    size_t count;
+};
+
+
+class LookupBenchmark : public SuiteBenchmark {
+public:
+    LookupBenchmark(size_t children, size_t lookups, bool by_id)
+            : SuiteBenchmark(by_id ? "lookup.id" : "lookup.name"),
+              children(children), lookups(lookups), by_id(by_id) { }
+
+    void prepare(nix::File &fd) override {
+        nix::Block block = fd.createBlock("lookup", "nix.bench");
+        for (size_t i = 0; i < children; i++) {
+            nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.bench", {1.0});
+            ids.push_back(tag.id());
+        }
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Block block = fd.getBlock("lookup");
+        std::mt19937 rd_gen(42);
+        std::uniform_int_distribution<size_t> dis(0, children - 1);
+        for (size_t i = 0; i < lookups; i++) {
+            size_t k = dis(rd_gen);
+            std::string key = by_id ? ids[k] : "tag_" + std::to_string(k);
+            samples.time([&block, &key] {
+                if (!block.getTag(key)) {
+                    throw std::runtime_error("lookup failed");
+                }
+            });
+        }
+    }
+
+private:
+    size_t children;
+    size_t lookups;
+    bool by_id;
+    std::vector<std::string> ids;
+};
+
+
+class EnumerateBenchmark : public SuiteBenchmark {
+public:
+    EnumerateBenchmark(size_t children, size_t repeats)
+            : SuiteBenchmark("enumerate.tags@" + std::to_string(children)),
+              children(children), repeats(repeats) { }
+
+    void prepare(nix::File &fd) override {
+        nix::Block block = fd.createBlock("enumerate", "nix.bench");
+        for (size_t i = 0; i < children; i++) {
+            block.createTag("tag_" + std::to_string(i), "nix.bench", {1.0});
+        }
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Block block = fd.getBlock("enumerate");
+        for (size_t i = 0; i < repeats; i++) {
+            samples.time([this, &block] {
+                if (block.tags().size() != children) {
+                    throw std::runtime_error("enumeration incomplete");
+                }
+            });
+        }
+    }
+
+private:
+    size_t children;
+    size_t repeats;
+};
+
+
+class RetrieveTagBenchmark : public SuiteBenchmark {
+public:
+    RetrieveTagBenchmark(size_t tags, size_t samples_per_tag)
+            : SuiteBenchmark("retrieve.tag"), tags(tags), width(samples_per_tag) { }
+
+    void prepare(nix::File &fd) override {
+        nix::Block block = fd.createBlock("retrieve", "nix.bench");
+        std::vector<double> data(tags * width);
+        RndGen<double> rnd;
+        std::generate(data.begin(), data.end(), std::ref(rnd));
+        nix::DataArray da = block.createDataArray("signal", "nix.bench", data);
+        da.appendSampledDimension(1.0).unit("ms");
+
+        for (size_t i = 0; i < tags; i++) {
+            nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.bench", {static_cast<double>(i * width)});
+            tag.extent({static_cast<double>(width - 1)});
+            tag.units({"ms"});
+            tag.addReference(da);
+        }
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Block block = fd.getBlock("retrieve");
+        std::vector<double> buffer;
+        for (size_t i = 0; i < tags; i++) {
+            nix::Tag tag = block.getTag("tag_" + std::to_string(i));
+            samples.time([&tag, &buffer] {
+                nix::DataView view = tag.retrieveData(0);
+                buffer.resize(view.dataExtent().nelms());
+                view.getData(buffer);
+            });
+            samples.bytes(buffer.size() * sizeof(double));
+        }
+    }
+
+private:
+    size_t tags;
+    size_t width;
+};
+
+
+/*
+ * Many small tags, as left by event detection, whose positions, extents
+ * and units are read back one tag after the other.
+ */
+class ReadTagBenchmark : public SuiteBenchmark {
+public:
+    ReadTagBenchmark(size_t tags)
+            : SuiteBenchmark("read.tag"), tags(tags) { }
+
+    void prepare(nix::File &fd) override {
+        nix::Block block = fd.createBlock("read", "nix.bench");
+        for (size_t i = 0; i < tags; i++) {
+            nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.bench",
+                                           {static_cast<double>(i), 0.5});
+            tag.extent({1.0, 0.25});
+            tag.units({"s", "mV"});
+        }
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Block block = fd.getBlock("read");
+        for (size_t i = 0; i < tags; i++) {
+            nix::Tag tag = block.getTag("tag_" + std::to_string(i));
+            samples.time([&tag] {
+                if (tag.position().size() != 2 || tag.extent().size() != 2 || tag.units().size() != 2) {
+                    throw std::runtime_error("tag incomplete");
+                }
+            });
+            samples.bytes(4 * sizeof(double));
+        }
+    }
+
+private:
+    size_t tags;
+};
+
+
+class RetrieveMultiTagBenchmark : public SuiteBenchmark {
+public:
+    RetrieveMultiTagBenchmark(size_t positions, size_t samples_per_position)
+            : SuiteBenchmark("retrieve.multi_tag"), positions(positions), width(samples_per_position) { }
+
+    void prepare(nix::File &fd) override {
+        nix::Block block = fd.createBlock("retrieve", "nix.bench");
+        std::vector<double> data(positions * width);
+        RndGen<double> rnd;
+        std::generate(data.begin(), data.end(), std::ref(rnd));
+        nix::DataArray da = block.createDataArray("signal", "nix.bench", data);
+        da.appendSampledDimension(1.0).unit("ms");
+
+        std::vector<double> pos(positions), ext(positions, static_cast<double>(width - 1));
+        for (size_t i = 0; i < positions; i++) {
+            pos[i] = static_cast<double>(i * width);
+        }
+        nix::DataArray pos_da = block.createDataArray("positions", "nix.bench", pos);
+        pos_da.appendSetDimension();
+        nix::DataArray ext_da = block.createDataArray("extents", "nix.bench", ext);
+        ext_da.appendSetDimension();
+
+        nix::MultiTag mtag = block.createMultiTag("events", "nix.bench", pos_da);
+        mtag.extents(ext_da);
+        mtag.units({"ms"});
+        mtag.addReference(da);
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::MultiTag mtag = fd.getBlock("retrieve").getMultiTag("events");
+        std::vector<double> buffer;
+        for (size_t i = 0; i < positions; i++) {
+            samples.time([&mtag, &buffer, i] {
+                nix::DataView view = mtag.retrieveData(i, 0);
+                buffer.resize(view.dataExtent().nelms());
+                view.getData(buffer);
+            });
+            samples.bytes(buffer.size() * sizeof(double));
+        }
+    }
+
+private:
+    size_t positions;
+    size_t width;
+};
+
+
+class PropertyWriteBenchmark : public SuiteBenchmark {
+public:
+    PropertyWriteBenchmark(size_t count, size_t values)
+            : SuiteBenchmark("property.write"), count(count), values(values) { }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Section section = fd.createSection("properties", "nix.bench");
+        std::vector<nix::Value> vals;
+        for (size_t k = 0; k < values; k++) {
+            vals.emplace_back(static_cast<double>(k));
+        }
+        for (size_t i = 0; i < count; i++) {
+            samples.time([&section, &vals, i] {
+                section.createProperty("prop_" + std::to_string(i), vals);
+            });
+        }
+    }
+
+private:
+    size_t count;
+    size_t values;
+};
+
+
+class PropertyReadBenchmark : public SuiteBenchmark {
+public:
+    PropertyReadBenchmark(size_t count, size_t values)
+            : SuiteBenchmark("property.read"), count(count), values(values) { }
+
+    void prepare(nix::File &fd) override {
+        nix::Section section = fd.createSection("properties", "nix.bench");
+        std::vector<nix::Value> vals;
+        for (size_t k = 0; k < values; k++) {
+            vals.emplace_back(static_cast<double>(k));
+        }
+        for (size_t i = 0; i < count; i++) {
+            section.createProperty("prop_" + std::to_string(i), vals);
+        }
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        nix::Section section = fd.getSection("properties");
+        for (size_t i = 0; i < count; i++) {
+            samples.time([this, &section, i] {
+                if (section.getProperty("prop_" + std::to_string(i)).values().size() != values) {
+                    throw std::runtime_error("property values incomplete");
+                }
+            });
+        }
+    }
+
+private:
+    size_t count;
+    size_t values;
+};
+
+
+class SectionSearchBenchmark : public SuiteBenchmark {
+public:
+    SectionSearchBenchmark(size_t depth, size_t fanout, size_t repeats)
+            : SuiteBenchmark("section.find"), depth(depth), fanout(fanout), repeats(repeats), targets(0) { }
+
+    void prepare(nix::File &fd) override {
+        nix::Section root = fd.createSection("root", "nix.bench");
+        grow(root, 1);
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        for (size_t i = 0; i < repeats; i++) {
+            samples.time([this, &fd] {
+                if (fd.findSections(nix::util::TypeFilter<nix::Section>("nix.bench.target")).size() != targets) {
+                    throw std::runtime_error("search incomplete");
+                }
+            });
+        }
+    }
+
+private:
+    // every third section is a search target
+    void grow(nix::Section &parent, size_t level) {
+        if (level >= depth) {
+            return;
+        }
+        for (size_t i = 0; i < fanout; i++) {
+            bool target = (level + i) % 3 == 0;
+            nix::Section child = parent.createSection("s_" + std::to_string(i), target ? "nix.bench.target" : "nix.bench");
+            targets += target ? 1 : 0;
+            grow(child, level + 1);
+        }
+    }
+
+    size_t depth;
+    size_t fanout;
+    size_t repeats;
+    size_t targets;
+};
+
+
+// block with arrays, tags and metadata, as used by validate & dump
+static void prepare_content(nix::File &fd, size_t arrays) {
+    nix::Section meta = fd.createSection("recording", "nix.bench");
+    std::vector<double> data(64, 1.0);
+    nix::Block block = fd.createBlock("content", "nix.bench");
+    block.metadata(meta);
+
+    std::vector<nix::DataArray> refs;
+    for (size_t i = 0; i < arrays; i++) {
+        nix::DataArray da = block.createDataArray("array_" + std::to_string(i), "nix.bench", data);
+        da.appendSampledDimension(0.1).unit("ms");
+        refs.push_back(da);
+        nix::Section s = meta.createSection("trial_" + std::to_string(i), "nix.bench.trial");
+        s.createProperty("duration", nix::Value(6.4)).unit("ms");
+    }
+    for (size_t i = 0; i < arrays; i++) {
+        nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.bench", {1.0});
+        tag.units({"ms"});
+        for (size_t k = 0; k < std::min<size_t>(4, arrays); k++) {
+            tag.addReference(refs[(i + k) % arrays]);
+        }
+    }
+}
+
+
+class ValidateSuiteBenchmark : public SuiteBenchmark {
+public:
+    ValidateSuiteBenchmark(size_t arrays, size_t repeats)
+            : SuiteBenchmark("validate"), arrays(arrays), repeats(repeats) { }
+
+    void prepare(nix::File &fd) override {
+        prepare_content(fd, arrays);
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        for (size_t i = 0; i < repeats; i++) {
+            samples.time([&fd] {
+                fd.validate();
+            });
+        }
+    }
+
+private:
+    size_t arrays;
+    size_t repeats;
+};
+
+
+// an output buffer that only counts
+class CountingBuffer : public std::streambuf {
+public:
+    size_t count = 0;
+
+protected:
+    int_type overflow(int_type c) override {
+        count++;
+        return c;
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+        count += n;
+        return n;
+    }
+};
+
+class DumpBenchmark : public SuiteBenchmark {
+public:
+    DumpBenchmark(size_t arrays, size_t repeats)
+            : SuiteBenchmark("dump"), arrays(arrays), repeats(repeats) { }
+
+    void prepare(nix::File &fd) override {
+        prepare_content(fd, arrays);
+    }
+
+    void run(nix::File &fd, Samples &samples) override {
+        for (size_t i = 0; i < repeats; i++) {
+            CountingBuffer buffer;
+            std::ostream out(&buffer);
+            samples.time([&fd, &out] {
+                cli::module::yamlstream yaml(out);
+                yaml << fd;
+            });
+            samples.bytes(buffer.count);
+        }
+    }
+
+private:
+    size_t arrays;
+    size_t repeats;
+};
+
+
+static std::vector<SuiteBenchmark *> make_suite(double scale) {
+    auto n = [scale](size_t count) {
+        return std::max<size_t>(1, static_cast<size_t>(count * scale));
+    };
+
+    std::vector<SuiteBenchmark *> suite;
+    suite.push_back(new CreateTagBenchmark(n(10000)));
+    suite.push_back(new CreateDataArrayBenchmark(n(2000)));
+    suite.push_back(new LookupBenchmark(n(10000), n(2000), false));
+    suite.push_back(new LookupBenchmark(n(10000), n(2000), true));
+    suite.push_back(new EnumerateBenchmark(n(10000), 5));
+    suite.push_back(new EnumerateBenchmark(n(100000), 3));
+    suite.push_back(new RetrieveTagBenchmark(n(1000), 1000));
+    suite.push_back(new ReadTagBenchmark(n(10000)));
+    suite.push_back(new RetrieveMultiTagBenchmark(n(1000), 1000));
+    suite.push_back(new PropertyWriteBenchmark(n(2000), 10));
+    suite.push_back(new PropertyReadBenchmark(n(2000), 10));
+    suite.push_back(new SectionSearchBenchmark(5, 6, 10));
+    suite.push_back(new ValidateSuiteBenchmark(n(200), 5));
+    suite.push_back(new DumpBenchmark(n(200), 5));
+    return suite;
+}
+
+static Result run_suite_benchmark(SuiteBenchmark &benchmark, const std::string &backend, bool io_stats) {
+    std::string path = "suite_" + benchmark.name() + (backend == "hdf5" ? ".h5" : ".nix");
+    Samples samples;
+    uint64_t io_calls = 0;
+    std::string error;
+    try {
+        {
+            nix::File fd = nix::File::open(path, nix::FileMode::Overwrite, backend);
+            benchmark.prepare(fd);
+            fd.close();
+        }
+        nix::File fd = nix::File::open(path, nix::FileMode::ReadWrite, backend);
+        fd.collectIOStatistics(io_stats);
+        benchmark.run(fd, samples);
+        for (const auto &calls : fd.ioStatistics().calls()) {
+            io_calls += calls.second.count;
+        }
+        fd.close();
+    } catch (const std::exception &e) {
+        error = e.what();
+    }
+
+    Result r = samples.summarize(benchmark.name(), backend);
+    r.io_calls = r.samples > 0 ? static_cast<double>(io_calls) / r.samples : 0;
+    // the file backend stores a directory, which has no size here
+    std::ifstream stored(path, std::ios::binary | std::ios::ate);
+    if (stored) {
+        r.file_bytes = std::max(static_cast<double>(stored.tellg()), 0.0);
+    }
+    r.error = error;
+    return r;
+}
+
+/* ************************************ */
+
+static std::string csv_escape(const std::string &str) {
+    if (str.find_first_of(",\"\n") == std::string::npos) {
+        return str;
+    }
+    std::string out = "\"";
+    for (char c : str) {
+        out += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return out + "\"";
+}
+
+static std::string json_escape(const std::string &str) {
+    std::string out = "\"";
+    for (char c : str) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:   out += c;
+        }
+    }
+    return out + "\"";
+}
+
+static std::vector<std::string> result_values(const Result &r) {
+    auto num = [](double v) {
+        std::stringstream s;
+        s.precision(6);
+        s << v;
+        return s.str();
+    };
+    return {r.name, r.backend, std::to_string(r.samples), num(r.mean_us), num(r.p50_us), num(r.p90_us),
+            num(r.p99_us), num(r.min_us), num(r.max_us), num(r.ops_per_s), num(r.mb_per_s), num(r.io_calls),
+            num(r.file_bytes), r.error};
+}
+
+static void write_results(std::ostream &out, const std::vector<Result> &results, const std::string &format) {
+    if (format == "json") {
+        out << "{\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            std::vector<std::string> values = result_values(results[i]);
+            out << (i ? "," : "") << "\n    {";
+            for (size_t k = 0; k < values.size(); k++) {
+                bool text = k < 2 || k == values.size() - 1;
+                out << (k ? ", " : "") << json_escape(result_fields[k]) << ": "
+                    << (text ? json_escape(values[k]) : values[k]);
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    } else if (format == "csv") {
+        for (size_t k = 0; k < result_fields.size(); k++) {
+            out << (k ? "," : "") << result_fields[k];
+        }
+        out << "\n";
+        for (const Result &r : results) {
+            std::vector<std::string> values = result_values(r);
+            for (size_t k = 0; k < values.size(); k++) {
+                out << (k ? "," : "") << csv_escape(values[k]);
+            }
+            out << "\n";
+        }
+    } else {
+        out << " === Reports ===" << std::endl;
+        out.precision(5);
+        out.unsetf(std::ios::floatfield);
+        for (const Result &r : results) {
+            out << r.name << " [" << r.backend << "], ";
+            if (!r.error.empty()) {
+                out << "ERROR: " << r.error << std::endl;
+                continue;
+            }
+            if (r.samples > 0) {
+                out << r.samples << " samples, p50 " << r.p50_us << " us, p90 " << r.p90_us
+                    << " us, p99 " << r.p99_us << " us, ";
+            }
+            if (r.ops_per_s > 0) {
+                out << r.ops_per_s << " N/s";
+            }
+            if (r.mb_per_s > 0) {
+                out << (r.ops_per_s > 0 ? ", " : "") << r.mb_per_s << " MB/s";
+            }
+            if (r.io_calls > 0) {
+                out << ", " << r.io_calls << " io calls/op";
+            }
+            if (r.file_bytes > 0) {
+                out << ", " << r.file_bytes / 1024 << " KiB file";
+            }
+            out << std::endl;
+        }
+    }
+}
+
+/* ************************************ */
+
+/*
+ * Reads results written by write_results (JSON or CSV); just enough
+ * of both formats for that.
+ */
+class ResultReader {
+public:
+    static std::vector<Result> read(const std::string &path) {
+        std::ifstream in(path);
+        if (!in) {
+            throw std::runtime_error("Could not open " + path);
+        }
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t start = text.find_first_not_of(" \t\r\n");
+        if (start != std::string::npos && text[start] == '{') {
+            return read_json(text);
+        }
+        return read_csv(text);
+    }
+
+private:
+    static Result make_result(const std::map<std::string, std::string> &fields) {
+        auto get = [&fields](const std::string &key) {
+            auto it = fields.find(key);
+            return it == fields.end() ? std::string() : it->second;
+        };
+        auto num = [&get](const std::string &key) {
+            std::string v = get(key);
+            return v.empty() ? 0.0 : std::stod(v);
+        };
+
+        Result r;
+        r.name = get("name");
+        r.backend = get("backend");
+        r.samples = static_cast<size_t>(num("samples"));
+        r.mean_us = num("mean_us");
+        r.p50_us = num("p50_us");
+        r.p90_us = num("p90_us");
+        r.p99_us = num("p99_us");
+        r.min_us = num("min_us");
+        r.max_us = num("max_us");
+        r.ops_per_s = num("ops_per_s");
+        r.mb_per_s = num("mb_per_s");
+        r.io_calls = num("io_calls");
+        r.file_bytes = num("file_bytes");
+        r.error = get("error");
+        return r;
+    }
+
+    static std::vector<Result> read_json(const std::string &text) {
+        std::vector<Result> results;
+        size_t pos = text.find("\"results\"");
+        if (pos == std::string::npos) {
+            throw std::runtime_error("No results in JSON");
+        }
+
+        std::map<std::string, std::string> fields;
+        std::string key;
+        bool in_object = false;
+        for (pos = text.find('[', pos) + 1; pos < text.size() && text[pos] != ']'; pos++) {
+            char c = text[pos];
+            if (c == '{') {
+                in_object = true;
+                fields.clear();
+                key.clear();
+            } else if (c == '}') {
+                in_object = false;
+                results.push_back(make_result(fields));
+            } else if (in_object && c == '"') {
+                std::string str = json_string(text, pos);
+                if (key.empty()) {
+                    key = str;
+                } else {
+                    fields[key] = str;
+                    key.clear();
+                }
+            } else if (in_object && !key.empty() && (std::isdigit(c) || c == '-')) {
+                size_t end = text.find_first_of(",}", pos);
+                fields[key] = text.substr(pos, end - pos);
+                key.clear();
+                pos = end - 1;
+            }
+        }
+        return results;
+    }
+
+    // reads the string starting at pos, leaves pos at the closing quote
+    static std::string json_string(const std::string &text, size_t &pos) {
+        std::string str;
+        for (pos++; pos < text.size() && text[pos] != '"'; pos++) {
+            if (text[pos] == '\\' && pos + 1 < text.size()) {
+                pos++;
+                str += text[pos] == 'n' ? '\n' : text[pos] == 't' ? '\t' : text[pos];
+            } else {
+                str += text[pos];
+            }
+        }
+        return str;
+    }
+
+    static std::vector<std::string> csv_line(std::istream &in) {
+        std::vector<std::string> values;
+        std::string line, value;
+        if (!std::getline(in, line)) {
+            return values;
+        }
+        bool quoted = false;
+        for (size_t i = 0; i < line.size(); i++) {
+            char c = line[i];
+            if (quoted) {
+                if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                    value += '"';
+                    i++;
+                } else if (c == '"') {
+                    quoted = false;
+                } else {
+                    value += c;
+                }
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                values.push_back(value);
+                value.clear();
+            } else if (c != '\r') {
+                value += c;
+            }
+        }
+        values.push_back(value);
+        return values;
+    }
+
+    static std::vector<Result> read_csv(const std::string &text) {
+        std::vector<Result> results;
+        std::stringstream in(text);
+        std::vector<std::string> header = csv_line(in);
+        for (std::vector<std::string> values = csv_line(in); !values.empty(); values = csv_line(in)) {
+            if (values.size() == 1 && values[0].empty()) {
+                continue;
+            }
+            std::map<std::string, std::string> fields;
+            for (size_t k = 0; k < header.size() && k < values.size(); k++) {
+                fields[header[k]] = values[k];
+            }
+            results.push_back(make_result(fields));
+        }
+        return results;
+    }
+};
+
+/*
+ * Compares two runs benchmark by benchmark: by median latency where
+ * there is one, by throughput otherwise. Returns the number of
+ * regressions beyond threshold (in percent).
+ */
+static size_t compare_results(std::ostream &out, const std::vector<Result> &base,
+                              const std::vector<Result> &current, double threshold) {
+    std::map<std::pair<std::string, std::string>, Result> base_map;
+    for (const Result &r : base) {
+        base_map[std::make_pair(r.name, r.backend)] = r;
+    }
+
+    size_t regressions = 0;
+    out.precision(4);
+    out.unsetf(std::ios::floatfield);
+    for (const Result &r : current) {
+        auto it = base_map.find(std::make_pair(r.name, r.backend));
+        out << r.name << " [" << r.backend << "]: ";
+        if (it == base_map.end()) {
+            out << "new" << std::endl;
+            continue;
+        }
+        const Result &b = it->second;
+        base_map.erase(it);
+        if (!r.error.empty() || !b.error.empty()) {
+            out << "error: " << (r.error.empty() ? "(none)" : r.error)
+                << " (was: " << (b.error.empty() ? "(none)" : b.error) << ")" << std::endl;
+            regressions += r.error.empty() ? 0 : 1;
+            continue;
+        }
+
+        // slowdown in percent, positive is worse
+        double change;
+        if (b.p50_us > 0 && r.p50_us > 0) {
+            change = (r.p50_us / b.p50_us - 1) * 100;
+            out << "p50 " << b.p50_us << " -> " << r.p50_us << " us";
+        } else if (b.ops_per_s > 0 && r.ops_per_s > 0) {
+            change = (b.ops_per_s / r.ops_per_s - 1) * 100;
+            out << b.ops_per_s << " -> " << r.ops_per_s << " N/s";
+        } else if (b.mb_per_s > 0 && r.mb_per_s > 0) {
+            change = (b.mb_per_s / r.mb_per_s - 1) * 100;
+            out << b.mb_per_s << " -> " << r.mb_per_s << " MB/s";
+        } else {
+            out << "not comparable" << std::endl;
+            continue;
+        }
+        out << " (" << (change > 0 ? "+" : "") << change << "% time)";
+        if (change > threshold) {
+            out << " REGRESSION";
+            regressions++;
+        }
+        out << std::endl;
+    }
+
+    for (const auto &missing : base_map) {
+        out << missing.first.first << " [" << missing.first.second << "]: missing" << std::endl;
+    }
+
+    out << regressions << " regression(s) above " << threshold << "%" << std::endl;
+    return regressions;
+}
+
+/* ************************************ */
+
+/* ************************************ */
+
 static std::vector<Config> make_configs() {
 
     std::vector<Config> configs;
@@ -543,66 +1752,294 @@ static std::vector<Config> make_configs() {
     return configs;
 }
 
-int main(int argc, char **argv)
-{
+
+/*
+ * The raw IO, creation, concurrency and validation benchmarks, on the
+ * hdf5 backend.
+ */
+static void run_io_suite(std::vector<Result> &results) {
     nix::File fd = nix::File::open("iospeed.h5", nix::FileMode::Overwrite);
     nix::Block block = fd.createBlock("speed", "nix.test");
 
     std::vector<Config> configs = make_configs();
     std::vector<Benchmark *> marks;
 
-    std::cout << "Performing generators tests..." << std::endl;
+    std::cerr << "Performing generators tests..." << std::endl;
     for (const Config &cfg : configs) {
         GeneratorBenchmark *benchmark = new GeneratorBenchmark(cfg);
         benchmark->run(block);
         marks.push_back(benchmark);
     }
 
-    std::cout << "Performing disk IO tests..." << std::endl;
+    std::cerr << "Performing disk IO tests..." << std::endl;
     for (const Config &cfg : configs) {
         DiskWriteBenchmark *b = new DiskWriteBenchmark(cfg);
         b->run(block);
         marks.push_back(b);
     }
 
-    std::cout << "Performing read tests..." << std::endl;
+    std::cerr << "Performing read tests..." << std::endl;
     for (const Config &cfg : configs) {
         DiskReadBenchmark *b = new DiskReadBenchmark(cfg);
         b->run(block);
         marks.push_back(b);
     }
 
-    std::cout << "Performing write tests..." << std::endl;
+    std::cerr << "Performing write tests..." << std::endl;
     for (const Config &cfg : configs) {
         WriteBenchmark *benchmark = new WriteBenchmark(cfg);
         benchmark->run(block);
         marks.push_back(benchmark);
     }
 
-    std::cout << "Performing read tests..." << std::endl;
+    std::cerr << "Performing read tests..." << std::endl;
     for (const Config &cfg : configs) {
         ReadBenchmark *benchmark = new ReadBenchmark(cfg);
         benchmark->run(block);
         marks.push_back(benchmark);
     }
 
-    std::cout << "Performing read (poly) tests..." << std::endl;
+    std::cerr << "Performing read (poly) tests..." << std::endl;
     for (const Config &cfg : configs) {
         ReadPolyBenchmark *benchmark = new ReadPolyBenchmark(cfg);
         benchmark->run(block);
         marks.push_back(benchmark);
     }
 
-    std::cout << " === Reports ===" << std::endl;
-    std::cout.precision(5);
-    std::cout.unsetf (std::ios::floatfield);
+    std::cerr << "Performing tag creation tests..." << std::endl;
+    std::vector<EntityBenchmark *> entity_marks;
+    for (bool deferred : {false, true}) {
+        TagCreationBenchmark *benchmark = new TagCreationBenchmark(100000, deferred);
+        benchmark->run();
+        entity_marks.push_back(benchmark);
+    }
+
+    std::cerr << "Performing data array creation tests..." << std::endl;
+    for (bool bulk : {false, true}) {
+        DataArrayCreationBenchmark *benchmark = new DataArrayCreationBenchmark(10000, bulk);
+        benchmark->run();
+        entity_marks.push_back(benchmark);
+    }
+
+    std::cerr << "Performing concurrent read tests..." << std::endl;
+    std::vector<ConcurrentReadBenchmark *> read_marks;
+    ConcurrentReadBenchmark::prepare("concurrent.h5", 64, 512 * 1024);
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        ConcurrentReadBenchmark *benchmark = new ConcurrentReadBenchmark(threads, 64, 512 * 1024);
+        benchmark->run("concurrent.h5");
+        read_marks.push_back(benchmark);
+    }
+
+    std::cerr << "Performing compressed read tests..." << std::endl;
+    std::vector<DecompressBenchmark *> decompress_marks;
+    DecompressBenchmark::prepare("compressed.h5", 32 * 1024 * 1024);
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        DecompressBenchmark *benchmark = new DecompressBenchmark(threads, 32 * 1024 * 1024);
+        benchmark->run("compressed.h5");
+        decompress_marks.push_back(benchmark);
+    }
+
+    std::cerr << "Performing compressed write tests..." << std::endl;
+    std::vector<CompressBenchmark *> compress_marks;
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        CompressBenchmark *benchmark = new CompressBenchmark(threads, 32 * 1024 * 1024, 100 * 1000);
+        benchmark->run("compressed_write.h5");
+        compress_marks.push_back(benchmark);
+    }
+
+    std::cerr << "Performing validation tests..." << std::endl;
+    std::vector<ValidateBenchmark *> validate_marks;
+    ValidateBenchmark::prepare("validate.h5", 8, 50);
+    for (size_t threads : {1, 2, 4, 8}) {
+        ValidateBenchmark *benchmark = new ValidateBenchmark(threads);
+        benchmark->run("validate.h5");
+        validate_marks.push_back(benchmark);
+    }
+
+    // these only measure totals: throughput, no latencies
     for (Benchmark *mark : marks) {
-        std::cout << mark->cfg().name() << ", " << mark->id() << ", "
-                << mark->speed_in_mbs() << " MB/s, "
-                << mark->speed_in_nps() << " N/s" << std::endl;
+        Result r;
+        r.name = "io." + mark->id() + "." + mark->cfg().name();
+        r.backend = "hdf5";
+        r.ops_per_s = mark->speed_in_nps();
+        r.mb_per_s = mark->speed_in_mbs();
+        results.push_back(r);
         delete mark;
     }
 
+    for (EntityBenchmark *mark : entity_marks) {
+        Result r;
+        r.name = "io." + mark->id() + "." + mark->kind() + "@" + std::to_string(mark->entity_count());
+        r.backend = "hdf5";
+        r.ops_per_s = mark->speed_in_nps();
+        results.push_back(r);
+        delete mark;
+    }
+
+    for (ConcurrentReadBenchmark *mark : read_marks) {
+        Result r;
+        r.name = "io.R.ConcurrentRead@" + std::to_string(mark->thread_count()) + "T";
+        r.backend = "hdf5";
+        r.mb_per_s = mark->speed_in_mbs();
+        results.push_back(r);
+        delete mark;
+    }
+
+    for (DecompressBenchmark *mark : decompress_marks) {
+        Result r;
+        r.name = "io.R.DecompressRead@" + std::to_string(mark->thread_count()) + "T";
+        r.backend = "hdf5";
+        r.mb_per_s = mark->speed_in_mbs();
+        results.push_back(r);
+        delete mark;
+    }
+
+    for (CompressBenchmark *mark : compress_marks) {
+        Result r;
+        r.name = "io.W.CompressWrite@" + std::to_string(mark->thread_count()) + "T";
+        r.backend = "hdf5";
+        r.mb_per_s = mark->speed_in_mbs();
+        results.push_back(r);
+        delete mark;
+    }
+
+    // the result of a parallel validation must be the same as the sequential one
+    size_t base_errors = validate_marks.front()->error_count();
+    size_t base_warnings = validate_marks.front()->warning_count();
+    for (ValidateBenchmark *mark : validate_marks) {
+        Result r;
+        r.name = "io.V.Validate@" + std::to_string(mark->thread_count()) + "T";
+        r.backend = "hdf5";
+        r.samples = 1;
+        r.mean_us = r.p50_us = r.p90_us = r.p99_us = r.min_us = r.max_us = mark->ms() * 1000;
+        r.ops_per_s = 1000 / mark->ms();
+        if (mark->error_count() != base_errors || mark->warning_count() != base_warnings) {
+            r.error = "result differs from sequential validation";
+        }
+        results.push_back(r);
+        delete mark;
+    }
+}
+
+static void run_api_suite(std::vector<Result> &results, const std::vector<std::string> &backends,
+                          const std::string &filter, double scale, bool io_stats) {
+    std::vector<SuiteBenchmark *> suite = make_suite(scale);
+    for (SuiteBenchmark *benchmark : suite) {
+        if (benchmark->name().find(filter) == std::string::npos) {
+            continue;
+        }
+        for (const std::string &backend : backends) {
+            std::cerr << "Performing " << benchmark->name() << " [" << backend << "]..." << std::endl;
+            results.push_back(run_suite_benchmark(*benchmark, backend, io_stats));
+        }
+    }
+    for (SuiteBenchmark *benchmark : suite) {
+        delete benchmark;
+    }
+}
+
+static int usage(const char *name) {
+    std::cerr << "usage: " << name << " [options]\n"
+              << "  --suite io|api|all        benchmarks to run (default: all)\n"
+              << "  --backend hdf5|file|all   backends for the api suite (default: hdf5); the file\n"
+              << "                            backend is slow on large groups, use a small --scale\n"
+              << "  --filter <text>           only api benchmarks with <text> in their name\n"
+              << "  --scale <factor>          scale the problem sizes of the api suite (default: 1)\n"
+              << "  --io-stats                count the storage calls per operation (hdf5 only)\n"
+              << "  --format text|json|csv    output format (default: text)\n"
+              << "  --output <file>           write results to <file> instead of stdout\n"
+              << "       " << name << " compare <base> <current> [--threshold <percent>]\n"
+              << "                            compare two runs (json or csv), flag slowdowns\n"
+              << "                            above the threshold (default: 10)" << std::endl;
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    auto option = [&args](size_t &i) {
+        if (i + 1 >= args.size()) {
+            throw std::invalid_argument("missing value for " + args[i]);
+        }
+        return args[++i];
+    };
+
+    try {
+        if (!args.empty() && args[0] == "compare") {
+            std::vector<std::string> files;
+            double threshold = 10;
+            for (size_t i = 1; i < args.size(); i++) {
+                if (args[i] == "--threshold") {
+                    threshold = std::stod(option(i));
+                } else {
+                    files.push_back(args[i]);
+                }
+            }
+            if (files.size() != 2) {
+                return usage(argv[0]);
+            }
+            size_t regressions = compare_results(std::cout, ResultReader::read(files[0]),
+                                                 ResultReader::read(files[1]), threshold);
+            return regressions > 0 ? 1 : 0;
+        }
+
+        std::string suite = "all", backend = "default", filter, format = "text", output;
+        double scale = 1;
+        bool io_stats = false;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (args[i] == "--suite") {
+                suite = option(i);
+            } else if (args[i] == "--backend") {
+                backend = option(i);
+            } else if (args[i] == "--filter") {
+                filter = option(i);
+            } else if (args[i] == "--scale") {
+                scale = std::stod(option(i));
+            } else if (args[i] == "--io-stats") {
+                io_stats = true;
+            } else if (args[i] == "--format") {
+                format = option(i);
+            } else if (args[i] == "--output") {
+                output = option(i);
+            } else {
+                return usage(argv[0]);
+            }
+        }
+        if ((suite != "all" && suite != "io" && suite != "api") ||
+            (format != "text" && format != "json" && format != "csv")) {
+            return usage(argv[0]);
+        }
+
+        std::vector<std::string> backends;
+        if (backend == "all") {
+            backends.push_back("hdf5");
+#ifdef ENABLE_FS_BACKEND
+            backends.push_back("file");
+#endif
+        } else if (backend == "default") {
+            backends.push_back("hdf5");
+        } else {
+            backends.push_back(backend);
+        }
+
+        std::vector<Result> results;
+        if (suite == "all" || suite == "io") {
+            run_io_suite(results);
+        }
+        if (suite == "all" || suite == "api") {
+            run_api_suite(results, backends, filter, scale, io_stats);
+        }
+
+        if (output.empty()) {
+            write_results(std::cout, results, format);
+        } else {
+            std::ofstream out(output);
+            write_results(out, results, format);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
 
     return 0;
 }
@@ -15,6 +15,9 @@
 #include "TestOptionalObligatory.hpp"
 
 #include "TestValidate.hpp"
+#include "TestMetadataSnapshot.hpp"
+#include "TestIntervalIndex.hpp"
+#include "TestReduce.hpp"
 
 #include "hdf5/TestH5.hpp"
 #include "hdf5/TestEntityHDF5.hpp"
@@ -87,6 +90,9 @@ int main(int argc, char* argv[]) {
     CPPUNIT_TEST_SUITE_REGISTRATION(TestVersion);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestReadOnlyHDF5);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestGroupHDF5);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestMetadataSnapshot);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestIntervalIndex);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestReduce);
 
 #ifdef ENABLE_FS_BACKEND
     CPPUNIT_TEST_SUITE_REGISTRATION(TestAttributesFS);
@@ -0,0 +1,154 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestIntervalIndex.hpp"
+
+#include <nix/util/dataAccess.hpp>
+
+#include <algorithm>
+
+using namespace nix;
+
+
+static std::vector<std::string> keys(const std::vector<IntervalIndex::Interval> &intervals) {
+    std::vector<std::string> result;
+    for (const auto &i : intervals) {
+        result.push_back(i.tag + "/" + std::to_string(i.position));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+void TestIntervalIndex::setUp() {
+    file = File::open("test_interval_index.h5", FileMode::Overwrite);
+    block = file.createBlock("recording", "session");
+
+    std::vector<double> samples(1000, 0.0);
+    data = block.createDataArray("voltage", "trace", samples);
+    SampledDimension time = data.appendSampledDimension(0.001);
+    time.unit("s");
+
+    // 100 events of 20 ms each, every 10 ms, on a multi tag
+    std::vector<double> onsets, durations;
+    for (size_t i = 0; i < 100; i++) {
+        onsets.push_back(0.01 * i);
+        durations.push_back(0.02);
+    }
+    DataArray positions = block.createDataArray("onsets", "event", DataType::Double, NDSize({100, 1}));
+    positions.setData(DataType::Double, onsets.data(), NDSize({100, 1}), NDSize({0, 0}));
+    DataArray extents = block.createDataArray("durations", "event", DataType::Double, NDSize({100, 1}));
+    extents.setData(DataType::Double, durations.data(), NDSize({100, 1}), NDSize({0, 0}));
+    MultiTag events = block.createMultiTag("events", "event", positions);
+    events.extents(extents);
+    events.units({"s"});
+    events.addReference(data);
+
+    Tag stimulus = block.createTag("stimulus", "stimulus", {0.5});
+    stimulus.extent({0.1});
+    stimulus.units({"s"});
+    stimulus.addReference(data);
+
+    Tag marker = block.createTag("marker", "marker", {250.0});
+    marker.units({"ms"});
+    marker.addReference(data);
+
+    // tags of other data arrays are not indexed
+    Tag other = block.createTag("other", "marker", {0.5});
+    other.addReference(positions);
+}
+
+
+void TestIntervalIndex::tearDown() {
+    file.close();
+}
+
+
+void TestIntervalIndex::testBuild() {
+    IntervalIndex index(data);
+    CPPUNIT_ASSERT_EQUAL(size_t(102), index.size());
+
+    MultiTag events = block.getMultiTag("events");
+    Tag stimulus = block.getTag("stimulus");
+    Tag marker = block.getTag("marker");
+    for (size_t i = 0; i < index.size(); i++) {
+        const IntervalIndex::Interval &interval = index.interval(i);
+        NDSize offset, count;
+        if (interval.multiTag) {
+            CPPUNIT_ASSERT_EQUAL(events.id(), interval.tag);
+            util::getOffsetAndCount(events, data, interval.position, offset, count);
+        } else {
+            util::getOffsetAndCount(interval.tag == stimulus.id() ? stimulus : marker, data, offset, count);
+        }
+        CPPUNIT_ASSERT_EQUAL(offset[0], interval.begin);
+        CPPUNIT_ASSERT_EQUAL(offset[0] + count[0], interval.end);
+    }
+
+    CPPUNIT_ASSERT_THROW(IntervalIndex(data, 2), OutOfBounds);
+}
+
+
+void TestIntervalIndex::testOverlapping() {
+    IntervalIndex index(data);
+
+    // compare each query to a scan of all intervals
+    for (ndsize_t begin = 0; begin < 1100; begin += 37) {
+        for (ndsize_t length : {1, 5, 30, 400}) {
+            std::vector<IntervalIndex::Interval> expected;
+            for (size_t i = 0; i < index.size(); i++) {
+                const IntervalIndex::Interval &interval = index.interval(i);
+                if (interval.begin < begin + length && interval.end > begin) {
+                    expected.push_back(interval);
+                }
+            }
+            CPPUNIT_ASSERT(keys(expected) == keys(index.overlappingIndices(begin, begin + length)));
+        }
+    }
+
+    CPPUNIT_ASSERT(index.overlappingIndices(10, 10).empty());
+
+    std::string marker = block.getTag("marker").id();
+    std::string stimulus = block.getTag("stimulus").id();
+    std::vector<IntervalIndex::Interval> hits = index.overlapping(0.245, 0.255, "s");
+    CPPUNIT_ASSERT(std::any_of(hits.begin(), hits.end(), [&](const IntervalIndex::Interval &i) {
+        return i.tag == marker;
+    }));
+    CPPUNIT_ASSERT(std::none_of(hits.begin(), hits.end(), [&](const IntervalIndex::Interval &i) {
+        return i.tag == stimulus;
+    }));
+    hits = index.overlapping(550.0, 560.0, "ms");
+    CPPUNIT_ASSERT(std::any_of(hits.begin(), hits.end(), [&](const IntervalIndex::Interval &i) {
+        return i.tag == stimulus;
+    }));
+    CPPUNIT_ASSERT_EQUAL(size_t(3), hits.size());
+
+    CPPUNIT_ASSERT_THROW(index.overlapping(1.0, 2.0, "V"), IncompatibleDimensions);
+}
+
+
+void TestIntervalIndex::testRangeDimension() {
+    std::vector<double> values(5, 0.0);
+    DataArray spikes = block.createDataArray("spikes", "spike", values);
+    RangeDimension times = spikes.appendRangeDimension({0.1, 0.5, 0.6, 2.0, 3.5});
+    times.unit("s");
+
+    Tag burst = block.createTag("burst", "burst", {0.4});
+    burst.extent({0.3});
+    burst.units({"s"});
+    burst.addReference(spikes);
+
+    IntervalIndex index(spikes);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), index.size());
+    NDSize offset, count;
+    util::getOffsetAndCount(burst, spikes, offset, count);
+    CPPUNIT_ASSERT_EQUAL(offset[0], index.interval(0).begin);
+    CPPUNIT_ASSERT_EQUAL(offset[0] + count[0], index.interval(0).end);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), index.overlapping(0.55, 0.56, "s").size());
+    CPPUNIT_ASSERT(index.overlapping(3.0, 4.0, "s").empty());
+}
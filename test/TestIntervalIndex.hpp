@@ -0,0 +1,35 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class TestIntervalIndex: public CPPUNIT_NS::TestFixture {
+private:
+
+    CPPUNIT_TEST_SUITE(TestIntervalIndex);
+    CPPUNIT_TEST(testBuild);
+    CPPUNIT_TEST(testOverlapping);
+    CPPUNIT_TEST(testRangeDimension);
+    CPPUNIT_TEST_SUITE_END ();
+
+    nix::File file;
+    nix::Block block;
+    nix::DataArray data;
+
+public:
+
+    void setUp();
+    void tearDown();
+
+    void testBuild();
+    void testOverlapping();
+    void testRangeDimension();
+};
@@ -0,0 +1,160 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestMetadataSnapshot.hpp"
+
+#include <algorithm>
+
+using namespace nix;
+
+
+static std::vector<std::string> ids(const MetadataSnapshot &snapshot, const std::vector<size_t> &sections) {
+    std::vector<std::string> result;
+    for (size_t s : sections) {
+        result.push_back(snapshot.section(s).id);
+    }
+    return result;
+}
+
+
+static std::vector<std::string> ids(const std::vector<Section> &sections) {
+    std::vector<std::string> result;
+    for (const Section &s : sections) {
+        result.push_back(s.id());
+    }
+    return result;
+}
+
+
+void TestMetadataSnapshot::setUp() {
+    file = File::open("test_snapshot.h5", FileMode::Overwrite);
+
+    Section subjects = file.createSection("subjects", "collection");
+    Section mouse = subjects.createSection("mouse", "subject");
+    mouse.createProperty("species", Value("mus musculus"));
+    mouse.createProperty("age", Value(int32_t(3)));
+    Section session = mouse.createSection("session", "recording");
+    session.createProperty("rate", Value(1000.0));
+    session.createSection("electrode", "hardware");
+
+    Section rat = subjects.createSection("rat", "subject");
+    rat.createProperty("species", Value("rattus norvegicus"));
+    rat.createSection("session", "recording");
+
+    Section templates = file.createSection("templates", "collection");
+    Section animal = templates.createSection("animal", "subject");
+    animal.createProperty("species", Value("unknown"));
+    animal.createProperty("sex", Value("f"));
+    rat.link(animal);
+}
+
+
+void TestMetadataSnapshot::tearDown() {
+    file.close();
+}
+
+
+void TestMetadataSnapshot::testLoad() {
+    MetadataSnapshot snapshot(file);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8), snapshot.sectionCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), snapshot.propertyCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), snapshot.sections().size());
+
+    size_t subjects = snapshot.sections()[0];
+    const MetadataSnapshot::SectionNode &node = snapshot.section(subjects);
+    CPPUNIT_ASSERT_EQUAL(std::string("subjects"), node.name);
+    CPPUNIT_ASSERT_EQUAL(MetadataSnapshot::npos, node.parent);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), node.sections.size());
+
+    size_t mouse = node.sections[0];
+    CPPUNIT_ASSERT_EQUAL(std::string("mouse"), snapshot.section(mouse).name);
+    CPPUNIT_ASSERT_EQUAL(subjects, snapshot.section(mouse).parent);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), snapshot.section(mouse).level);
+
+    boost::optional<size_t> age = snapshot.propertyByName(mouse, "age");
+    CPPUNIT_ASSERT(age);
+    CPPUNIT_ASSERT_EQUAL(DataType::Int32, snapshot.property(*age).dataType);
+    CPPUNIT_ASSERT_EQUAL(int32_t(3), snapshot.property(*age).values[0].get<int32_t>());
+    CPPUNIT_ASSERT_EQUAL(mouse, snapshot.property(*age).section);
+
+    Section rat = file.getSection("subjects").getSection("rat");
+    size_t rat_index = *snapshot.sectionById(rat.id());
+    size_t animal = *snapshot.sectionById(rat.link().id());
+    CPPUNIT_ASSERT_EQUAL(animal, snapshot.section(rat_index).link);
+
+    // own species, inherited sex
+    std::vector<size_t> inherited = snapshot.inheritedProperties(rat_index);
+    CPPUNIT_ASSERT_EQUAL(rat.inheritedProperties().size(), inherited.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("rattus norvegicus"),
+                         snapshot.property(inherited[0]).values[0].get<std::string>());
+    CPPUNIT_ASSERT_EQUAL(std::string("sex"), snapshot.property(inherited[1]).name);
+}
+
+
+void TestMetadataSnapshot::testIndexes() {
+    MetadataSnapshot snapshot(file);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), snapshot.sectionsByName("session").size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), snapshot.sectionsByType("subject").size());
+    CPPUNIT_ASSERT(snapshot.sectionsByName("nothing").empty());
+    CPPUNIT_ASSERT(!snapshot.sectionById("no-such-id"));
+
+    Property rate = file.getSection("subjects").getSection("mouse").getSection("session").getProperty("rate");
+    CPPUNIT_ASSERT_EQUAL(std::string("rate"), snapshot.property(*snapshot.propertyById(rate.id())).name);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), snapshot.sectionsWithProperty("species").size());
+
+    std::vector<size_t> found = snapshot.sectionsWithProperty("species", Value("rattus norvegicus"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), found.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("rat"), snapshot.section(found[0]).name);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), snapshot.sectionsWithProperty("rate", Value(1000.0)).size());
+    // values of a different type do not match
+    CPPUNIT_ASSERT(snapshot.sectionsWithProperty("rate", Value(int32_t(1000))).empty());
+    CPPUNIT_ASSERT(snapshot.sectionsWithProperty("age", Value(int32_t(4))).empty());
+}
+
+
+void TestMetadataSnapshot::testFind() {
+    MetadataSnapshot snapshot(file);
+    auto recordings = [](const MetadataSnapshot::SectionNode &node) { return node.type == "recording"; };
+    auto subjects = [](const MetadataSnapshot::SectionNode &node) { return node.type == "subject"; };
+    auto hardware = [](const MetadataSnapshot::SectionNode &node) { return node.type == "hardware"; };
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), snapshot.findSections(recordings).size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8), snapshot.findSections(
+            [](const MetadataSnapshot::SectionNode &) { return true; }).size());
+
+    // same results as the queries on the file
+    Section top = file.getSection("subjects");
+    size_t top_index = *snapshot.sectionById(top.id());
+    CPPUNIT_ASSERT(ids(snapshot, snapshot.findSections(top_index, recordings)) ==
+                   ids(top.findSections(util::TypeFilter<Section>("recording"))));
+    CPPUNIT_ASSERT(ids(snapshot, snapshot.findSections(top_index, subjects, 1)) ==
+                   ids(top.findSections(util::TypeFilter<Section>("subject"), 1)));
+
+    Section mouse = top.getSection("mouse");
+    Section electrode = mouse.getSection("session").getSection("electrode");
+    size_t mouse_index = *snapshot.sectionById(mouse.id());
+    size_t electrode_index = *snapshot.sectionById(electrode.id());
+
+    std::vector<std::string> related = ids(snapshot, snapshot.findRelated(mouse_index, recordings));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), related.size());
+    CPPUNIT_ASSERT(related == ids(mouse.findRelated(util::TypeFilter<Section>("recording"))));
+
+    related = ids(snapshot, snapshot.findRelated(electrode_index, subjects));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), related.size());
+    CPPUNIT_ASSERT(related == ids(electrode.findRelated(util::TypeFilter<Section>("subject"))));
+
+    related = ids(snapshot, snapshot.findRelated(mouse_index, subjects));
+    CPPUNIT_ASSERT(related == ids(mouse.findRelated(util::TypeFilter<Section>("subject"))));
+
+    CPPUNIT_ASSERT(snapshot.findRelated(top_index, hardware).size() == 1);
+    CPPUNIT_ASSERT_THROW(snapshot.findSections(100, hardware), OutOfBounds);
+}
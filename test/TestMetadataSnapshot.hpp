@@ -0,0 +1,33 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class TestMetadataSnapshot: public CPPUNIT_NS::TestFixture {
+private:
+
+    CPPUNIT_TEST_SUITE(TestMetadataSnapshot);
+    CPPUNIT_TEST(testLoad);
+    CPPUNIT_TEST(testIndexes);
+    CPPUNIT_TEST(testFind);
+    CPPUNIT_TEST_SUITE_END ();
+
+    nix::File file;
+
+public:
+
+    void setUp();
+    void tearDown();
+
+    void testLoad();
+    void testIndexes();
+    void testFind();
+};
@@ -0,0 +1,175 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestReduce.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace nix;
+
+// 1000 samples x 3 channels
+static const ndsize_t rows = 1000;
+static const ndsize_t channels = 3;
+
+
+void TestReduce::setUp() {
+    file = File::open("test_reduce.h5", FileMode::Overwrite);
+    block = file.createBlock("recording", "session");
+
+    values.resize(rows * channels);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = std::sin(i * 0.37) * 100.0 + static_cast<double>(i % channels) * 0.1;
+    }
+    data = block.createDataArray("voltage", "trace", DataType::Double, NDSize({rows, channels}));
+    data.setData(DataType::Double, values.data(), NDSize({rows, channels}), NDSize({0, 0}));
+}
+
+
+void TestReduce::tearDown() {
+    file.close();
+}
+
+
+void TestReduce::testTiles() {
+    NDSize chunk = data.dataChunking();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), chunk.size());
+    ndsize_t automatic = util::tileRows(data);
+    CPPUNIT_ASSERT(automatic > 0);
+    CPPUNIT_ASSERT(automatic == rows || automatic % chunk[0] == 0);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(7), util::tileRows(data, 7));
+
+    // all rows, in order
+    std::vector<double> seen;
+    ndsize_t next = 0;
+    util::forEachTile(data, [&](const double *tile, const NDSize &count, const NDSize &offset) {
+        CPPUNIT_ASSERT_EQUAL(next, offset[0]);
+        CPPUNIT_ASSERT_EQUAL(channels, count[1]);
+        CPPUNIT_ASSERT(count[0] <= 7);
+        seen.insert(seen.end(), tile, tile + count.nelms());
+        next += count[0];
+    }, 7);
+    CPPUNIT_ASSERT(seen == values);
+
+    // a DataView is reduced relative to its own offset
+    DataView view(data, NDSize({100, 2}), NDSize({50, 1}));
+    util::Statistics stats = util::statistics(view, 9);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(200), stats.count);
+    double lo = values[50 * channels + 1];
+    for (size_t r = 50; r < 150; r++) {
+        lo = std::min(lo, std::min(values[r * channels + 1], values[r * channels + 2]));
+    }
+    CPPUNIT_ASSERT_EQUAL(lo, stats.min);
+
+    CPPUNIT_ASSERT_THROW(util::forEachTile(data, [](const double *, const NDSize &, const NDSize &) {
+        throw std::runtime_error("kernel");
+    }, 7), std::runtime_error);
+}
+
+
+void TestReduce::testStatistics() {
+    util::Statistics stats = util::statistics(data);
+    CPPUNIT_ASSERT_EQUAL(rows * channels, stats.count);
+    CPPUNIT_ASSERT_EQUAL(*std::min_element(values.begin(), values.end()), stats.min);
+    CPPUNIT_ASSERT_EQUAL(*std::max_element(values.begin(), values.end()), stats.max);
+
+    double sum = 0, deviations = 0;
+    for (double v : values) {
+        sum += v;
+    }
+    double mean = sum / values.size();
+    for (double v : values) {
+        deviations += (v - mean) * (v - mean);
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(sum, stats.sum, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(deviations, stats.squaredDeviations, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(deviations / values.size(), stats.variance(), 1e-9);
+
+    // the same bits for any tile size
+    for (ndsize_t tile : {1, 3, 7, 64, 1000}) {
+        util::Statistics other = util::statistics(data, tile);
+        CPPUNIT_ASSERT_EQUAL(stats.sum, other.sum);
+        CPPUNIT_ASSERT_EQUAL(stats.squaredDeviations, other.squaredDeviations);
+    }
+
+    // small variations of values far from zero, where a sum of squares
+    // loses all digits of the variance
+    std::vector<double> shifted(values.size());
+    std::transform(values.begin(), values.end(), shifted.begin(), [](double v) { return 1e9 + v / 100.0; });
+    DataArray offset = block.createDataArray("offset", "trace", DataType::Double, NDSize({rows, channels}));
+    offset.setData(DataType::Double, shifted.data(), NDSize({rows, channels}), NDSize({0, 0}));
+    util::Statistics far = util::statistics(offset, 7);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(stats.variance() / 1e4, far.variance(), 1e-6);
+}
+
+
+void TestReduce::testChannels() {
+    std::vector<util::Statistics> stats = util::channelStatistics(data, 1);
+    CPPUNIT_ASSERT_EQUAL(size_t(channels), stats.size());
+    for (size_t c = 0; c < channels; c++) {
+        double lo = values[c], hi = values[c], sum = 0;
+        for (size_t r = 0; r < rows; r++) {
+            lo = std::min(lo, values[r * channels + c]);
+            hi = std::max(hi, values[r * channels + c]);
+            sum += values[r * channels + c];
+        }
+        CPPUNIT_ASSERT_EQUAL(rows, stats[c].count);
+        CPPUNIT_ASSERT_EQUAL(lo, stats[c].min);
+        CPPUNIT_ASSERT_EQUAL(hi, stats[c].max);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sum / rows, stats[c].mean(), 1e-9);
+
+        util::Statistics other = util::channelStatistics(data, 1, 13)[c];
+        CPPUNIT_ASSERT_EQUAL(stats[c].sum, other.sum);
+    }
+
+    std::vector<util::Statistics> per_row = util::channelStatistics(data, 0, 11);
+    CPPUNIT_ASSERT_EQUAL(size_t(rows), per_row.size());
+    CPPUNIT_ASSERT_EQUAL(channels, per_row[10].count);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(values[30] + values[31] + values[32], per_row[10].sum, 1e-9);
+
+    CPPUNIT_ASSERT_THROW(util::channelStatistics(data, 2), InvalidRank);
+}
+
+
+void TestReduce::testHistogram() {
+    util::Histogram hist = util::histogram(data, -50.0, 50.0, 10);
+    CPPUNIT_ASSERT_EQUAL(size_t(10), hist.bins.size());
+    ndsize_t below = 0, above = 0, third = 0;
+    for (double v : values) {
+        below += v < -50.0;
+        above += v >= 50.0;
+        third += v >= -30.0 && v < -20.0;
+    }
+    CPPUNIT_ASSERT_EQUAL(below, hist.below);
+    CPPUNIT_ASSERT_EQUAL(above, hist.above);
+    CPPUNIT_ASSERT_EQUAL(third, hist.bins[2]);
+    ndsize_t total = hist.below + hist.above;
+    for (ndsize_t n : hist.bins) {
+        total += n;
+    }
+    CPPUNIT_ASSERT_EQUAL(rows * channels, total);
+
+    std::vector<util::Histogram> per_channel = util::channelHistograms(data, 1, -50.0, 50.0, 10, 17);
+    CPPUNIT_ASSERT_EQUAL(size_t(channels), per_channel.size());
+    for (size_t b = 0; b < 10; b++) {
+        CPPUNIT_ASSERT_EQUAL(hist.bins[b], per_channel[0].bins[b] + per_channel[1].bins[b] + per_channel[2].bins[b]);
+    }
+
+    CPPUNIT_ASSERT_THROW(util::histogram(data, 1.0, 1.0, 10), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(util::histogram(data, 0.0, 1.0, 0), std::invalid_argument);
+}
+
+
+void TestReduce::testCalibration() {
+    util::Statistics raw = util::statistics(data);
+    data.polynomCoefficients({1.0, 2.0});
+    util::Statistics calibrated = util::statistics(data, 5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 2.0 * raw.min, calibrated.min, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 2.0 * raw.max, calibrated.max, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 2.0 * raw.mean(), calibrated.mean(), 1e-9);
+}
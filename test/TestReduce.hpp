@@ -0,0 +1,40 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class TestReduce: public CPPUNIT_NS::TestFixture {
+private:
+
+    CPPUNIT_TEST_SUITE(TestReduce);
+    CPPUNIT_TEST(testTiles);
+    CPPUNIT_TEST(testStatistics);
+    CPPUNIT_TEST(testChannels);
+    CPPUNIT_TEST(testHistogram);
+    CPPUNIT_TEST(testCalibration);
+    CPPUNIT_TEST_SUITE_END ();
+
+    nix::File file;
+    nix::Block block;
+    nix::DataArray data;
+    std::vector<double> values;
+
+public:
+
+    void setUp();
+    void tearDown();
+
+    void testTiles();
+    void testStatistics();
+    void testChannels();
+    void testHistogram();
+    void testCalibration();
+};
@@ -10,6 +10,8 @@
 
 #include <ctime>
 #include <cmath>
+#include <thread>
+#include <unordered_set>
 
 
 using namespace std;
@@ -199,3 +201,111 @@ void TestUtil::testStringVectors() {
     CPPUNIT_ASSERT(util::isSetAtSamePos(vec_a, vec_c));
     CPPUNIT_ASSERT(!util::isSetAtSamePos(vec_a, vec_d));
 }
+
+void TestUtil::testTimeConversion() {
+    CPPUNIT_ASSERT_EQUAL(std::string("19700101T000000"), util::timeToStr(0));
+    CPPUNIT_ASSERT_EQUAL(std::string("20000229T235959"), util::timeToStr(951868799));
+    CPPUNIT_ASSERT_EQUAL(std::string("20381231T120000"), util::timeToStr(2177409600));
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<time_t>(0), util::strToTime("19700101T000000"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<time_t>(951868799), util::strToTime("20000229T235959"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<time_t>(951868799), util::strToTime("20000229T235959.25"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<time_t>(-86400), util::strToTime("19691231T000000"));
+
+    time_t now = util::getTime();
+    CPPUNIT_ASSERT_EQUAL(now, util::strToTime(util::timeToStr(now)));
+
+    CPPUNIT_ASSERT_THROW(util::strToTime("20010229T000000"), std::exception);
+    CPPUNIT_ASSERT_THROW(util::strToTime("not a date"), std::exception);
+    CPPUNIT_ASSERT_THROW(util::strToTime("20200101T000000.garbage"), std::exception);
+    CPPUNIT_ASSERT_THROW(util::strToTime("20200101T000000.25x"), std::exception);
+}
+
+
+void TestUtil::testCreateId() {
+    std::string id = util::createId();
+    CPPUNIT_ASSERT(util::looksLikeUUID(id));
+    CPPUNIT_ASSERT_EQUAL('4', id[14]);
+    CPPUNIT_ASSERT(id[19] == '8' || id[19] == '9' || id[19] == 'a' || id[19] == 'b');
+    CPPUNIT_ASSERT_EQUAL(std::string::npos, id.find_first_not_of("0123456789abcdef-"));
+
+    // ids created concurrently on several threads must all be unique
+    const size_t n_threads = 8;
+    const size_t n_ids = 20000;
+    std::vector<std::vector<std::string>> ids(n_threads);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < n_threads; i++) {
+        threads.emplace_back([&ids, i, n_ids] {
+            ids[i].reserve(n_ids);
+            for (size_t k = 0; k < n_ids; k++) {
+                ids[i].push_back(util::createId());
+            }
+        });
+    }
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::unordered_set<std::string> seen;
+    for (const auto &thread_ids : ids) {
+        for (const auto &tid : thread_ids) {
+            CPPUNIT_ASSERT(util::looksLikeUUID(tid));
+            CPPUNIT_ASSERT(seen.insert(tid).second);
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(n_threads * n_ids, seen.size());
+}
+
+
+void TestUtil::testTrace() {
+    util::clearTrace();
+    util::enableTracing();
+
+    File file = File::open("test_trace.h5", FileMode::Overwrite);
+    Block block = file.createBlock("trace", "test");
+    DataArray data = block.createDataArray("data", "test", DataType::Double, NDSize({100}));
+    std::vector<double> values(100, 1.0);
+    data.setData(values);
+    SampledDimension dim = data.appendSampledDimension(0.1);
+    dim.unit("s");
+    Tag tag = block.createTag("tag", "test", {1.0});
+    tag.extent({2.0});
+    tag.units({"s"});
+    tag.addReference(data);
+
+    std::thread reader([&tag] {
+        DataView view = tag.retrieveData(0);
+        CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(20), view.dataExtent()[0]);
+    });
+    reader.join();
+
+    util::disableTracing();
+    // spans are only recorded while tracing is enabled
+    data.getDimension(1);
+    file.close();
+
+    std::ostringstream out;
+    util::writeTrace(out);
+    const string trace = out.str();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    CPPUNIT_ASSERT(trace.find("\"name\":\"Tag::retrieveData\"") != string::npos);
+    CPPUNIT_ASSERT(trace.find("\"name\":\"positionToIndex\"") != string::npos);
+    CPPUNIT_ASSERT(trace.find("\"name\":\"H5Dwrite\",\"cat\":\"h5x\",\"ph\":\"X\"") != string::npos);
+    CPPUNIT_ASSERT(trace.find("\"name\":\"DataArray::getDimension\"") != string::npos);
+
+    // the spans of the reader thread have their own thread id
+    size_t retrieve = trace.find("\"name\":\"Tag::retrieveData\"");
+    size_t write = trace.find("\"name\":\"H5Dwrite\"");
+    size_t tid_retrieve = trace.find("\"tid\":", retrieve);
+    size_t tid_write = trace.find("\"tid\":", write);
+    CPPUNIT_ASSERT(trace.substr(tid_retrieve, 8) != trace.substr(tid_write, 8));
+
+    util::clearTrace();
+    std::ostringstream empty;
+    util::writeTrace(empty);
+    CPPUNIT_ASSERT(empty.str().find("\"ph\":\"X\"") == string::npos);
+}
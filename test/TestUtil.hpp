@@ -41,6 +41,9 @@ private:
     CPPUNIT_TEST(testDimTypeToStr);
     CPPUNIT_TEST(testChecks);
     CPPUNIT_TEST(testStringVectors);
+    CPPUNIT_TEST(testTimeConversion);
+    CPPUNIT_TEST(testCreateId);
+    CPPUNIT_TEST(testTrace);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -57,7 +60,10 @@ public:
     void testConvertToKelvin();
     void testUnitSanitizer();
     void testDimTypeToStr();
+    void testCreateId();
     void testChecks();
     void testStringVectors();
+    void testTimeConversion();
+    void testTrace();
 };
 
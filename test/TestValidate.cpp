@@ -370,6 +370,16 @@ void TestValidate::test() {
     // std::cout << myResult;
     CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), myResult.getWarnings().size());
     CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(11), myResult.getErrors().size());
+
+    // validating concurrently must not change the result or its order
+    nix::valid::Result parallelResult = file.validate(4);
+    std::vector<nix::valid::Message> errors = myResult.getErrors();
+    std::vector<nix::valid::Message> parallel_errors = parallelResult.getErrors();
+    CPPUNIT_ASSERT_EQUAL(errors.size(), parallel_errors.size());
+    for (size_t i = 0; i < errors.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(errors[i].id, parallel_errors[i].id);
+        CPPUNIT_ASSERT_EQUAL(errors[i].msg, parallel_errors[i].msg);
+    }
     
     // uncomment this to have debug info
     // std::cout << myResult;
@@ -24,6 +24,7 @@ class TestBlockFS : public BaseTestBlock {
     CPPUNIT_TEST(testSourceAccess);
     CPPUNIT_TEST(testDataArrayAccess);
     CPPUNIT_TEST(testTagAccess);
+    CPPUNIT_TEST(testBulkCreation);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
 
@@ -26,6 +26,7 @@ class TestDataArrayFS : public BaseTestDataArray {
     CPPUNIT_TEST(testAliasRangeDimension);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testReferencingEntities);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -25,8 +25,11 @@ class TestBlockHDF5 : public BaseTestBlock {
     CPPUNIT_TEST(testSourceAccess);
     CPPUNIT_TEST(testDataArrayAccess);
     CPPUNIT_TEST(testTagAccess);
+    CPPUNIT_TEST(testBulkCreation);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
+    CPPUNIT_TEST(testCopyDataArray);
+    CPPUNIT_TEST(testVirtualDataArray);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
@@ -28,6 +28,11 @@ class TestDataArrayHDF5 : public BaseTestDataArray {
     CPPUNIT_TEST(testAliasRangeDimension);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testReferencingEntities);
+    CPPUNIT_TEST(testDataInRange);
+    CPPUNIT_TEST(testEnvelope);
+    CPPUNIT_TEST(testCompressedRead);
+    CPPUNIT_TEST(testCompressedWrite);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -304,6 +304,104 @@ void TestDataSet::testOpaqueIO() {
     CPPUNIT_ASSERT(memcmp(bytes, bytes_read, sizeof(bytes)) == 0);
 }
 
+void TestDataSet::testReadChunksParallel() {
+    const NDSize size = {100, 30};
+    std::vector<int32_t> values(size.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i % 17);
+    }
+
+    // 10 x 10 chunks, the rows from 60 on are not written
+    hdf5::H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    NDSize chunk = {10, 3};
+    H5Pset_chunk(dcpl.h5id(), 2, chunk.data());
+    H5Pset_deflate(dcpl.h5id(), 6);
+    const hdf5::h5x::DataType type(H5T_NATIVE_INT32);
+    hdf5::DataSet ds = h5group.createData("Deflated", type, hdf5::DataSpace::create(size, false), dcpl);
+    ds.write(values.data(), type, NDSize({60, 30}), NDSize({0, 0}));
+
+    std::vector<int32_t> all(values.size(), -1);
+    CPPUNIT_ASSERT(hdf5::readChunksParallel(ds, all.data(), type, size, NDSize({0, 0}), 4));
+    for (size_t i = 0; i < values.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(i < 60 * 30 ? values[i] : 0, all[i]);
+    }
+
+    // a region that starts and ends inside of chunks
+    std::vector<int32_t> part(45 * 7, -1);
+    CPPUNIT_ASSERT(hdf5::readChunksParallel(ds, part.data(), type, NDSize({45, 7}), NDSize({12, 5}), 3));
+    for (size_t r = 0; r < 45; r++) {
+        for (size_t c = 0; c < 7; c++) {
+            CPPUNIT_ASSERT_EQUAL(all[(12 + r) * 30 + 5 + c], part[r * 7 + c]);
+        }
+    }
+
+    // regions beyond the extent are not filled in
+    CPPUNIT_ASSERT_THROW(hdf5::readChunksParallel(ds, all.data(), type, size, NDSize({10, 0}), 4), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(hdf5::readChunksParallel(ds, part.data(), type, NDSize({45, 7}), NDSize({12, 25}), 4),
+                         OutOfBounds);
+
+    // left to H5Dread: one thread, one chunk, a type conversion or no deflate
+    CPPUNIT_ASSERT(!hdf5::readChunksParallel(ds, all.data(), type, size, NDSize({0, 0}), 1));
+    CPPUNIT_ASSERT(!hdf5::readChunksParallel(ds, part.data(), type, NDSize({2, 2}), NDSize({1, 1}), 4));
+    std::vector<double> converted(values.size());
+    CPPUNIT_ASSERT(!hdf5::readChunksParallel(ds, converted.data(), hdf5::h5x::DataType(H5T_NATIVE_DOUBLE),
+                                             size, NDSize({0, 0}), 4));
+    hdf5::DataSet plain = h5group.createData("Plain", type, size);
+    CPPUNIT_ASSERT(!hdf5::readChunksParallel(plain, all.data(), type, size, NDSize({0, 0}), 4));
+}
+
+void TestDataSet::testWriteChunksParallel() {
+    // the last chunk row only holds 5 rows of the data
+    const NDSize size = {95, 30};
+    std::vector<int32_t> values(size.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>((i * 7) % 23);
+    }
+
+    hdf5::H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    NDSize chunk = {10, 3};
+    H5Pset_chunk(dcpl.h5id(), 2, chunk.data());
+    H5Pset_deflate(dcpl.h5id(), 6);
+    const hdf5::h5x::DataType type(H5T_NATIVE_INT32);
+    hdf5::DataSet ds = h5group.createData("DeflatedWrite", type, hdf5::DataSpace::create(size, true), dcpl);
+    CPPUNIT_ASSERT(hdf5::writeChunksParallel(ds, values.data(), type, size, NDSize({0, 0}), 4));
+
+    // the chunks pass through the deflate filter of H5Dread
+    std::vector<int32_t> all(values.size(), -1);
+    ds.read(all.data(), type, size, NDSize({0, 0}));
+    CPPUNIT_ASSERT(values == all);
+
+    hsize_t origin[2] = {0, 0};
+    unsigned filter_mask = 1;
+    haddr_t address;
+    hsize_t stored = 0;
+    H5Dget_chunk_info_by_coord(ds.h5id(), origin, &filter_mask, &address, &stored);
+    CPPUNIT_ASSERT_EQUAL(0u, filter_mask);
+    CPPUNIT_ASSERT(stored < 10 * 3 * sizeof(int32_t));
+
+    // the part of the last chunks beyond the extent holds the fill value
+    ds.setExtent(NDSize({100, 30}));
+    std::vector<int32_t> grown(100 * 30, -1);
+    ds.read(grown.data(), type, NDSize({100, 30}), NDSize({0, 0}));
+    CPPUNIT_ASSERT_EQUAL(values[94 * 30 + 29], grown[94 * 30 + 29]);
+    CPPUNIT_ASSERT_EQUAL(0, grown[95 * 30]);
+
+    // whole chunks inside of the data
+    std::vector<int32_t> block(20 * 6, 5);
+    CPPUNIT_ASSERT(hdf5::writeChunksParallel(ds, block.data(), type, NDSize({20, 6}), NDSize({10, 3}), 2));
+    ds.read(grown.data(), type, NDSize({100, 30}), NDSize({0, 0}));
+    CPPUNIT_ASSERT_EQUAL(5, grown[10 * 30 + 3]);
+    CPPUNIT_ASSERT_EQUAL(5, grown[29 * 30 + 8]);
+    CPPUNIT_ASSERT_EQUAL(values[29 * 30 + 9], grown[29 * 30 + 9]);
+
+    // left to H5Dwrite: one thread, one chunk, unaligned or partial regions
+    CPPUNIT_ASSERT(!hdf5::writeChunksParallel(ds, block.data(), type, NDSize({20, 6}), NDSize({10, 3}), 1));
+    CPPUNIT_ASSERT(!hdf5::writeChunksParallel(ds, block.data(), type, NDSize({10, 3}), NDSize({10, 3}), 4));
+    CPPUNIT_ASSERT(!hdf5::writeChunksParallel(ds, block.data(), type, NDSize({20, 6}), NDSize({5, 3}), 4));
+    CPPUNIT_ASSERT(!hdf5::writeChunksParallel(ds, block.data(), type, NDSize({20, 5}), NDSize({10, 3}), 4));
+    CPPUNIT_ASSERT(!hdf5::writeChunksParallel(ds, block.data(), type, NDSize({20, 6}), NDSize({90, 0}), 4));
+}
+
 void TestDataSet::tearDown() {
     h5group.close();
     H5Fclose(h5file);
@@ -10,6 +10,7 @@
 #include <nix.hpp>
 
 #include "hdf5/h5x/H5Group.hpp"
+#include "hdf5/h5x/ChunkPipeline.hpp"
 
 #include <iostream>
 #include <sstream>
@@ -40,6 +41,8 @@ public:
     void testNDArrayIO();
     void testValArrayIO();
     void testOpaqueIO();
+    void testReadChunksParallel();
+    void testWriteChunksParallel();
     void tearDown();
 
 private:
@@ -58,6 +61,8 @@ private:
     CPPUNIT_TEST(testNDArrayIO);
     CPPUNIT_TEST(testValArrayIO);
     CPPUNIT_TEST(testOpaqueIO);
+    CPPUNIT_TEST(testReadChunksParallel);
+    CPPUNIT_TEST(testWriteChunksParallel);
     CPPUNIT_TEST_SUITE_END ();
 };
 
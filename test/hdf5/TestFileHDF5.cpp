@@ -15,6 +15,9 @@
 #include "hdf5/FileHDF5.hpp"
 
 #include <sstream>
+#include <cmath>
+#include <thread>
+#include <atomic>
 #include <nix/util/util.hpp>
 
 namespace h5x = nix::hdf5;
@@ -49,6 +52,25 @@ static std::string make_file_with_version(int x, int y, int z) {
 void TestFileHDF5::testVersion() {
 
     nix::FormatVersion ver = HDF5_FF_VERSION;
+    nix::FormatVersion newest = HDF5_FF_COMPACT_VERSION;
+
+    // files of the current version can be written ...
+    std::string cur = make_file_with_version(ver.x(), ver.y(), ver.z());
+    nix::File cf = nix::File::open(cur.c_str(), nix::FileMode::ReadWrite);
+    CPPUNIT_ASSERT(cf.isOpen());
+    nix::Section section = cf.createSection("versioned", "test");
+    section.createProperty("full", nix::Value(1.0));
+    CPPUNIT_ASSERT(cf.version() == std::vector<int>({ver.x(), ver.y(), ver.z()}));
+
+    // ... and keep their version until a property is stored compactly
+    cf.compactProperties(true);
+    section.createProperty("compact", nix::Value(2.0));
+    CPPUNIT_ASSERT(cf.version() == std::vector<int>({newest.x(), newest.y(), newest.z()}));
+    cf.close();
+    cf = nix::File::open(cur.c_str(), nix::FileMode::ReadWrite);
+    CPPUNIT_ASSERT(cf.isOpen());
+    CPPUNIT_ASSERT_EQUAL(2.0, cf.getSection("versioned").getProperty("compact").values()[0].get<double>());
+    cf.close();
 
     // simulate OLDER files
     // non-breaking change
@@ -68,11 +90,19 @@ void TestFileHDF5::testVersion() {
         f.close();
 
         ASSERT_NOOPEN(nbc.c_str(), nix::FileMode::ReadWrite);
+
+        // the error names the version
+        try {
+            nix::File::open(nbc.c_str(), nix::FileMode::ReadWrite);
+            CPPUNIT_FAIL("opened a file of an older version for writing");
+        } catch (const nix::InvalidFile &e) {
+            CPPUNIT_ASSERT(std::string(e.what()).find("format version") != std::string::npos);
+        }
     }
 
     // simulate NEWER files
     // z change, can still read
-    std::string nbc = make_file_with_version(ver.x(), ver.y(), ver.z() + 1);
+    std::string nbc = make_file_with_version(newest.x(), newest.y(), newest.z() + 1);
     nix::File f = nix::File::open(nbc.c_str(), nix::FileMode::ReadOnly);
     CPPUNIT_ASSERT(f.isOpen());
     f.close();
@@ -80,12 +110,315 @@ void TestFileHDF5::testVersion() {
     ASSERT_NOOPEN(nbc.c_str(), nix::FileMode::ReadWrite);
 
     // newer y (major breaking change), neither read nor write
-    std::string mbc = make_file_with_version(ver.x(), ver.y() + 1, ver.z());
+    std::string mbc = make_file_with_version(newest.x(), newest.y() + 1, newest.z());
     ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadWrite);
     ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadOnly);
 
     // newer x (huge breaking change), all hope is lost
-    std::string hbc = make_file_with_version(ver.x() + 1, ver.y(), ver.z());
-    ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadWrite);
-    ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadOnly);
+    std::string hbc = make_file_with_version(newest.x() + 1, newest.y(), newest.z());
+    ASSERT_NOOPEN(hbc.c_str(), nix::FileMode::ReadWrite);
+    ASSERT_NOOPEN(hbc.c_str(), nix::FileMode::ReadOnly);
+}
+
+
+void TestFileHDF5::testDeferredTimestamps() {
+    CPPUNIT_ASSERT(!file_open.deferTimestamps());
+    file_open.deferTimestamps(true);
+    CPPUNIT_ASSERT(file_open.deferTimestamps());
+
+    nix::Block b = file_open.createBlock("deferred", "test");
+    nix::Tag t = b.createTag("tag", "test", {1.0, 2.0});
+    t.units({"ms", "mV"});
+
+    // the time stamp is only kept in memory ...
+    auto h5file = std::dynamic_pointer_cast<nix::hdf5::FileHDF5>(file_open.impl());
+    h5x::H5Group tag_group = H5Gopen(h5file->h5id(), "/data/deferred/tags/tag", H5P_DEFAULT);
+    tag_group.check("Could not open tag group");
+    CPPUNIT_ASSERT(!tag_group.hasAttr("updated_at"));
+    CPPUNIT_ASSERT(t.updatedAt() >= startup_time);
+    CPPUNIT_ASSERT(b.updatedAt() >= startup_time);
+
+    // ... until the file is flushed
+    file_open.flush();
+    CPPUNIT_ASSERT(tag_group.hasAttr("updated_at"));
+    std::string str;
+    tag_group.getAttr("updated_at", str);
+    CPPUNIT_ASSERT_EQUAL(t.updatedAt(), nix::util::strToTime(str));
+
+    // deleted entities leave no time stamps behind, sections they link to keep theirs
+    nix::Section s = file_open.createSection("deferred", "test");
+    t.metadata(s);
+    h5x::H5Group section_group = H5Gopen(h5file->h5id(), "/metadata/deferred", H5P_DEFAULT);
+    section_group.check("Could not open section group");
+    CPPUNIT_ASSERT(h5file->pendingUpdatedAt(section_group));
+    nix::Tag gone = b.createTag("gone", "test", {3.0});
+    gone.metadata(s);
+    CPPUNIT_ASSERT(b.deleteTag(gone));
+    CPPUNIT_ASSERT(h5file->pendingUpdatedAt(section_group));
+    for (int i = 0; i < 10; i++) {
+        b.createTag("reused" + nix::util::numToStr(i), "test", {1.0});
+    }
+    file_open.flush();
+    CPPUNIT_ASSERT(section_group.hasAttr("updated_at"));
+    section_group.close();
+
+    // attributes cached while a time stamp is pending are refreshed by the flush
+    h5x::H5Group block_group = H5Gopen(h5file->h5id(), "/data/deferred", H5P_DEFAULT);
+    block_group.check("Could not open block group");
+    block_group.setAttr("updated_at", nix::util::timeToStr(startup_time - 3600));
+    nix::Block stale = file_open.getBlock("deferred");
+    stale.definition("stale");
+    CPPUNIT_ASSERT_EQUAL(std::string("deferred"), stale.name());
+    file_open.flush();
+    CPPUNIT_ASSERT(stale.updatedAt() >= startup_time);
+    block_group.close();
+
+    t.definition("deferred");
+    file_open.deferTimestamps(false);
+    CPPUNIT_ASSERT(!file_open.deferTimestamps());
+    CPPUNIT_ASSERT(t.updatedAt() >= startup_time);
+    tag_group.close();
+}
+
+
+void TestFileHDF5::testAttributeCache() {
+    nix::Block b = file_open.createBlock("cached", "test");
+    nix::Block other = file_open.getBlock("cached");
+    CPPUNIT_ASSERT(!other.definition());
+
+    // a write through one entity object refreshes the others of the group
+    b.definition("first");
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), *other.definition());
+
+    // writes to other entities leave the generation of the block alone
+    auto h5file = std::dynamic_pointer_cast<nix::hdf5::FileHDF5>(file_open.impl());
+    h5x::H5Group block_group = H5Gopen(h5file->h5id(), "/data/cached", H5P_DEFAULT);
+    block_group.check("Could not open block group");
+    uint64_t generation = h5file->attributeGeneration(block_group.address());
+    nix::Tag t = b.createTag("tag", "test", {1.0});
+    t.definition("second");
+    CPPUNIT_ASSERT_EQUAL(generation, h5file->attributeGeneration(block_group.address()));
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), *other.definition());
+
+    // deleted entities leave no generation behind
+    h5x::H5Group tag_group = H5Gopen(h5file->h5id(), "/data/cached/tags/tag", H5P_DEFAULT);
+    tag_group.check("Could not open tag group");
+    haddr_t tag_address = tag_group.address();
+    tag_group.close();
+    CPPUNIT_ASSERT(h5file->attributeGeneration(tag_address) > 0);
+    b.deleteTag(t);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), h5file->attributeGeneration(tag_address));
+    block_group.close();
+}
+
+
+void TestFileHDF5::testConcurrentRead() {
+    const size_t n_arrays = 8;
+    const size_t n_threads = 4;
+    {
+        nix::File fd = nix::File::open("test_file_concurrent.h5", nix::FileMode::Overwrite);
+        nix::Block b = fd.createBlock("block", "test");
+        for (size_t i = 0; i < n_arrays; i++) {
+            std::vector<double> data(1000, static_cast<double>(i));
+            b.createDataArray("array_" + std::to_string(i), "test", data);
+        }
+        fd.close();
+    }
+
+    nix::File fd = nix::File::open("test_file_concurrent.h5", nix::FileMode::ReadOnly);
+    nix::Block block = fd.getBlock("block");
+    std::atomic<size_t> errors(0);
+    std::vector<std::thread> threads;
+
+    // all threads share the file and block and read every array repeatedly
+    for (size_t t = 0; t < n_threads; t++) {
+        threads.emplace_back([&block, &errors, n_arrays] {
+            for (size_t round = 0; round < 10; round++) {
+                for (size_t i = 0; i < n_arrays; i++) {
+                    std::string name = "array_" + std::to_string(i);
+                    nix::DataArray da = block.getDataArray(name);
+                    std::vector<double> data;
+                    da.getData(data);
+                    if (da.name() != name || data.size() != 1000 ||
+                        data.front() != static_cast<double>(i) || data.back() != static_cast<double>(i)) {
+                        errors++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), errors.load());
+    fd.close();
+}
+
+
+void TestFileHDF5::testIOStatistics() {
+    nix::Block b = file_open.createBlock("stats", "test");
+    std::vector<double> data(100, 1.0);
+    nix::DataArray da = b.createDataArray("array", "test", data);
+
+    // nothing is collected by default
+    CPPUNIT_ASSERT(!file_open.collectIOStatistics());
+    da.getData(data);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), file_open.ioStatistics().data_read.count);
+
+    file_open.collectIOStatistics(true);
+    CPPUNIT_ASSERT(file_open.collectIOStatistics());
+    da.getData(data);
+    nix::IOStatistics stats = file_open.ioStatistics();
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats.data_read.count);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(data.size() * sizeof(double)), stats.bytes_read);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), stats.data_write.count);
+
+    da.setData(data);
+    b.getDataArray("array");
+    stats = file_open.ioStatistics();
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats.data_write.count);
+    CPPUNIT_ASSERT(stats.bytes_written >= data.size() * sizeof(double));
+    CPPUNIT_ASSERT(stats.has_object.count > 0);
+    CPPUNIT_ASSERT(stats.attr_read.count + stats.attr_write.count > 0);
+
+    // calls on other files are not counted
+    nix::Block other = file_other.createBlock("other", "test");
+    other.createDataArray("array", "test", data).getData(data);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), file_open.ioStatistics().data_read.count);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), file_other.ioStatistics().data_read.count);
+
+    file_open.resetIOStatistics();
+    stats = file_open.ioStatistics();
+    for (const auto &calls : stats.calls()) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), calls.second.count);
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), stats.bytes_read);
+
+    // disabling keeps what was collected
+    da.getData(data);
+    file_open.collectIOStatistics(false);
+    da.getData(data);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), file_open.ioStatistics().data_read.count);
+
+    // reads and writes of compressed chunks by several threads are counted as well
+    std::vector<double> values(1 << 20, 2.0);
+    nix::DataArray packed = b.createDataArray("packed", "test", nix::DataType::Double,
+                                              nix::NDSize({values.size()}), nix::Compression::DeflateNormal);
+    packed.setData(values);
+    file_open.filterThreads(2);
+    file_open.collectIOStatistics(true);
+    file_open.resetIOStatistics();
+    packed.getData(nix::DataType::Double, values.data(), nix::NDSize({values.size()}), nix::NDSize({0}));
+    stats = file_open.ioStatistics();
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats.data_read.count);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(values.size() * sizeof(double)), stats.bytes_read);
+    packed.setData(nix::DataType::Double, values.data(), nix::NDSize({values.size()}), nix::NDSize({0}));
+    stats = file_open.ioStatistics();
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats.data_write.count);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(values.size() * sizeof(double)), stats.bytes_written);
+    file_open.collectIOStatistics(false);
+    file_open.filterThreads(1);
+}
+
+
+void TestFileHDF5::testCopyBlock() {
+    nix::Section recording = file_open.createSection("recording", "nix.recording");
+    nix::Section electrode = recording.createSection("electrode", "nix.electrode");
+    electrode.createProperty("impedance", nix::Value(1.5));
+
+    nix::Block block = file_open.createBlock("session", "nix.session");
+    block.metadata(recording);
+    nix::Source subject = block.createSource("subject", "nix.subject");
+    nix::Source cell = subject.createSource("cell", "nix.cell");
+
+    std::vector<double> values(10000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = std::sin(i * 0.01);
+    }
+    nix::DataArray trace = block.createDataArray("trace", "nix.trace", nix::DataType::Double,
+                                                 nix::NDSize({values.size()}), nix::Compression::DeflateNormal);
+    trace.setData(nix::DataType::Double, values.data(), nix::NDSize({values.size()}), nix::NDSize({0}));
+    trace.appendSampledDimension(0.1);
+    trace.addSource(cell);
+    trace.metadata(electrode);
+    nix::Tag tag = block.createTag("spike", "nix.event", {1.0});
+    tag.addReference(trace);
+    tag.createFeature(trace, nix::LinkType::Tagged);
+    nix::Group group = block.createGroup("all", "nix.group");
+    group.addDataArray(trace);
+
+    // the copy keeps its ids and brings the referenced sections along
+    nix::Block copy = file_other.copyBlock(block);
+    CPPUNIT_ASSERT_EQUAL(block.id(), copy.id());
+    CPPUNIT_ASSERT_EQUAL(block.name(), copy.name());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), file_other.sectionCount());
+    CPPUNIT_ASSERT_EQUAL(recording.id(), copy.metadata().id());
+
+    nix::DataArray copied = copy.getDataArray("trace");
+    CPPUNIT_ASSERT_EQUAL(trace.id(), copied.id());
+    CPPUNIT_ASSERT(trace.dataChunking() == copied.dataChunking());
+    std::vector<double> read(values.size());
+    copied.getData(nix::DataType::Double, read.data(), nix::NDSize({values.size()}), nix::NDSize({0}));
+    CPPUNIT_ASSERT(values == read);
+    CPPUNIT_ASSERT_EQUAL(electrode.id(), copied.metadata().id());
+    CPPUNIT_ASSERT_EQUAL(recording.id(), copied.metadata().parent().id());
+    CPPUNIT_ASSERT_EQUAL(cell.id(), copied.sources()[0].id());
+    CPPUNIT_ASSERT_EQUAL(copied.id(), copy.getTag("spike").references()[0].id());
+    CPPUNIT_ASSERT_EQUAL(copied.id(), copy.getGroup("all").dataArrays()[0].id());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), copied.referencingTags().size());
+
+    // a second copy gets new ids, and its links follow them
+    nix::Block renewed = file_other.copyBlock(block, "session_two", nix::CopyIds::Regenerate);
+    CPPUNIT_ASSERT_EQUAL(std::string("session_two"), renewed.name());
+    CPPUNIT_ASSERT(renewed.id() != block.id());
+    nix::DataArray renewed_trace = renewed.getDataArray("trace");
+    CPPUNIT_ASSERT(renewed_trace.id() != trace.id());
+    CPPUNIT_ASSERT(renewed.getSource("subject").getSource("cell").id() != cell.id());
+    CPPUNIT_ASSERT_EQUAL(renewed.getSource("subject").getSource("cell").id(), renewed_trace.sources()[0].id());
+    nix::Tag renewed_tag = renewed.getTag("spike");
+    CPPUNIT_ASSERT_EQUAL(renewed_trace.id(), renewed_tag.references()[0].id());
+    CPPUNIT_ASSERT(renewed_tag.hasReference(renewed_trace.id()));
+    CPPUNIT_ASSERT_EQUAL(renewed_trace.id(), renewed_tag.features()[0].data().id());
+    CPPUNIT_ASSERT(renewed_tag.features()[0].id() != tag.features()[0].id());
+    CPPUNIT_ASSERT(renewed.getGroup("all").hasDataArray(renewed_trace.id()));
+
+    // the sections were already there: no copies of them
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), file_other.sectionCount());
+    CPPUNIT_ASSERT_EQUAL(electrode.id(), renewed_trace.metadata().id());
+
+    CPPUNIT_ASSERT_THROW(file_other.copyBlock(block), nix::DuplicateName);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), file_other.blockCount());
+
+    // a block of the same file gets new ids and links to the original sections
+    nix::Block twin = file_open.copyBlock(block, "twin");
+    CPPUNIT_ASSERT(twin.id() != block.id());
+    CPPUNIT_ASSERT(twin.getDataArray("trace").id() != trace.id());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), file_open.sectionCount());
+    CPPUNIT_ASSERT_EQUAL(recording.id(), twin.metadata().id());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), file_open.sections()[0].sectionCount());
+
+    // sections and sources copied along into another file keep their ids, so later copies link to them
+    nix::Section shared = file_open.createSection("shared", "nix.recording");
+    nix::Source origin = block.createSource("origin", "nix.subject");
+    nix::DataArray first = block.createDataArray("first", "nix.trace", nix::DataType::Double, nix::NDSize({4}));
+    nix::DataArray second = block.createDataArray("second", "nix.trace", nix::DataType::Double, nix::NDSize({4}));
+    for (nix::DataArray array : {first, second}) {
+        array.metadata(shared);
+        array.addSource(origin);
+    }
+    nix::Block target = file_other.createBlock("target", "nix.session");
+    nix::DataArray first_copy = target.copyDataArray(first, "", nix::CopyIds::Regenerate);
+    nix::DataArray second_copy = target.copyDataArray(second, "", nix::CopyIds::Regenerate);
+    nix::DataArray kept = target.copyDataArray(first, "kept");
+    CPPUNIT_ASSERT(first_copy.id() != first.id());
+    CPPUNIT_ASSERT(second_copy.id() != second.id());
+    CPPUNIT_ASSERT_EQUAL(first.id(), kept.id());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), file_other.sectionCount());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), target.sourceCount());
+    for (const nix::DataArray &array : {first_copy, second_copy, kept}) {
+        CPPUNIT_ASSERT_EQUAL(shared.id(), array.metadata().id());
+        CPPUNIT_ASSERT_EQUAL(origin.id(), array.sources()[0].id());
+    }
 }
@@ -22,12 +22,23 @@ class TestFileHDF5: public BaseTestFile {
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
+    CPPUNIT_TEST(testDeferredTimestamps);
+    CPPUNIT_TEST(testAttributeCache);
+    CPPUNIT_TEST(testConcurrentRead);
+    CPPUNIT_TEST(testIOStatistics);
+    CPPUNIT_TEST(testCopyBlock);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
 
     void testVersion() override;
 
+    void testDeferredTimestamps();
+    void testAttributeCache();
+    void testConcurrentRead();
+    void testIOStatistics();
+    void testCopyBlock();
+
     void setUp() override {
         startup_time = time(NULL);
         file_open = nix::File::open("test_file.h5", nix::FileMode::Overwrite);
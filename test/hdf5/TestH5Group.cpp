@@ -231,3 +231,66 @@ void TestH5Group::testIterOrder() {
         CPPUNIT_ASSERT_EQUAL(name, std::to_string(idx));
     }
 }
+
+void TestH5Group::testStringAttrs() {
+    nix::hdf5::H5Group root(h5group, true);
+    nix::hdf5::H5Group g = root.openGroup("stringattrs", true);
+
+    g.setAttr("name", std::string("foo"));
+    g.setAttr("type", std::string("bar"));
+    g.setAttr("count", 42);
+    g.setAttr("list", std::vector<std::string>{"a", "b"});
+
+    std::vector<boost::optional<std::string>> values;
+    g.getStringAttrs({"type", "missing", "count", "name", "list"}, values);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), values.size());
+    CPPUNIT_ASSERT(values[0] && *values[0] == "bar");
+    CPPUNIT_ASSERT(!values[1]);
+    CPPUNIT_ASSERT(!values[2]);
+    CPPUNIT_ASSERT(values[3] && *values[3] == "foo");
+    CPPUNIT_ASSERT(!values[4]);
+}
+
+static H5D_layout_t layoutOf(const nix::hdf5::DataSet &ds) {
+    hid_t dcpl = H5Dget_create_plist(ds.h5id());
+    H5D_layout_t layout = H5Pget_layout(dcpl);
+    H5Pclose(dcpl);
+    return layout;
+}
+
+void TestH5Group::testCompactData() {
+    nix::hdf5::H5Group root(h5group, true);
+    nix::hdf5::H5Group g = root.openGroup("compact", true);
+
+    // tiny data sets live in their object header
+    std::vector<double> position = {1.5, 2.5};
+    g.setData("position", position);
+    CPPUNIT_ASSERT_EQUAL(H5D_COMPACT, layoutOf(g.openData("position")));
+    std::vector<std::string> labels = {"a", "bb", "ccc"};
+    g.setData("labels", labels);
+    CPPUNIT_ASSERT_EQUAL(H5D_COMPACT, layoutOf(g.openData("labels")));
+
+    // another shape replaces them, still compact while small
+    position.push_back(3.5);
+    g.setData("position", position);
+    CPPUNIT_ASSERT_EQUAL(H5D_COMPACT, layoutOf(g.openData("position")));
+    std::vector<double> read;
+    g.getData("position", read);
+    assert_vectors_equal(position, read);
+
+    // and chunked once they outgrow the limit, from then on resized in place
+    std::vector<double> ticks(nix::hdf5::H5Group::compactLimit / sizeof(double) + 1, 0.25);
+    g.setData("position", ticks);
+    CPPUNIT_ASSERT_EQUAL(H5D_CHUNKED, layoutOf(g.openData("position")));
+    g.getData("position", read);
+    assert_vectors_equal(ticks, read);
+    g.setData("position", position);
+    CPPUNIT_ASSERT_EQUAL(H5D_CHUNKED, layoutOf(g.openData("position")));
+    g.getData("position", read);
+    assert_vectors_equal(position, read);
+
+    // empty data sets stay extendible
+    g.setData("empty", std::vector<double>());
+    CPPUNIT_ASSERT_EQUAL(H5D_CHUNKED, layoutOf(g.openData("empty")));
+}
@@ -50,6 +50,10 @@ public:
 
     void testIterOrder();
 
+    void testStringAttrs();
+
+    void testCompactData();
+
     template<typename T>
     static void assert_vectors_equal(std::vector<T> &a, std::vector<T> &b) {
 
@@ -80,5 +84,7 @@ private:
     CPPUNIT_TEST(testMultiArray);
     CPPUNIT_TEST(testArray);
     CPPUNIT_TEST(testIterOrder);
+    CPPUNIT_TEST(testStringAttrs);
+    CPPUNIT_TEST(testCompactData);
     CPPUNIT_TEST_SUITE_END ();
 };
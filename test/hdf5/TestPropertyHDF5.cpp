@@ -0,0 +1,148 @@
+// Copyright (c) 2026, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestPropertyHDF5.hpp"
+
+#include "hdf5/h5x/H5Object.hpp"
+
+namespace h5x = nix::hdf5;
+
+static int member_count(hid_t file, const std::string &name) {
+    std::string path = "/metadata/cool section/properties/" + name;
+    h5x::H5Object ds = H5Dopen2(file, path.c_str(), H5P_DEFAULT);
+    ds.check("Could not open property data set");
+    h5x::H5Object type = H5Dget_type(ds.h5id());
+    if (H5Tget_class(type.h5id()) != H5T_COMPOUND) {
+        return 0;
+    }
+    return H5Tget_nmembers(type.h5id());
+}
+
+
+void TestPropertyHDF5::testValueLayout() {
+    nix::Value uncertain(2.5);
+    uncertain.uncertainty = 0.1;
+    nix::Value referenced(3.5);
+    referenced.reference = "ref";
+
+    // properties keep all fields unless compact properties are enabled
+    nix::Property standard = section.createProperty("standard", nix::Value(1.5));
+    CPPUNIT_ASSERT(!file.compactProperties());
+    file.compactProperties(true);
+    CPPUNIT_ASSERT(file.compactProperties());
+
+    nix::Property plain = section.createProperty("plain", std::vector<nix::Value>{nix::Value(1.5), nix::Value(2.5)});
+    nix::Property with_uncertainty = section.createProperty("uncertain", uncertain);
+    nix::Property full = section.createProperty("full", referenced);
+    nix::Property text = section.createProperty("text", std::vector<nix::Value>{nix::Value("a"), nix::Value("bc")});
+
+    // values that need a richer layout are rejected
+    nix::Property compact = section.createProperty("compact", nix::Value(int32_t(1)));
+    nix::Property other = section.getProperty("compact");
+    nix::Value checked(int32_t(2));
+    checked.checksum = "abc";
+    CPPUNIT_ASSERT_THROW(compact.values({nix::Value(int32_t(1)), checked}), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(compact.appendValues(std::vector<nix::Value>{checked}), std::invalid_argument);
+    compact.values({nix::Value(int32_t(3)), nix::Value(int32_t(4))});
+    CPPUNIT_ASSERT_EQUAL(int32_t(4), other.values()[1].get<int32_t>());
+
+    std::vector<nix::Value> values = plain.values();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), values.size());
+    CPPUNIT_ASSERT_EQUAL(2.5, values[1].get<double>());
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Double, plain.dataType());
+
+    values = with_uncertainty.values();
+    CPPUNIT_ASSERT_EQUAL(0.1, values[0].uncertainty);
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Double, with_uncertainty.dataType());
+
+    values = full.values();
+    CPPUNIT_ASSERT_EQUAL(std::string("ref"), values[0].reference);
+
+    values = text.values();
+    CPPUNIT_ASSERT_EQUAL(std::string("bc"), values[1].get<std::string>());
+
+    values = standard.values();
+    CPPUNIT_ASSERT_EQUAL(1.5, values[0].get<double>());
+
+    file.close();
+
+    h5x::H5Object h5file = H5Fopen("test_property.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    h5file.check("Could not open test file");
+    CPPUNIT_ASSERT_EQUAL(0, member_count(h5file.h5id(), "plain"));
+    CPPUNIT_ASSERT_EQUAL(0, member_count(h5file.h5id(), "text"));
+    CPPUNIT_ASSERT_EQUAL(2, member_count(h5file.h5id(), "uncertain"));
+    CPPUNIT_ASSERT_EQUAL(6, member_count(h5file.h5id(), "full"));
+    CPPUNIT_ASSERT_EQUAL(0, member_count(h5file.h5id(), "compact"));
+    CPPUNIT_ASSERT_EQUAL(6, member_count(h5file.h5id(), "standard"));
+    CPPUNIT_ASSERT_EQUAL(6, member_count(h5file.h5id(), "prop"));
+}
+
+
+void TestPropertyHDF5::testTypedValues() {
+    std::vector<nix::Value> trials;
+    for (int32_t i = 0; i < 10; i++) {
+        trials.emplace_back(i);
+    }
+    nix::Property plain = section.createProperty("trials", trials);
+
+    std::vector<int32_t> ints;
+    plain.values(ints);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), ints.size());
+    CPPUNIT_ASSERT_EQUAL(int32_t(7), ints[7]);
+
+    // converted to the element type of the vector
+    std::vector<double> doubles;
+    plain.values(doubles, 2, 3);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), doubles.size());
+    CPPUNIT_ASSERT_EQUAL(4.0, doubles[2]);
+
+    plain.appendValues(std::vector<int32_t>{10, 11});
+    plain.appendValues({nix::Value(int32_t(12))});
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(13), plain.valueCount());
+
+    std::vector<nix::Value> range = plain.values(9, 4);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), range.size());
+    CPPUNIT_ASSERT_EQUAL(int32_t(9), range[0].get<int32_t>());
+    CPPUNIT_ASSERT_EQUAL(int32_t(12), range[3].get<int32_t>());
+    CPPUNIT_ASSERT_THROW(plain.values(10, 4), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(plain.values(ints, 12, 2), nix::OutOfBounds);
+
+    // appending values with uncertainties keeps the stored values
+    nix::Value uncertain(int32_t(13));
+    uncertain.uncertainty = 0.5;
+    plain.appendValues({uncertain});
+    plain = section.getProperty("trials");
+    plain.values(ints);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(14), ints.size());
+    CPPUNIT_ASSERT_EQUAL(int32_t(3), ints[3]);
+    CPPUNIT_ASSERT_EQUAL(int32_t(13), ints[13]);
+    CPPUNIT_ASSERT_EQUAL(0.5, plain.values(13, 1)[0].uncertainty);
+
+    // typed appends to compound values
+    plain.appendValues(std::vector<int32_t>{14});
+    range = plain.values(12, 3);
+    CPPUNIT_ASSERT_EQUAL(int32_t(14), range[2].get<int32_t>());
+    CPPUNIT_ASSERT_EQUAL(0.0, range[2].uncertainty);
+
+    nix::Value referenced("a");
+    referenced.reference = "ref";
+    nix::Property full = section.createProperty("names", referenced);
+    full.appendValues(std::vector<std::string>{"b", "c"});
+    std::vector<std::string> names;
+    full.values(names);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), names.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("a"), names[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("c"), names[2]);
+    CPPUNIT_ASSERT_EQUAL(std::string("ref"), full.values(0, 1)[0].reference);
+
+    nix::Property text = section.createProperty("text", nix::Value("x"));
+    text.appendValues(std::vector<std::string>{"y"});
+    text.values(names);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), names.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("y"), names[1]);
+}
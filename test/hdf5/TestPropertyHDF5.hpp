@@ -11,6 +11,8 @@
 
 #include "BaseTestProperty.hpp"
 
+#include <cppunit/extensions/HelperMacros.h>
+
 class TestPropertyHDF5 : public BaseTestProperty {
 
     CPPUNIT_TEST_SUITE(TestPropertyHDF5);
@@ -29,9 +31,15 @@ class TestPropertyHDF5 : public BaseTestProperty {
     CPPUNIT_TEST(testUpdatedAt);
     CPPUNIT_TEST(testCreatedAt);
     CPPUNIT_TEST(testIsValidEntity);
+    CPPUNIT_TEST(testValueLayout);
+    CPPUNIT_TEST(testTypedValues);
     CPPUNIT_TEST_SUITE_END();
 
 public:
+
+    void testValueLayout();
+    void testTypedValues();
+
     void setUp() {
         startup_time = time(NULL);
         file = nix::File::open("test_property.h5", nix::FileMode::Overwrite);